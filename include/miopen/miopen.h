@@ -262,6 +262,64 @@ MIOPEN_EXPORT miopenStatus_t miopenGetKernelTime(miopenHandle_t handle, float* t
  * @return           miopenStatus_t
  */
 MIOPEN_EXPORT miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enable);
+
+#ifdef MIOPEN_BETA_API
+/*! @brief Write the pending user database updates to the disk
+ *
+ * When the write-behind of the user databases is enabled by MIOPEN_DB_WRITE_BEHIND, the updates
+ * are written by a background thread. This function blocks until all the updates queued before
+ * the call are written. The remaining updates are also written at the process exit.
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenFlushUserDb(void);
+
+/*! @enum miopenDbKind_t
+ * Databases and caches for which the process collects access statistics
+ */
+typedef enum
+{
+    miopenDbKindFindDb       = 0, /*!< Find-Db */
+    miopenDbKindPerfDb       = 1, /*!< Performance database */
+    miopenDbKindKernelDb     = 2, /*!< Kernel database and user kernel cache */
+    miopenDbKindAnyRamDb     = 3, /*!< TunaNet cache */
+    miopenDbKindInvokerCache = 4, /*!< Invoker caches of the handles */
+    miopenDbKindKernelCache  = 5, /*!< Kernel caches of the handles */
+} miopenDbKind_t;
+
+/*! @brief Access statistics of a database or a cache
+ *
+ * The counters are accumulated by all the handles of the process since its start or since the
+ * last call of miopenResetDbStats. The lookups, hits, misses and stores are not counted for the
+ * invoker and the kernel caches.
+ */
+typedef struct
+{
+    uint64_t lookups;      /*!< Number of lookups */
+    uint64_t hits;         /*!< Number of lookups which have found a record */
+    uint64_t misses;       /*!< Number of lookups which have found nothing */
+    uint64_t stores;       /*!< Number of records stored successfully */
+    uint64_t bytesRead;    /*!< Total size of the records returned by the lookups */
+    uint64_t lookupTimeUs; /*!< Total time of the lookups in microseconds */
+    uint64_t evictions;    /*!< Number of entries evicted from the in-memory cache */
+    int64_t residentBytes; /*!< Approximate size of the data held in memory. Not reset */
+} miopenDbStats_t;
+
+/*! @brief Get the access statistics of a database or a cache
+ *
+ * The same statistics are written to the file set by MIOPEN_DB_STATS_JSON at the process exit.
+ * @param kind       Database or cache to query (input)
+ * @param stats      Pointer to the statistics (output)
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenGetDbStats(miopenDbKind_t kind, miopenDbStats_t* stats);
+
+/*! @brief Reset the access statistics of all the databases and caches
+ *
+ * The resident sizes describe the current state of the caches and are kept.
+ * @return           miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenResetDbStats(void);
+#endif
 /** @} */
 // CLOSEOUT HANDLE DOXYGEN GROUP
 
@@ -5596,6 +5654,44 @@ MIOPEN_EXPORT miopenStatus_t miopenFuseProblems(miopenProblem_t problem1, miopen
 MIOPEN_EXPORT miopenStatus_t miopenCreateBiasProblem(miopenProblem_t* problem,
                                                      miopenProblemDirection_t direction);
 
+/*! @brief Prepares the handle for the first solution of the problems.
+ *
+ * Selects the solutions of each convolution problem as the first call of miopenFindSolutions or
+ * of the immediate mode would select them, from the find-db or by the immediate mode fallback,
+ * loads or builds their kernels and prepares their invokers, so that the first call costs as
+ * much as the following ones. Nothing is run on the device. Independent problems are processed
+ * in parallel. Problems of other kinds are skipped.
+ *
+ * @param handle       Handle to prepare
+ * @param problems     Array of the problems
+ * @param numProblems  Number of the problems
+ * @param numWarmedUp  Pointer to a location where to write the number of the problems prepared.
+ * Ignored if null
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenWarmUpProblems(miopenHandle_t handle,
+                                                  const miopenProblem_t* problems,
+                                                  size_t numProblems,
+                                                  size_t* numWarmedUp);
+
+/*! @brief Prepares the handle for the convolutions listed in a file of MIOpenDriver commands.
+ *
+ * Same as miopenWarmUpProblems for the convolution problems of the commands in the file, one
+ * command per line, e.g. those logged with MIOPEN_ENABLE_LOGGING_CMD=1. Other lines are skipped.
+ *
+ * @param handle       Handle to prepare
+ * @param path         Path to the file
+ * @param numProblems  Pointer to a location where to write the number of the problems read.
+ * Ignored if null
+ * @param numWarmedUp  Pointer to a location where to write the number of the problems prepared.
+ * Ignored if null
+ * @return             miopenStatus_t
+ */
+MIOPEN_EXPORT miopenStatus_t miopenWarmUpFromDriverCommands(miopenHandle_t handle,
+                                                            const char* path,
+                                                            size_t* numProblems,
+                                                            size_t* numWarmedUp);
+
 #endif
 
 /** @} */
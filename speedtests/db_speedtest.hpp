@@ -0,0 +1,85 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_SPEEDTESTS_DB_SPEEDTEST_HPP
+#define GUARD_MIOPEN_SPEEDTESTS_DB_SPEEDTEST_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <fstream>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include <unistd.h>
+
+namespace miopen {
+namespace speedtests {
+
+inline std::string MakeKey(std::size_t i)
+{
+    // Resembles the keys of a real perf-db: 3-32-32-3x3-64-32-32-<i>-1x1-1x1-1x1-0-NCHW-FP32-F
+    return "3-32-32-3x3-64-32-32-" + std::to_string(i) + "-1x1-1x1-1x1-0-NCHW-FP32-F";
+}
+
+/// Random perf-db record contents with the values of 1 to 3 solvers.
+inline std::string MakeContents(std::mt19937& rng, std::size_t solvers = 2)
+{
+    auto dist = std::uniform_int_distribution<int>{1, 256};
+    auto ss   = std::ostringstream{};
+    ss << "ConvOclDirectFwd:" << dist(rng) << ',' << dist(rng) << ',' << dist(rng) << ','
+       << dist(rng);
+    if(solvers > 1)
+        ss << ";ConvAsm1x1U:" << dist(rng) << ',' << dist(rng) << ',' << dist(rng);
+    if(solvers > 2)
+        ss << ";ConvHipImplicitGemmV4R1Fwd:" << dist(rng) << ',' << dist(rng) << ','
+           << dist(rng) << ',' << dist(rng);
+    return ss.str();
+}
+
+/// Average time of func(i) for i in [0, count), us.
+template <class TFunc>
+double MeasureUs(int count, TFunc&& func)
+{
+    const auto start = std::chrono::steady_clock::now();
+    for(auto i = 0; i < count; ++i)
+        func(i);
+    const auto time = std::chrono::steady_clock::now() - start;
+    return std::chrono::duration<double, std::micro>(time).count() / count;
+}
+
+/// Resident memory of the process, KiB.
+inline std::size_t GetResidentKiB()
+{
+    auto statm = std::ifstream{"/proc/self/statm"};
+    auto size = std::size_t{0}, resident = std::size_t{0};
+    statm >> size >> resident;
+    return resident * sysconf(_SC_PAGESIZE) / 1024;
+}
+
+} // namespace speedtests
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_SPEEDTESTS_DB_SPEEDTEST_HPP
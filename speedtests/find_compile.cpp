@@ -0,0 +1,191 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+
+#include <miopen/compile_scheduler.hpp>
+#include <miopen/par_for.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace find_compile {
+
+using solver::CompileScheduler;
+using solver::KernelInfo;
+
+/// Emulates the compilation and the benchmarking of the solutions of a Find with a mock compiler
+/// which sleeps, so it runs without a GPU. Compares the former strided precompilation of all of
+/// the kernels before the benchmarks with CompileScheduler.
+struct FindCompileSpeedTest : test_driver
+{
+    FindCompileSpeedTest()
+    {
+        add(solutions, "solutions");
+        add(threads, "threads");
+        add(benchmark_ms, "benchmark-ms");
+    }
+
+    void run() const
+    {
+        std::cout << std::setw(10) << "find" << std::setw(14) << "strided, ms" << std::setw(16)
+                  << "scheduler, ms" << std::setw(12) << "speedup" << std::endl;
+
+        // The second Find has the compile times of the first one for the estimates.
+        for(const auto find : {"first", "second"})
+        {
+            const auto problem   = std::string{find};
+            const auto strided   = Measure([&]() { FindStrided(MakeSolutions(problem)); });
+            const auto scheduled = Measure([&]() { FindScheduled(MakeSolutions(problem)); });
+            std::cout << std::setw(10) << find << std::setw(14) << std::fixed
+                      << std::setprecision(0) << strided << std::setw(16) << scheduled
+                      << std::setw(12) << std::setprecision(2) << strided / scheduled << std::endl;
+        }
+    }
+
+private:
+    int solutions    = 48;
+    int threads      = 8;
+    int benchmark_ms = 2;
+
+    using Solution = std::vector<KernelInfo>;
+
+    /// The kernel cache of the mock compiler.
+    struct Cache
+    {
+        std::mutex mutex;
+        std::set<std::string> programs;
+
+        bool Has(const KernelInfo& kernel)
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            return programs.count(kernel.kernel_file + kernel.comp_options) != 0;
+        }
+
+        void Add(const KernelInfo& kernel)
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            programs.insert(kernel.kernel_file + kernel.comp_options);
+        }
+    };
+
+    /// Most kernels build in tens of milliseconds, a few big assembly ones take much longer.
+    static int GetCompileMs(int file) { return file % 16 == 15 ? 600 : 20 + 10 * (file % 5); }
+
+    std::vector<Solution> MakeSolutions(const std::string& problem) const
+    {
+        auto result = std::vector<Solution>{};
+        for(auto i = 0; i < solutions; ++i)
+        {
+            // The neighbouring solutions share a kernel, as the tunings of one solver do.
+            auto kernel         = KernelInfo{};
+            kernel.kernel_file  = "kernel" + std::to_string(i / 2) + ".s";
+            kernel.comp_options = " -DPROBLEM=" + problem + " -DTILE=" + std::to_string(i / 2);
+            kernel.kernel_name  = "kernel";
+            result.push_back({kernel});
+        }
+        return result;
+    }
+
+    static void Compile(Cache& cache, const KernelInfo& kernel)
+    {
+        const auto file = std::stoi(kernel.kernel_file.substr(6));
+        const auto ms   = GetCompileMs(file);
+        std::this_thread::sleep_for(std::chrono::milliseconds{ms});
+        RecordCompileTime(kernel.kernel_file, static_cast<float>(ms));
+        cache.Add(kernel);
+    }
+
+    void Benchmark() const { std::this_thread::sleep_for(std::chrono::milliseconds{benchmark_ms}); }
+
+    void FindStrided(const std::vector<Solution>& sols) const
+    {
+        auto cache   = Cache{};
+        auto kernels = std::vector<KernelInfo>{};
+        for(const auto& sol : sols)
+        {
+            for(const auto& kernel : sol)
+            {
+                if(!cache.Has(kernel))
+                    kernels.push_back(kernel);
+            }
+        }
+
+        par_for_strided(kernels.size(),
+                        max_threads{static_cast<std::size_t>(threads)},
+                        [&](auto i) { Compile(cache, kernels[i]); });
+
+        for(std::size_t i = 0; i < sols.size(); ++i)
+            Benchmark();
+    }
+
+    void FindScheduled(const std::vector<Solution>& sols) const
+    {
+        auto cache     = Cache{};
+        auto scheduler = CompileScheduler{
+            "mock", static_cast<std::size_t>(threads), [&](const KernelInfo& kernel) {
+                if(!cache.Has(kernel))
+                    Compile(cache, kernel);
+            }};
+
+        auto kernels = std::vector<KernelInfo>{};
+        for(const auto& sol : sols)
+            kernels.insert(kernels.end(), sol.begin(), sol.end());
+        scheduler.Start(kernels);
+
+        for(const auto& sol : sols)
+        {
+            scheduler.Wait(sol);
+            Benchmark();
+        }
+    }
+
+    /// Returns the wall time, ms.
+    template <class TFind>
+    static double Measure(TFind find)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        find();
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start)
+            .count();
+    }
+};
+
+} // namespace find_compile
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::find_compile::FindCompileSpeedTest>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "db_speedtest.hpp"
+#include "driver.hpp"
+
+#include <miopen/config.h>
+
+#include <iostream>
+#include <tuple>
+
+#if MIOPEN_ENABLE_SQLITE
+
+#include <miopen/env.hpp>
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace kerndb_lookup {
+
+static KernelConfig MakeKernel(int i, std::size_t blob_size)
+{
+    auto kernel        = KernelConfig{};
+    kernel.kernel_name = "MIOpenConvKernel" + std::to_string(i) + ".o";
+    kernel.kernel_args = " -DMIOPEN_USE_FP32=1 -DMLO_FILTER_SIZE=" + std::to_string(i) +
+                         " -mcpu=gfx90a --save-temps";
+    // Code objects compress poorly, so the blob is random.
+    auto rng = std::mt19937{static_cast<std::mt19937::result_type>(i)};
+    kernel.kernel_blob.resize(blob_size);
+    for(auto& c : kernel.kernel_blob)
+        c = static_cast<char>(rng());
+    return kernel;
+}
+
+using speedtests::GetResidentKiB;
+using speedtests::MeasureUs;
+
+struct KernDbLookupSpeedTest : test_driver
+{
+    KernDbLookupSpeedTest()
+    {
+        add(kernels, "kernels");
+        add(blob_kib, "blob-kib");
+    }
+
+    void run() const
+    {
+        const auto file = TempFile{"miopen.speedtests.kerndb_lookup.kdb"};
+
+        {
+            // The system kernel dbs are installed in the rollback journal mode.
+            UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_SQL_WAL), true);
+            auto db = KernDb{DbKinds::KernelDb, file.Path(), false};
+            db.sql.Exec("BEGIN;");
+            for(auto i = 0; i < kernels; ++i)
+            {
+                const auto kernel = MakeKernel(i, blob_kib * 1024);
+                db.StoreRecord(kernel);
+            }
+            db.sql.Exec("COMMIT;");
+        }
+
+        std::cout << std::setw(10) << "kernels" << std::setw(10) << "access" << std::setw(12)
+                  << "file, KiB" << std::setw(12) << "open, ms" << std::setw(12) << "load, us"
+                  << std::setw(12) << "RSS, KiB" << std::endl;
+
+        Measure(file.Path(), "mmap", false);
+        Measure(file.Path(), "read", true);
+    }
+
+private:
+    int kernels  = 1000;
+    int blob_kib = 16;
+
+    void Measure(const fs::path& path, const std::string& access, bool disable_mmap) const
+    {
+        UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_SQL_MMAP), disable_mmap);
+
+        auto names = std::vector<KernelConfig>{};
+        names.reserve(kernels);
+        for(auto i = 0; i < kernels; ++i)
+            names.push_back(MakeKernel(i, 0));
+
+        const auto rss   = GetResidentKiB();
+        const auto start = std::chrono::steady_clock::now();
+        auto db          = KernDb{DbKinds::KernelDb, path.string(), true};
+        const auto open  = std::chrono::steady_clock::now() - start;
+        auto found       = 0;
+
+        const auto load =
+            MeasureUs(kernels, [&](int i) { found += db.FindRecord(names[i]) ? 1 : 0; });
+
+        if(found != kernels)
+        {
+            std::cerr << "Unexpected number of kernels found: " << found << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::cout << std::setw(10) << kernels << std::setw(10) << access << std::setw(12)
+                  << fs::file_size(path) / 1024 << std::setw(12)
+                  << std::chrono::duration<double, std::milli>(open).count() << std::setw(12)
+                  << load << std::setw(12) << GetResidentKiB() - rss << std::endl;
+    }
+};
+
+} // namespace kerndb_lookup
+} // namespace miopen
+
+#endif
+
+int main(int argc, const char* argv[])
+{
+#if MIOPEN_ENABLE_SQLITE
+    test_drive<miopen::kerndb_lookup::KernDbLookupSpeedTest>(argc, argv);
+#else
+    std::ignore = argc;
+    std::ignore = argv;
+    std::cout << "MIOpen is built without SQLite, nothing to measure" << std::endl;
+#endif
+    return 0;
+}
@@ -0,0 +1,163 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+
+#include <miopen/config.h>
+
+#include <iostream>
+#include <tuple>
+
+#if MIOPEN_ENABLE_SQLITE
+
+#include <miopen/env.hpp>
+#include <miopen/kern_db.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace kerndb_threads {
+
+struct KernDbThreadsSpeedTest : test_driver
+{
+    KernDbThreadsSpeedTest()
+    {
+        add(kernels, "kernels");
+        add(lookups, "lookups");
+        add(max_threads, "max-threads");
+    }
+
+    void run() const
+    {
+        const auto file = TempFile{"miopen.speedtests.kerndb_threads.ukdb"};
+
+        {
+            auto db = KernDb{DbKinds::KernelDb, file.Path(), false};
+            db.sql.Exec("BEGIN;");
+            for(auto i = 0; i < kernels; ++i)
+            {
+                const auto kernel = MakeKernel(i);
+                db.StoreRecord(kernel);
+            }
+            db.sql.Exec("COMMIT;");
+        }
+
+        std::cout << std::setw(10) << "threads" << std::setw(16) << "shared, 1/s"
+                  << std::setw(16) << "readers, 1/s" << std::endl;
+
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+        {
+            const auto shared  = Run(file.Path(), threads, 0);
+            const auto readers = Run(file.Path(), threads, threads);
+            std::cout << std::setw(10) << threads << std::setw(16) << std::fixed
+                      << std::setprecision(0) << shared << std::setw(16) << readers << std::endl;
+        }
+    }
+
+private:
+    int kernels     = 1024;
+    int lookups     = 10000;
+    int max_threads = 16;
+
+    static KernelConfig MakeKernel(int i)
+    {
+        auto kernel        = KernelConfig{};
+        kernel.kernel_name = "MIOpenConvKernel" + std::to_string(i) + ".o";
+        kernel.kernel_args = " -DMIOPEN_USE_FP32=1 -DMLO_FILTER_SIZE=" + std::to_string(i);
+        kernel.kernel_blob = std::string(1024, static_cast<char>(i));
+        return kernel;
+    }
+
+    /// Returns the total number of lookups per second of all threads.
+    double Run(const std::string& path, int threads, int readers) const
+    {
+        UpdateEnvVar(ENV(MIOPEN_DB_SQLITE_READERS), static_cast<uint64_t>(readers));
+        auto db = KernDb{DbKinds::KernelDb, path, false};
+
+        auto names = std::vector<KernelConfig>{};
+        for(auto i = 0; i < kernels; ++i)
+        {
+            names.push_back(MakeKernel(i));
+            names.back().kernel_blob.clear();
+        }
+
+        auto found   = std::atomic<int>{0};
+        auto start   = std::atomic<bool>{false};
+        auto workers = std::vector<std::thread>{};
+
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                while(!start)
+                    std::this_thread::yield();
+                auto local = 0;
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    if(db.FindRecord(names[(i * 7 + t * 13) % kernels]))
+                        ++local;
+                }
+                found += local;
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start            = true;
+        for(auto& worker : workers)
+            worker.join();
+        const auto time = std::chrono::steady_clock::now() - begin;
+
+        if(found != threads * lookups)
+        {
+            std::cerr << "Some kernels were not found" << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        return threads * lookups / std::chrono::duration<double>(time).count();
+    }
+};
+
+} // namespace kerndb_threads
+} // namespace miopen
+
+#endif
+
+int main(int argc, const char* argv[])
+{
+#if MIOPEN_ENABLE_SQLITE
+    test_drive<miopen::kerndb_threads::KernDbThreadsSpeedTest>(argc, argv);
+#else
+    std::ignore = argc;
+    std::ignore = argv;
+    std::cout << "MIOpen is built without SQLite, nothing to measure" << std::endl;
+#endif
+    return 0;
+}
@@ -0,0 +1,152 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+
+#include <miopen/datatype.hpp>
+#include <miopen/handle.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace kernel_cache {
+
+/// Measures the lookups of kernels in the cache of a handle, as done on every launch by the
+/// legacy kernel paths, by several threads sharing the handle.
+struct KernelCacheSpeedTest : test_driver
+{
+    KernelCacheSpeedTest()
+    {
+        add(configs, "configs");
+        add(lookups, "lookups");
+        add(max_threads, "max-threads");
+    }
+
+    void run() const
+    {
+        auto&& handle              = get_handle();
+        const auto network_configs = MakeNetworkConfigs();
+        const auto params = "-DSUBTENSOR_OP_WITH_SCALAR=SUBTENSOR_OP_WITH_SCALAR_SET" +
+                            GetDataTypeKernelParams(miopenFloat) + " -DWORK_LENGTH_0=1024";
+
+        // The program is built once, the other kernels are taken from the cache.
+        for(const auto& network_config : network_configs)
+        {
+            handle.AddKernel(kernel_name,
+                             network_config,
+                             "MIOpenSubTensorOpWithScalarKernel.cl",
+                             kernel_name,
+                             {256, 1, 1},
+                             {1024, 1, 1},
+                             params);
+        }
+
+        std::cout << std::setw(10) << "threads" << std::setw(16) << "lookups/s"
+                  << std::setw(12) << "scaling" << std::endl;
+
+        auto single = 0.;
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+        {
+            const auto rate = Run(handle, network_configs, threads);
+            if(threads == 1)
+                single = rate;
+            std::cout << std::setw(10) << threads << std::setw(16) << std::fixed
+                      << std::setprecision(0) << rate << std::setw(12) << std::setprecision(2)
+                      << rate / single << std::endl;
+        }
+    }
+
+private:
+    static constexpr const char* kernel_name = "SubTensorOpWithScalar1d";
+
+    int configs     = 256;
+    int lookups     = 1000000;
+    int max_threads = 16;
+
+    std::vector<std::string> MakeNetworkConfigs() const
+    {
+        auto network_configs = std::vector<std::string>{};
+        for(auto i = 0; i < configs; ++i)
+            network_configs.push_back("set " + std::to_string(miopenFloat) + " " +
+                                      std::to_string(1024 + i));
+        return network_configs;
+    }
+
+    /// Returns the total number of lookups per second of all threads.
+    double Run(const Handle& handle,
+               const std::vector<std::string>& network_configs,
+               int threads) const
+    {
+        auto found   = std::atomic<int>{0};
+        auto start   = std::atomic<bool>{false};
+        auto workers = std::vector<std::thread>{};
+
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                while(!start)
+                    std::this_thread::yield();
+                auto local = 0;
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    const auto& network_config = network_configs[(i * 7 + t * 13) % configs];
+                    if(!handle.GetKernelsImpl(kernel_name, network_config)->empty())
+                        ++local;
+                }
+                found += local;
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start            = true;
+        for(auto& worker : workers)
+            worker.join();
+        const auto time = std::chrono::steady_clock::now() - begin;
+
+        if(found != threads * lookups)
+        {
+            std::cerr << "Some kernels were not found" << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        return threads * lookups / std::chrono::duration<double>(time).count();
+    }
+};
+
+} // namespace kernel_cache
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::kernel_cache::KernelCacheSpeedTest>(argc, argv);
+    return 0;
+}
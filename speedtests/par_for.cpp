@@ -0,0 +1,118 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+#include "ford.hpp"
+
+#include <miopen/par_for.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace par_for_speedtest {
+
+/// Compares par_for() on the thread pool with spawning the threads on each call, as it was done
+/// before, for loops of different sizes.
+struct ParForSpeedTest : test_driver
+{
+    ParForSpeedTest()
+    {
+        add(threads, "threads");
+        add(min_time_ms, "min-time-ms");
+    }
+
+    void run() const
+    {
+        std::cout << std::setw(12) << "iterations" << std::setw(14) << "spawn, us"
+                  << std::setw(14) << "pool, us" << std::setw(12) << "speedup" << std::endl;
+
+        for(const std::size_t n : {64, 4096, 1048576})
+        {
+            const auto spawn = Measure(n, [&](auto f) { SpawnFor(n, threads, f); });
+            const auto pool  = Measure(n, [&](auto f) { par_for(n, max_threads{threads}, f); });
+            std::cout << std::setw(12) << n << std::setw(14) << std::fixed << std::setprecision(1)
+                      << spawn << std::setw(14) << pool << std::setw(12) << std::setprecision(2)
+                      << spawn / pool << std::endl;
+        }
+    }
+
+private:
+    std::size_t threads = std::thread::hardware_concurrency();
+    int min_time_ms     = 500;
+
+    /// The former implementation of par_for_impl().
+    template <class F>
+    static void SpawnFor(std::size_t n, std::size_t threadsize, F f)
+    {
+        std::vector<joinable_thread> workers(threadsize);
+        const std::size_t grainsize = std::ceil(static_cast<double>(n) / workers.size());
+
+        std::size_t work = 0;
+        std::generate(workers.begin(),
+                      workers.end(),
+                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
+    }
+
+    /// Returns the average time of a loop, us.
+    template <class TLoop>
+    double Measure(std::size_t n, TLoop loop) const
+    {
+        auto data       = std::vector<float>(n, 1.f);
+        const auto body = [&](std::size_t i) { data[i] = std::sqrt(data[i] * 2.f + 1.f); };
+
+        auto loops       = 0;
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed     = std::chrono::steady_clock::duration{};
+        do
+        {
+            loop(body);
+            ++loops;
+            elapsed = std::chrono::steady_clock::now() - start;
+        } while(elapsed < std::chrono::milliseconds{min_time_ms});
+
+        if(!std::isfinite(data[n / 2]))
+        {
+            std::cerr << "Unexpected result" << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        return std::chrono::duration<double, std::micro>(elapsed).count() / loops;
+    }
+};
+
+} // namespace par_for_speedtest
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::par_for_speedtest::ParForSpeedTest>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,150 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+namespace miopen {
+namespace perfdb_batch {
+
+static std::string MakeKey(int i)
+{
+    return "3-32-32-3x3-64-32-32-" + std::to_string(i) + "-1x1-1x1-1x1-0-NCHW-FP32-F";
+}
+
+struct Values
+{
+    int value;
+
+    void Serialize(std::ostream& stream) const { stream << value << ",16,4,1"; }
+};
+
+static DbRecord MakeRecord(int key, int value)
+{
+    auto record = DbRecord{DbKinds::PerfDb, MakeKey(key)};
+    record.SetValues("ConvOclDirectFwd", Values{value});
+    return record;
+}
+
+struct PerfDbBatchSpeedTest : test_driver
+{
+    PerfDbBatchSpeedTest()
+    {
+        add(records, "records");
+        add(updates, "updates");
+    }
+
+    void run() const
+    {
+        std::cout << std::setw(12) << "db" << std::setw(10) << "records" << std::setw(10)
+                  << "updates" << std::setw(14) << "single, us" << std::setw(14) << "batch, us"
+                  << std::endl;
+
+        Run<PlainTextDb>("PlainTextDb");
+        Run<RamDb>("RamDb");
+    }
+
+private:
+    int records = 4096;
+    int updates = 64;
+
+    template <class TFunc>
+    static double MeasureUs(TFunc&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto time = std::chrono::steady_clock::now() - start;
+        return std::chrono::duration<double, std::micro>(time).count();
+    }
+
+    void Fill(const TempFile& file) const
+    {
+        auto out = std::ofstream{file.Path()};
+        for(auto i = 0; i < records; ++i)
+            out << MakeKey(i) << "=ConvOclDirectFwd:1,16,4,1\n";
+    }
+
+    /// Half of the updates replace existing records, the others add new ones, like a search does.
+    int UpdatedKey(int i) const { return i % 2 == 0 ? i * records / updates : records + i; }
+
+    template <class TDb>
+    void Run(const std::string& name) const
+    {
+        const auto single_file = TempFile{"miopen.speedtests.perfdb_batch.single"};
+        const auto batch_file  = TempFile{"miopen.speedtests.perfdb_batch.batch"};
+        Fill(single_file);
+        Fill(batch_file);
+
+        const auto single = MeasureUs([&]() {
+            auto db = TDb{DbKinds::PerfDb, single_file.Path()};
+            for(auto i = 0; i < updates; ++i)
+            {
+                auto record = MakeRecord(UpdatedKey(i), i);
+                db.UpdateRecord(record);
+            }
+        });
+
+        const auto batch = MeasureUs([&]() {
+            auto db = TDb{DbKinds::PerfDb, batch_file.Path()};
+            auto b  = db.BeginBatch();
+            for(auto i = 0; i < updates; ++i)
+            {
+                auto record = MakeRecord(UpdatedKey(i), i);
+                b.UpdateRecord(record);
+            }
+            b.Commit();
+        });
+
+        if(fs::file_size(single_file.Path()) != fs::file_size(batch_file.Path()))
+        {
+            std::cerr << "Batched and single updates produced different files" << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::cout << std::setw(12) << name << std::setw(10) << records << std::setw(10)
+                  << updates << std::setw(14) << single / updates << std::setw(14)
+                  << batch / updates << std::endl;
+    }
+};
+
+} // namespace perfdb_batch
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perfdb_batch::PerfDbBatchSpeedTest>(argc, argv);
+    return 0;
+}
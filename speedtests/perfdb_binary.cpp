@@ -0,0 +1,159 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "db_speedtest.hpp"
+#include "driver.hpp"
+
+#include <miopen/db_binary_format.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/readonlyramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace perfdb_binary {
+
+using speedtests::GetResidentKiB;
+using speedtests::MakeContents;
+using speedtests::MakeKey;
+using speedtests::MeasureUs;
+
+struct Values
+{
+    std::string data;
+
+    bool Deserialize(const std::string& str)
+    {
+        data = str;
+        return true;
+    }
+};
+
+struct PerfDbBinarySpeedTest : test_driver
+{
+    PerfDbBinarySpeedTest()
+    {
+        add(max_records, "max-records");
+        add(lookups, "lookups");
+    }
+
+    void run() const
+    {
+        std::cout << std::setw(10) << "records" << std::setw(8) << "format" << std::setw(12)
+                  << "file, KiB" << std::setw(12) << "load, ms" << std::setw(12) << "RSS, KiB"
+                  << std::setw(12) << "hit, us" << std::setw(12) << "miss, us" << std::endl;
+
+        for(auto records = 4096; records <= max_records; records *= 4)
+            Run(records);
+    }
+
+private:
+    int max_records = 256 * 1024;
+    int lookups     = 100000;
+
+    void Run(int records) const
+    {
+        auto rng  = std::mt19937{};
+        auto text = TempFile{"miopen.speedtests.perfdb_binary.txt"};
+        auto bin  = TempFile{"miopen.speedtests.perfdb_binary.bin"};
+
+        {
+            auto text_file = std::ofstream{text.Path()};
+            auto sources   = std::vector<binary_db::SourceRecord>(records);
+            for(auto i = 0; i < records; ++i)
+            {
+                const auto line = MakeKey(i) + '=' + MakeContents(rng, 3);
+                text_file << line << '\n';
+                binary_db::ParseTextRecord(line, sources[i]);
+            }
+            auto bin_file = std::ofstream{bin.Path(), std::ios::binary};
+            binary_db::Write(std::move(sources), bin_file);
+        }
+
+        auto keys = std::vector<std::string>{};
+        auto dist = std::uniform_int_distribution<int>{0, records - 1};
+        keys.reserve(lookups);
+        for(auto i = 0; i < lookups; ++i)
+            keys.push_back(MakeKey(dist(rng)));
+
+        Measure(records, "text", text.Path(), keys);
+        Measure(records, "binary", bin.Path(), keys);
+    }
+
+    void Measure(int records,
+                 const std::string& format,
+                 const fs::path& path,
+                 std::vector<std::string> keys) const
+    {
+        const auto file_size    = fs::file_size(path);
+        const auto rss          = GetResidentKiB();
+        const ReadonlyRamDb* db = nullptr;
+
+        const auto load = MeasureUs(1, [&](int) {
+            db = &ReadonlyRamDb::GetCached(DbKinds::PerfDb, path.string(), true);
+        });
+
+        const auto rss_delta = GetResidentKiB() - rss;
+        auto found           = 0;
+
+        const auto hit = MeasureUs(lookups, [&](int i) {
+            auto value        = Values{};
+            const auto record = db->FindRecord(keys[i]);
+            found += record && record->GetValues("ConvAsm1x1U", value) ? 1 : 0;
+        });
+
+        for(auto& key : keys)
+            key.back() = 'B';
+
+        const auto miss =
+            MeasureUs(lookups, [&](int i) { found += db->FindRecord(keys[i]) ? 1 : 0; });
+
+        if(found != lookups)
+        {
+            std::cerr << "Unexpected number of records found: " << found << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::cout << std::setw(10) << records << std::setw(8) << format << std::setw(12)
+                  << file_size / 1024 << std::setw(12) << load / 1000 << std::setw(12)
+                  << rss_delta << std::setw(12) << hit << std::setw(12) << miss << std::endl;
+    }
+};
+
+} // namespace perfdb_binary
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perfdb_binary::PerfDbBinarySpeedTest>(argc, argv);
+    return 0;
+}
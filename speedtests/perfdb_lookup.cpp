@@ -0,0 +1,144 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "db_speedtest.hpp"
+#include "driver.hpp"
+
+#include <miopen/db.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace perfdb_lookup {
+
+using speedtests::MakeContents;
+using speedtests::MakeKey;
+using speedtests::MeasureUs;
+
+/// The way PlainTextDb used to look for records: a scan of the whole file.
+static bool LinearScan(const std::string& path, const std::string& key)
+{
+    auto file = std::ifstream{path, std::ios::binary};
+    auto line = std::string{};
+
+    while(std::getline(file, line))
+    {
+        const auto key_size = line.find('=');
+        if(key_size != std::string::npos && line.compare(0, key_size, key) == 0 &&
+           key_size == key.size())
+            return true;
+    }
+    return false;
+}
+
+struct PerfDbLookupSpeedTest : test_driver
+{
+    PerfDbLookupSpeedTest()
+    {
+        add(max_records, "max-records");
+        add(lookups, "lookups");
+        add(scan_lookups, "scan-lookups");
+    }
+
+    void run() const
+    {
+        std::cout << std::setw(10) << "records" << std::setw(12) << "file, KiB" << std::setw(16)
+                  << "1st lookup, us" << std::setw(12) << "hit, us" << std::setw(12) << "miss, us"
+                  << std::setw(12) << "scan, us" << std::endl;
+
+        for(auto records = 1024; records <= max_records; records *= 4)
+            Run(records);
+    }
+
+private:
+    int max_records  = 64 * 1024;
+    int lookups      = 100000;
+    int scan_lookups = 100;
+
+    void Run(int records) const
+    {
+        auto rng  = std::mt19937{};
+        auto temp = TempFile{"miopen.speedtests.perfdb_lookup"};
+
+        {
+            auto file = std::ofstream{temp.Path()};
+            for(auto i = 0; i < records; ++i)
+                file << MakeKey(i) << '=' << MakeContents(rng) << '\n';
+        }
+
+        const auto file_size = fs::file_size(temp.Path());
+        auto db              = PlainTextDb{DbKinds::PerfDb, temp.Path()};
+        auto found           = 0;
+        auto dist            = std::uniform_int_distribution<int>{0, records - 1};
+
+        const auto first =
+            MeasureUs(1, [&](int) { found += db.FindRecord(MakeKey(dist(rng))) ? 1 : 0; });
+
+        auto keys = std::vector<std::string>{};
+        keys.reserve(lookups);
+        for(auto i = 0; i < lookups; ++i)
+            keys.push_back(MakeKey(dist(rng)));
+
+        const auto hit =
+            MeasureUs(lookups, [&](int i) { found += db.FindRecord(keys[i]) ? 1 : 0; });
+
+        for(auto& key : keys)
+            key.back() = 'B';
+
+        const auto miss =
+            MeasureUs(lookups, [&](int i) { found += db.FindRecord(keys[i]) ? 1 : 0; });
+
+        const auto scan = MeasureUs(scan_lookups, [&](int) {
+            found += LinearScan(temp.Path(), MakeKey(dist(rng))) ? 1 : 0;
+        });
+
+        if(found != 1 + lookups + scan_lookups)
+        {
+            std::cerr << "Unexpected number of records found: " << found << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        std::cout << std::setw(10) << records << std::setw(12) << file_size / 1024
+                  << std::setw(16) << first << std::setw(12) << hit << std::setw(12) << miss
+                  << std::setw(12) << scan << std::endl;
+    }
+};
+
+} // namespace perfdb_lookup
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perfdb_lookup::PerfDbLookupSpeedTest>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "driver.hpp"
+
+#include <miopen/db_record.hpp>
+#include <miopen/db_write_queue.hpp>
+#include <miopen/env.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace perfdb_write_behind {
+
+struct PerfDbWriteBehindSpeedTest : test_driver
+{
+    PerfDbWriteBehindSpeedTest()
+    {
+        add(records, "records");
+        add(updates, "updates");
+    }
+
+    void run() const
+    {
+        std::cout << std::setw(14) << "write-behind" << std::setw(12) << "p50, us"
+                  << std::setw(12) << "p99, us" << std::setw(12) << "max, us" << std::endl;
+
+        for(const auto write_behind : {false, true})
+        {
+            UpdateEnvVar(ENV(MIOPEN_DB_WRITE_BEHIND), write_behind);
+
+            const auto file = TempFile{"miopen.speedtests.perfdb_write_behind"};
+            auto& db        = RamDb::GetCached(DbKinds::PerfDb, file.Path(), false);
+            auto times      = Run(db);
+
+            if(write_behind)
+                DbWriteQueue::Get().Flush();
+
+            std::sort(times.begin(), times.end());
+            std::cout << std::setw(14) << write_behind << std::fixed << std::setprecision(1)
+                      << std::setw(12) << times[times.size() / 2] << std::setw(12)
+                      << times[times.size() * 99 / 100] << std::setw(12) << times.back()
+                      << std::endl;
+        }
+    }
+
+private:
+    int records = 1024;
+    int updates = 2000;
+
+    struct Values
+    {
+        int value;
+
+        void Serialize(std::ostream& stream) const { stream << value << ",16,4,1"; }
+    };
+
+    static std::string MakeKey(int i)
+    {
+        return "64-28-28-3x3-128-28-28-" + std::to_string(i) + "-1x1-1x1-1x1-0-NCHW-FP32-F";
+    }
+
+    /// Returns the durations of the updates in microseconds.
+    std::vector<double> Run(RamDb& db) const
+    {
+        auto batch = db.BeginBatch();
+        for(auto i = 0; i < records; ++i)
+        {
+            auto record = DbRecord{DbKinds::PerfDb, MakeKey(i)};
+            record.SetValues("ConvOclDirectFwd", Values{i});
+            batch.StoreRecord(record);
+        }
+        batch.Commit();
+
+        auto times = std::vector<double>{};
+        times.reserve(updates);
+
+        for(auto i = 0; i < updates; ++i)
+        {
+            // The tuning result of another solver for an already tuned problem, as done by Find.
+            auto record = DbRecord{DbKinds::PerfDb, MakeKey(i * 7 % records)};
+            record.SetValues("ConvHipImplicitGemmV4R1Fwd", Values{i});
+
+            const auto begin = std::chrono::steady_clock::now();
+            db.UpdateRecord(record);
+            const auto time = std::chrono::steady_clock::now() - begin;
+            times.push_back(std::chrono::duration<double, std::micro>(time).count());
+        }
+
+        return times;
+    }
+};
+
+} // namespace perfdb_write_behind
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::perfdb_write_behind::PerfDbWriteBehindSpeedTest>(argc, argv);
+    return 0;
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
+#include <miopen/problem_key.hpp>
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE)
+
+namespace miopen {
+namespace problem_key {
+
+struct ProblemKeySpeedTest : test_driver
+{
+    ProblemKeySpeedTest() { add(iterations, "iterations"); }
+
+    void run() const
+    {
+        const auto in      = TensorDescriptor{miopenHalf, {16, 64, 28, 28}};
+        const auto wei     = TensorDescriptor{miopenHalf, {128, 64, 3, 3}};
+        const auto out     = TensorDescriptor{miopenHalf, {16, 128, 28, 28}};
+        const auto conv    = ConvolutionDescriptor{{1, 1}, {1, 1}, {1, 1}};
+        const auto problem = conv::ProblemDescription{in, wei, out, conv, conv::Direction::Forward};
+
+        std::cout << std::setw(24) << "operation" << std::setw(14) << "text, ns"
+                  << std::setw(14) << "cached, ns" << std::endl;
+
+        std::cout << std::setw(24) << "MakeKey" << std::setw(14) << "-" << std::setw(14)
+                  << MeasureNs([&]() { return problem.MakeKey().GetHash().lo; }) << std::endl;
+
+        Run("MakeNetworkConfig", [&]() { return problem.MakeNetworkConfig().ToString().size(); });
+        Run("find-db key", [&]() { return DbRecord{DbKinds::FindDb, problem}.GetKey().size(); });
+        Run("perf-db key", [&]() { return DbRecord{DbKinds::PerfDb, problem}.GetKey().size(); });
+    }
+
+private:
+    int iterations = 100000;
+
+    /// Average time of a call in ns. The results are used so the calls are not optimized out.
+    template <class TFunc>
+    double MeasureNs(TFunc&& func) const
+    {
+        auto sink        = std::size_t{0};
+        const auto start = std::chrono::steady_clock::now();
+        for(auto i = 0; i < iterations; ++i)
+            sink += func();
+        const auto time = std::chrono::steady_clock::now() - start;
+        if(sink == 0)
+            std::cerr << "Unexpected empty results" << std::endl;
+        return std::chrono::duration<double, std::nano>(time).count() / iterations;
+    }
+
+    template <class TFunc>
+    void Run(const std::string& name, TFunc&& func) const
+    {
+        UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE), true);
+        const auto text = MeasureNs(func);
+        UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE), false);
+        const auto cached = MeasureNs(func);
+
+        std::cout << std::setw(24) << name << std::setw(14) << text << std::setw(14) << cached
+                  << std::endl;
+    }
+};
+
+} // namespace problem_key
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::problem_key::ProblemKeySpeedTest>(argc, argv);
+    return 0;
+}
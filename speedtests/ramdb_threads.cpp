@@ -0,0 +1,147 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "driver.hpp"
+
+#include <miopen/db_record.hpp>
+#include <miopen/ramdb.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace ramdb_threads {
+
+struct RamDbThreadsSpeedTest : test_driver
+{
+    RamDbThreadsSpeedTest()
+    {
+        add(records, "records");
+        add(lookups, "lookups");
+        add(max_threads, "max-threads");
+    }
+
+    void run() const
+    {
+        const auto file = TempFile{"miopen.speedtests.ramdb_threads"};
+        auto& db        = RamDb::GetCached(DbKinds::PerfDb, file.Path(), false);
+        auto batch      = db.BeginBatch();
+        for(auto i = 0; i < records; ++i)
+        {
+            auto record = DbRecord{DbKinds::PerfDb, MakeKey(i)};
+            record.SetValues("ConvOclDirectFwd", Values{i});
+            batch.StoreRecord(record);
+        }
+        batch.Commit();
+
+        std::cout << std::setw(10) << "threads" << std::setw(16) << "lookups/s"
+                  << std::setw(12) << "scaling" << std::endl;
+
+        auto single = 0.;
+        for(auto threads = 1; threads <= max_threads; threads *= 2)
+        {
+            const auto rate = Run(db, threads);
+            if(threads == 1)
+                single = rate;
+            std::cout << std::setw(10) << threads << std::setw(16) << std::fixed
+                      << std::setprecision(0) << rate << std::setw(12) << std::setprecision(2)
+                      << rate / single << std::endl;
+        }
+    }
+
+private:
+    int records     = 1024;
+    int lookups     = 100000;
+    int max_threads = 16;
+
+    struct Values
+    {
+        int value;
+
+        void Serialize(std::ostream& stream) const { stream << value << ",16,4,1"; }
+    };
+
+    static std::string MakeKey(int i)
+    {
+        return "64-28-28-3x3-128-28-28-" + std::to_string(i) + "-1x1-1x1-1x1-0-NCHW-FP32-F";
+    }
+
+    /// Returns the total number of lookups per second of all threads.
+    double Run(RamDb& db, int threads) const
+    {
+        auto keys = std::vector<std::string>{};
+        for(auto i = 0; i < records; ++i)
+            keys.push_back(MakeKey(i));
+
+        auto found   = std::atomic<int>{0};
+        auto start   = std::atomic<bool>{false};
+        auto workers = std::vector<std::thread>{};
+
+        for(auto t = 0; t < threads; ++t)
+        {
+            workers.emplace_back([&, t]() {
+                while(!start)
+                    std::this_thread::yield();
+                auto local = 0;
+                for(auto i = 0; i < lookups; ++i)
+                {
+                    if(db.FindRecord(keys[(i * 7 + t * 13) % records]))
+                        ++local;
+                }
+                found += local;
+            });
+        }
+
+        const auto begin = std::chrono::steady_clock::now();
+        start            = true;
+        for(auto& worker : workers)
+            worker.join();
+        const auto time = std::chrono::steady_clock::now() - begin;
+
+        if(found != threads * lookups)
+        {
+            std::cerr << "Some records were not found" << std::endl;
+            std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+        }
+
+        return threads * lookups / std::chrono::duration<double>(time).count();
+    }
+};
+
+} // namespace ramdb_threads
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::ramdb_threads::RamDbThreadsSpeedTest>(argc, argv);
+    return 0;
+}
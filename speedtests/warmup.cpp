@@ -0,0 +1,147 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include "driver.hpp"
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/driver_arguments.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/warmup.hpp>
+
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace miopen {
+namespace warmup {
+
+struct WarmUpSpeedTest : test_driver
+{
+    WarmUpSpeedTest() { add(commands, "commands"); }
+
+    void run() const
+    {
+        const auto problems = ReadProblems();
+
+        auto cold_handle = Handle{};
+        const auto cold  = PrepareAll(cold_handle, problems);
+
+        auto handle      = Handle{};
+        const auto stats = WarmUp(handle, problems);
+        const auto warm  = PrepareAll(handle, problems);
+        const auto again = PrepareAll(handle, problems);
+
+        std::cout << "Warmed up " << stats.warmed << " of " << stats.problems << " problems in "
+                  << std::fixed << std::setprecision(1) << stats.time_ms << " ms, "
+                  << stats.GetProblemsPerSecond() << " problems/s" << std::endl;
+        std::cout << std::setw(28) << "first call, cold, ms/problem" << std::setw(12) << cold
+                  << std::endl;
+        std::cout << std::setw(28) << "first call, warm, ms/problem" << std::setw(12) << warm
+                  << std::endl;
+        std::cout << std::setw(28) << "steady state, ms/problem" << std::setw(12) << again
+                  << std::endl;
+    }
+
+private:
+    std::string commands;
+
+    std::vector<Problem> ReadProblems() const
+    {
+        if(!commands.empty())
+        {
+            auto file = std::ifstream{commands};
+            if(!file)
+            {
+                std::cerr << "Unable to open " << commands << std::endl;
+                std::exit(-1); // NOLINT (concurrency-mt-unsafe)
+            }
+            return ReadDriverCommands(file);
+        }
+
+        // Convolutions of ResNet-50 inference.
+        const std::string layers[] = {
+            "-c 3 -H 224 -W 224 -k 64 -y 7 -x 7 -p 3 -q 3 -u 2 -v 2",
+            "-c 64 -H 56 -W 56 -k 64 -y 1 -x 1",
+            "-c 64 -H 56 -W 56 -k 64 -y 3 -x 3 -p 1 -q 1",
+            "-c 64 -H 56 -W 56 -k 256 -y 1 -x 1",
+            "-c 256 -H 56 -W 56 -k 64 -y 1 -x 1",
+            "-c 256 -H 56 -W 56 -k 128 -y 1 -x 1 -u 2 -v 2",
+            "-c 128 -H 28 -W 28 -k 128 -y 3 -x 3 -p 1 -q 1",
+            "-c 128 -H 28 -W 28 -k 512 -y 1 -x 1",
+            "-c 512 -H 28 -W 28 -k 128 -y 1 -x 1",
+            "-c 512 -H 28 -W 28 -k 256 -y 1 -x 1 -u 2 -v 2",
+            "-c 256 -H 14 -W 14 -k 256 -y 3 -x 3 -p 1 -q 1",
+            "-c 256 -H 14 -W 14 -k 1024 -y 1 -x 1",
+            "-c 1024 -H 14 -W 14 -k 256 -y 1 -x 1",
+            "-c 1024 -H 14 -W 14 -k 512 -y 1 -x 1 -u 2 -v 2",
+            "-c 512 -H 7 -W 7 -k 512 -y 3 -x 3 -p 1 -q 1",
+            "-c 512 -H 7 -W 7 -k 2048 -y 1 -x 1",
+            "-c 2048 -H 7 -W 7 -k 512 -y 1 -x 1",
+        };
+
+        auto problems = std::vector<Problem>{};
+        for(const auto& layer : layers)
+        {
+            for(auto& problem : debug::ParseConvDriverArgs("conv -n 1 " + layer + " -F 1"))
+                problems.push_back(std::move(problem));
+        }
+        return problems;
+    }
+
+    /// Returns the time of the immediate mode preparation of a problem in ms: the selection of
+    /// the solution and the compilation of its invoker.
+    static double PrepareAll(Handle& handle, const std::vector<Problem>& problems)
+    {
+        const auto begin = std::chrono::steady_clock::now();
+        for(const auto& problem : problems)
+        {
+            const auto conv_problem = problem.AsConvolution();
+            auto ctx                = ExecutionContext{&handle};
+            const auto& conv        = conv_problem.GetConv();
+            const auto solutions    = conv.GetSolutions(ctx, conv_problem, 1, nullptr);
+            if(solutions.empty())
+                continue;
+            conv.CompileSolution(ctx, conv_problem, solver::Id{solutions.front().solution_id});
+        }
+        const auto time = std::chrono::steady_clock::now() - begin;
+        return std::chrono::duration<double, std::milli>(time).count() / problems.size();
+    }
+};
+
+} // namespace warmup
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    test_drive<miopen::warmup::WarmUpSpeedTest>(argc, argv);
+    return 0;
+}
@@ -26,31 +26,26 @@
 
 #include <miopen/anyramdb.hpp>
 
-#include <miopen/errors.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/env.hpp>
 #include <miopen/logger.hpp>
 
-#include <miopen/filesystem.hpp>
-
-#include <chrono>
-#include <ctime>
-#include <fstream>
-#include <limits>
+#include <functional>
 #include <map>
 #include <mutex>
-#include <sstream>
-
-namespace miopen {
 
-#define MIOPEN_VALIDATE_LOCK(lock)                       \
-    do                                                   \
-    {                                                    \
-        if(!(lock))                                      \
-            MIOPEN_THROW("Db lock has failed to lock."); \
-    } while(false)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_ANYRAMDB_CACHE_LIMIT)
 
-static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
+namespace miopen {
 
-using exclusive_lock = std::unique_lock<LockFile>;
+AnyRamDb::AnyRamDb(std::string filename_) : filename(filename_)
+{
+    const auto limit = Value(ENV(MIOPEN_ANYRAMDB_CACHE_LIMIT));
+    // Rounded up, so each shard holds at least one record.
+    const auto shard_limit = (limit + shard_count - 1) / shard_count;
+    for(auto& shard : shards)
+        shard.records.SetCapacity(shard_limit);
+}
 
 AnyRamDb& AnyRamDb::GetCached(const std::string& path)
 {
@@ -75,54 +70,74 @@ AnyRamDb& AnyRamDb::GetCached(const std::string& path)
     return *instance;
 }
 
-boost::optional<AnyRamDb::TRecord> AnyRamDb::FindRecord(const std::string& problem)
+AnyRamDb::Shard& AnyRamDb::GetShard(const std::string& key)
 {
-    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
-    MIOPEN_VALIDATE_LOCK(lock);
-
-    return FindRecordUnsafe(problem);
+    return shards[std::hash<std::string>{}(key) % shard_count];
 }
 
-bool AnyRamDb::StoreRecord(const std::string& problem, AnyRamDb::TRecord& record)
+std::ptrdiff_t AnyRamDb::GetSize(const std::string& key, const TRecord& record)
 {
-    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
-    MIOPEN_VALIDATE_LOCK(lock);
-    UpdateCacheEntryUnsafe(problem, record);
-    return true;
+    return static_cast<std::ptrdiff_t>(sizeof(key) + key.size() + sizeof(record) +
+                                       record.size() * sizeof(boost::any));
 }
 
-bool AnyRamDb::RemoveRecord(const std::string& key)
+boost::optional<AnyRamDb::TRecord> AnyRamDb::FindRecord(const std::string& problem)
 {
-    MIOPEN_LOG_I2("Trying to remove record at key " << key << " from cache for file " << filename);
-    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
-    MIOPEN_VALIDATE_LOCK(lock);
-    cache.erase(key);
-    return true;
+    return DbStats::Get(DbStats::Kind::AnyRamDb).MeasureLookup([&]() {
+        MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << filename);
+        auto& shard = GetShard(problem);
+        const std::shared_lock<std::shared_mutex> lock{shard.mutex};
+        const auto& records = shard.records;
+        const auto record   = records.Find(problem);
+
+        if(record == nullptr)
+            return boost::optional<TRecord>{};
+
+        return boost::make_optional(*record);
+    });
 }
 
-boost::optional<AnyRamDb::TRecord> AnyRamDb::FindRecordUnsafe(const std::string& problem)
+bool AnyRamDb::StoreRecord(const std::string& problem, AnyRamDb::TRecord& record)
 {
-    MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << filename);
-    const auto it = cache.find(problem);
-
-    if(it == cache.end())
-        return boost::none;
-
-    return it->second;
+    {
+        auto& shard = GetShard(problem);
+        const std::unique_lock<std::shared_mutex> lock{shard.mutex};
+        auto evicted = std::size_t{0};
+
+        auto inserted = shard.records.TryEmplace(
+            problem,
+            [&](const std::string& key, const TRecord& old) {
+                MIOPEN_LOG_I2("Evicting key " << key << " from cache for file " << filename);
+                resident_bytes.Add(-GetSize(key, old));
+                ++evicted;
+            },
+            record);
+
+        if(!inserted.second)
+        {
+            resident_bytes.Add(-GetSize(problem, inserted.first));
+            inserted.first = record;
+        }
+
+        resident_bytes.Add(GetSize(problem, record));
+        if(evicted != 0)
+            DbStats::Get(DbStats::Kind::AnyRamDb).AddEvictions(evicted);
+    }
+    DbStats::Get(DbStats::Kind::AnyRamDb).AddStore();
+    return true;
 }
 
-void AnyRamDb::UpdateCacheEntryUnsafe(const std::string& key, const TRecord& value)
+bool AnyRamDb::RemoveRecord(const std::string& key)
 {
-    const auto it = cache.find(key);
-    if(it != cache.end())
-    {
-        auto& item = it->second;
-        item       = value;
-    }
-    else
+    MIOPEN_LOG_I2("Trying to remove record at key " << key << " from cache for file " << filename);
+    auto& shard = GetShard(key);
+    const std::unique_lock<std::shared_mutex> lock{shard.mutex};
+    if(const auto record = shard.records.Find(key))
     {
-        cache.emplace(key, value);
+        resident_bytes.Add(-GetSize(key, *record));
+        shard.records.Erase(key);
     }
+    return true;
 }
 
 } // namespace miopen
@@ -34,10 +34,15 @@
 #include <miopen/solution.hpp>
 #include <miopen/solver_id.hpp>
 #include <miopen/type_name.hpp>
+#include <miopen/warmup.hpp>
 
 #include <nlohmann/json.hpp>
 #include <boost/hof/match.hpp>
 
+#include <fstream>
+#include <string>
+#include <vector>
+
 template <class OperationDescriptor>
 static miopenStatus_t MakeProblem(miopenProblem_t* problem,
                                   OperationDescriptor operatorDesc,
@@ -249,6 +254,56 @@ miopenStatus_t miopenFindSolutions(miopenHandle_t handle,
     });
 }
 
+miopenStatus_t miopenWarmUpProblems(miopenHandle_t handle,
+                                    const miopenProblem_t* problems,
+                                    size_t numProblems,
+                                    size_t* numWarmedUp)
+{
+    MIOPEN_LOG_FUNCTION(handle, problems, numProblems, numWarmedUp);
+
+    return miopen::try_([&] {
+        auto problems_deref = std::vector<miopen::Problem>{};
+        problems_deref.reserve(numProblems);
+
+        for(std::size_t i = 0; i < numProblems; ++i)
+        {
+            const auto& item = miopen::deref(miopen::deref(problems + i)).item;
+            if(const auto problem = boost::get<miopen::Problem>(&item))
+                problems_deref.push_back(*problem);
+        }
+
+        const auto stats = miopen::WarmUp(miopen::deref(handle), problems_deref);
+
+        if(numWarmedUp != nullptr)
+            *numWarmedUp = stats.warmed;
+    });
+}
+
+miopenStatus_t miopenWarmUpFromDriverCommands(miopenHandle_t handle,
+                                              const char* path,
+                                              size_t* numProblems,
+                                              size_t* numWarmedUp)
+{
+    MIOPEN_LOG_FUNCTION(handle, path, numProblems, numWarmedUp);
+
+    return miopen::try_([&] {
+        if(path == nullptr)
+            MIOPEN_THROW(miopenStatusBadParm, "Dereferencing nullptr");
+
+        auto file = std::ifstream{path};
+        if(!file)
+            MIOPEN_THROW(miopenStatusBadParm, std::string{"Unable to open "} + path);
+
+        const auto problems = miopen::ReadDriverCommands(file);
+        const auto stats    = miopen::WarmUp(miopen::deref(handle), problems);
+
+        if(numProblems != nullptr)
+            *numProblems = stats.problems;
+        if(numWarmedUp != nullptr)
+            *numWarmedUp = stats.warmed;
+    });
+}
+
 inline std::ostream& operator<<(std::ostream& stream, const miopenTensorArgument_t& tensor)
 {
     switch(tensor.id)
@@ -31,6 +31,7 @@
 #include <miopen/env.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/expanduser.hpp>
+#include <miopen/kernel_build_params.hpp>
 #include <miopen/miopen.h>
 #include <miopen/version.h>
 #if MIOPEN_ENABLE_SQLITE
@@ -41,11 +42,14 @@
 #include <miopen/db_path.hpp>
 #include <miopen/target_properties.hpp>
 #include <miopen/filesystem.hpp>
+#include <algorithm>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DISABLE_CACHE)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_CUSTOM_CACHE_DIR)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_USER_KERNEL_CACHE_LIMIT_MB)
 
 namespace miopen {
 
@@ -125,25 +129,188 @@ bool IsCacheDisabled()
 }
 
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
-using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
-KDb GetDb(const TargetProperties& target, size_t num_cu)
+fs::path GetSystemKernelDbPath(const TargetProperties& target, size_t num_cu)
 {
-    static const auto user_dir = ComputeUserCachePath();
-    static const auto sys_dir  = ComputeSysCachePath();
-    fs::path user_path         = user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
-    fs::path sys_path          = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
-    if(user_dir.empty())
-        user_path = user_dir;
+    static const auto sys_dir = ComputeSysCachePath();
+    fs::path sys_path         = sys_dir / (Handle::GetDbBasename(target, num_cu) + ".kdb");
     if(!fs::exists(sys_path))
         sys_path = sys_dir / (target.DbId() + ".kdb");
 #if !MIOPEN_EMBED_DB
     if(!fs::exists(sys_path))
         sys_path = fs::path{};
 #endif
+    return sys_path;
+}
+
+static fs::path GetUserKernelDbPath(const TargetProperties& target, size_t num_cu)
+{
+    static const auto user_dir = ComputeUserCachePath();
+    if(user_dir.empty())
+        return user_dir;
+    return user_dir / (Handle::GetDbBasename(target, num_cu) + ".ukdb");
+}
+
+using KDb = DbTimer<MultiFileDb<KernDb, KernDb, false>>;
+KDb GetDb(const TargetProperties& target, size_t num_cu)
+{
+    const auto user_path = GetUserKernelDbPath(target, num_cu);
+    const auto sys_path  = GetSystemKernelDbPath(target, num_cu);
     return {DbKinds::KernelDb, sys_path.string(), user_path.string()};
 }
 #endif
 
+namespace {
+
+struct CacheFile
+{
+    fs::path path;
+    fs::file_time_type last_access;
+    std::size_t size;
+};
+
+/// The kernels of the cache layout with a file per kernel, the least recently used first.
+std::vector<CacheFile> ListCacheFiles(const fs::path& dir)
+{
+    auto files = std::vector<CacheFile>{};
+    for(auto it = fs::recursive_directory_iterator{dir}; it != fs::recursive_directory_iterator{};
+        ++it)
+    {
+        const auto& path = it->path();
+        if(path.extension() != ".o" || !fs::is_regular_file(path))
+            continue;
+        files.push_back({path, fs::last_write_time(path), fs::file_size(path)});
+    }
+    std::sort(files.begin(), files.end(), [](const auto& left, const auto& right) {
+        return left.last_access < right.last_access;
+    });
+    return files;
+}
+
+KernelCacheUsage GetUsage(const std::vector<CacheFile>& files)
+{
+    auto usage    = KernelCacheUsage{};
+    usage.kernels = files.size();
+    for(const auto& file : files)
+        usage.bytes += file.size;
+    return usage;
+}
+
+#if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
+/// The last access of a cached file is its modification time, which is updated on loads with
+/// the same resolution as the one of the kernel dbs.
+void TouchCacheFile(const fs::path& path)
+{
+    constexpr auto resolution = std::chrono::hours{1};
+    const auto now            = fs::file_time_type::clock::now();
+    auto ec                   = std::error_code{};
+    const auto last_access    = fs::last_write_time(path, ec);
+    if(!ec && now - last_access >= resolution)
+        fs::last_write_time(path, now, ec);
+}
+#endif
+
+/// Keeps the user kernel cache under MIOPEN_USER_KERNEL_CACHE_LIMIT_MB after a store. It is
+/// trimmed 10% below the limit, so that the following stores do not trim it again at once.
+void TrimAfterStore(const fs::path& path)
+{
+    const auto limit = Value(ENV(MIOPEN_USER_KERNEL_CACHE_LIMIT_MB)) * 1024 * 1024;
+    if(limit == 0 || path.empty())
+        return;
+
+    try
+    {
+        const auto usage = GetKernelCacheUsage(path);
+        if(usage.bytes <= limit)
+            return;
+
+        const auto trimmed = TrimKernelCache(path, limit / 10 * 9);
+        MIOPEN_LOG_I("Trimmed the kernel cache " << path << " from " << usage.kernels
+                                                 << " kernels, " << usage.bytes << " bytes to "
+                                                 << trimmed.kernels << " kernels, "
+                                                 << trimmed.bytes << " bytes");
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to trim the kernel cache " << path << ": " << ex.what());
+    }
+}
+
+} // namespace
+
+KernelCacheUsage GetKernelCacheUsage(const fs::path& path)
+{
+    if(!fs::exists(path))
+        MIOPEN_THROW(miopenStatusInvalidValue, "No kernel cache at " + path.string());
+    if(fs::is_directory(path))
+        return GetUsage(ListCacheFiles(path));
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    return KernDb{DbKinds::KernelDb, path.string(), false}.GetUsage();
+#else
+    MIOPEN_THROW(miopenStatusNotImplemented, "Kernel dbs are not supported by this build");
+#endif
+}
+
+KernelCacheUsage TrimKernelCache(const fs::path& path,
+                                 std::size_t max_bytes,
+                                 std::chrono::system_clock::time_point unused_since,
+                                 bool compact)
+{
+    if(!fs::exists(path))
+        MIOPEN_THROW(miopenStatusInvalidValue, "No kernel cache at " + path.string());
+
+    if(fs::is_directory(path))
+    {
+        // The clock of the file times may differ from the system one.
+        auto file_cutoff = fs::file_time_type::min();
+        if(unused_since != std::chrono::system_clock::time_point{})
+        {
+            const auto age = std::chrono::system_clock::now() - unused_since;
+            file_cutoff    = fs::file_time_type::clock::now() -
+                          std::chrono::duration_cast<fs::file_time_type::duration>(age);
+        }
+
+        const auto files = ListCacheFiles(path);
+        auto usage       = GetUsage(files);
+        for(const auto& file : files)
+        {
+            if(usage.bytes <= max_bytes && file.last_access >= file_cutoff)
+                break;
+            auto ec = std::error_code{};
+            if(!fs::remove(file.path, ec))
+                continue; // Removed by another process.
+            usage.bytes -= file.size;
+            --usage.kernels;
+            fs::remove(file.path.parent_path(), ec); // Only if empty.
+        }
+        return usage;
+    }
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    const auto cutoff = std::chrono::duration_cast<std::chrono::seconds>(
+        unused_since.time_since_epoch());
+    return KernDb{DbKinds::KernelDb, path.string(), false}.Trim(max_bytes, cutoff.count(), compact);
+#else
+    (void)compact;
+    MIOPEN_THROW(miopenStatusNotImplemented, "Kernel dbs are not supported by this build");
+#endif
+}
+
+KernelCacheUsage MergeKernelDb(const fs::path& src, const fs::path& dst)
+{
+    if(!fs::is_regular_file(src))
+        MIOPEN_THROW(miopenStatusInvalidValue, "No kernel db at " + src.string());
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    auto db          = KernDb{DbKinds::KernelDb, dst.string(), false};
+    const auto usage = db.Merge(src.string());
+    if(dst.extension() == ".kdb")
+        db.PrepareForInstall();
+    return usage;
+#else
+    (void)dst;
+    MIOPEN_THROW(miopenStatusNotImplemented, "Kernel dbs are not supported by this build");
+#endif
+}
+
 fs::path GetCacheFile(const std::string& device, const std::string& name, const std::string& args)
 {
     const std::string filename = name + ".o";
@@ -162,10 +329,16 @@ std::string LoadBinary(const TargetProperties& target,
     auto db = GetDb(target, num_cu);
 
     const std::string filename = name + ".o";
-    const KernelConfig cfg{filename, args, ""};
+    const auto canonical_args  = KernelBuildParameters::Canonicalize(args);
+
+    MIOPEN_LOG_I2("Loading binary for: " << filename << "; args: " << canonical_args);
+    auto record = db.FindRecord(KernelConfig{filename, canonical_args, ""});
+    if(!record && canonical_args != args)
+    {
+        // The entries stored before the keys were canonical, e.g. in the installed kernel dbs.
+        record = db.FindRecord(KernelConfig{filename, args, ""});
+    }
 
-    MIOPEN_LOG_I2("Loading binary for: " << filename << "; args: " << args);
-    auto record = db.FindRecord(cfg);
     if(record)
     {
         MIOPEN_LOG_I2("Successfully loaded binary for: " << filename << "; args: " << args);
@@ -190,10 +363,11 @@ void SaveBinary(const std::string& hsaco,
     auto db = GetDb(target, num_cu);
 
     const std::string filename = name + ".o";
-    KernelConfig cfg{filename, args, hsaco};
+    KernelConfig cfg{filename, KernelBuildParameters::Canonicalize(args), hsaco};
 
-    MIOPEN_LOG_I2("Saving binary for: " << filename << "; args: " << args);
+    MIOPEN_LOG_I2("Saving binary for: " << filename << "; args: " << cfg.kernel_args);
     db.StoreRecord(cfg);
+    TrimAfterStore(GetUserKernelDbPath(target, num_cu));
 }
 #else
 fs::path LoadBinary(const TargetProperties& target,
@@ -205,9 +379,17 @@ fs::path LoadBinary(const TargetProperties& target,
         return {};
 
     (void)num_cu;
-    auto f = GetCacheFile(target.DbId(), name, args);
+    const auto canonical_args = KernelBuildParameters::Canonicalize(args);
+    auto f                    = GetCacheFile(target.DbId(), name, canonical_args);
+    if(!fs::exists(f) && canonical_args != args)
+    {
+        // The files stored before the keys were canonical.
+        f = GetCacheFile(target.DbId(), name, args);
+    }
+
     if(fs::exists(f))
     {
+        TouchCacheFile(f);
         return f.string();
     }
     else
@@ -227,9 +409,10 @@ void SaveBinary(const fs::path& binary_path,
     }
     else
     {
-        auto p = GetCacheFile(target.DbId(), name, args);
+        auto p = GetCacheFile(target.DbId(), name, KernelBuildParameters::Canonicalize(args));
         fs::create_directories(p.parent_path());
         fs::rename(binary_path, p);
+        TrimAfterStore(GetCachePath(false));
     }
 }
 #endif
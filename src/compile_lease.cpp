@@ -0,0 +1,190 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/binary_cache.hpp>
+#include <miopen/compile_lease.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/env.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/md5.hpp>
+#include <miopen/target_properties.hpp>
+
+#include <boost/interprocess/sync/file_lock.hpp>
+
+#include <fstream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <system_error>
+
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_COMPILE_LEASE_TIMEOUT, uint64_t, 600)
+
+namespace miopen {
+
+/// The state of a lease shared by the threads of a process. POSIX file locks are owned by
+/// processes, so the threads take turns on the mutex before they try the file lock.
+/// A slot lives only while some lease of the process refers to it, so the file descriptors
+/// are not kept open for every kernel ever compiled.
+struct CompileLeaseSlot
+{
+    std::string path;
+    std::mutex mutex;
+    std::unique_ptr<boost::interprocess::file_lock> flock;
+    std::size_t users = 0;
+};
+
+static std::mutex& SlotsMutex()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    return mutex;
+}
+
+static std::map<std::string, CompileLeaseSlot>& Slots()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::map<std::string, CompileLeaseSlot> slots;
+    return slots;
+}
+
+static CompileLeaseSlot& AcquireSlot(const fs::path& lock_path)
+{
+    std::lock_guard<std::mutex> lock(SlotsMutex());
+    auto& slot = Slots()[lock_path.string()];
+    if(slot.users++ == 0)
+        slot.path = lock_path.string();
+    return slot;
+}
+
+static fs::path GetLeasePath(const TargetProperties& target,
+                             const std::string& name,
+                             const std::string& args)
+{
+    if(IsCacheDisabled() || Value(ENV(MIOPEN_COMPILE_LEASE_TIMEOUT)) == 0)
+        return {};
+    const auto cache_path = GetCachePath(false);
+    if(cache_path.empty())
+        return {};
+    const auto key = target.DbId() + ":" + name + ":" + KernelBuildParameters::Canonicalize(args);
+    return cache_path / "leases" / (md5(key) + ".lock");
+}
+
+CompileLease::CompileLease(const TargetProperties& target,
+                           const std::string& name,
+                           const std::string& args)
+    : CompileLease(GetLeasePath(target, name, args),
+                   std::chrono::seconds(Value(ENV(MIOPEN_COMPILE_LEASE_TIMEOUT))))
+{
+}
+
+CompileLease::CompileLease(fs::path lock_path_, std::chrono::seconds timeout_)
+    : lock_path(std::move(lock_path_)), timeout(timeout_)
+{
+}
+
+CompileLease::~CompileLease()
+{
+    if(slot == nullptr)
+        return;
+
+    std::lock_guard<std::mutex> lock(SlotsMutex());
+
+    if(held)
+    {
+        // Nobody else in the process is waiting for the lease, so the lock file is removed
+        // while it is still locked. Other processes waiting on the removed file find the
+        // binary once they take it, and the newcomers create a new file.
+        if(slot->users == 1)
+        {
+            auto ec = std::error_code{};
+            fs::remove(slot->path, ec);
+        }
+
+        try
+        {
+            slot->flock->unlock();
+        }
+        catch(const boost::interprocess::interprocess_exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to release the compile lease " << lock_path << ": " << ex.what());
+        }
+        thread_lock.unlock();
+    }
+
+    if(--slot->users == 0)
+        Slots().erase(std::string{slot->path});
+}
+
+bool CompileLease::TryAcquire()
+{
+    if(held)
+        return true;
+
+    if(slot == nullptr)
+        slot = &AcquireSlot(lock_path);
+
+    auto lock = std::unique_lock<std::mutex>{slot->mutex, std::try_to_lock};
+    if(!lock)
+        return false;
+
+    try
+    {
+        if(!slot->flock)
+        {
+            fs::create_directories(lock_path.parent_path());
+            if(!fs::exists(lock_path) && !std::ofstream{lock_path})
+                MIOPEN_THROW("Error creating the lease file " + lock_path.string());
+            slot->flock =
+                std::make_unique<boost::interprocess::file_lock>(lock_path.string().c_str());
+        }
+
+        if(!slot->flock->try_lock())
+            return false;
+
+        // The previous owner has removed the file after we have opened it.
+        if(!fs::exists(lock_path))
+        {
+            slot->flock->unlock();
+            slot->flock.reset();
+            return false;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        // Compile without the lease rather than wait for a lock that cannot be taken.
+        MIOPEN_LOG_W("Unable to take the compile lease " << lock_path << ": " << ex.what());
+        lock_path.clear();
+        return true;
+    }
+
+    MIOPEN_LOG_I2("Took the compile lease " << lock_path);
+    thread_lock = std::move(lock);
+    held        = true;
+    return true;
+}
+
+} // namespace miopen
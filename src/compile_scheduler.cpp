@@ -0,0 +1,291 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/compile_scheduler.hpp>
+
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/stringutils.hpp>
+#include <miopen/thread_pool.hpp>
+#include <miopen/timer.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <unordered_map>
+
+namespace miopen {
+
+namespace {
+
+struct CompileTimes
+{
+    std::mutex mutex;
+    std::unordered_map<std::string, float> by_file;
+};
+
+CompileTimes& GetCompileTimes()
+{
+    static CompileTimes times;
+    return times;
+}
+
+} // namespace
+
+void RecordCompileTime(const std::string& program_name, float ms)
+{
+    auto& times = GetCompileTimes();
+    const std::lock_guard<std::mutex> lock{times.mutex};
+    times.by_file[program_name] = ms;
+}
+
+float EstimateCompileTime(const std::string& program_name)
+{
+    {
+        auto& times = GetCompileTimes();
+        const std::lock_guard<std::mutex> lock{times.mutex};
+        const auto time = times.by_file.find(program_name);
+        if(time != times.by_file.end())
+            return time->second;
+    }
+
+    // Typical build times, ms, only their order matters.
+    if(EndsWith(program_name, ".mlir"))
+        return 4000;
+    if(EndsWith(program_name, ".cpp"))
+        return 3000;
+    if(EndsWith(program_name, ".cl"))
+        return 1000;
+    return 300; // Assembly
+}
+
+namespace solver {
+
+struct CompileJob
+{
+    std::string key;
+    KernelInfo kernel;
+    float estimate = 0;
+    /// The job of another scheduler building the same program, if any.
+    std::shared_ptr<CompileJob> leader;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    bool done = false;
+    std::exception_ptr error;
+
+    void Finish(std::exception_ptr error_)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            done  = true;
+            error = error_;
+        }
+        finished.notify_all();
+    }
+
+    bool IsFinished()
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        return done;
+    }
+
+    void WaitFinished()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        finished.wait(lock, [&]() { return done; });
+    }
+};
+
+namespace {
+
+/// The programs being built in the process.
+class InFlightJobs
+{
+public:
+    static InFlightJobs& Get()
+    {
+        static InFlightJobs in_flight;
+        return in_flight;
+    }
+
+    /// Returns the job building the same program, or registers this one and returns nullptr.
+    std::shared_ptr<CompileJob> Lead(const std::shared_ptr<CompileJob>& job)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        auto& slot        = jobs[job->key];
+        const auto leader = slot.lock();
+        if(leader != nullptr)
+            return leader;
+        slot = job;
+        return nullptr;
+    }
+
+    void Release(const std::shared_ptr<CompileJob>& job)
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        const auto slot = jobs.find(job->key);
+        if(slot != jobs.end() && slot->second.lock() == job)
+            jobs.erase(slot);
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_map<std::string, std::weak_ptr<CompileJob>> jobs;
+};
+
+} // namespace
+
+CompileScheduler::CompileScheduler(const Handle& h, std::size_t threads_)
+    : CompileScheduler(h.GetTargetProperties().DbId(), threads_, [&h](const KernelInfo& kernel) {
+          // The program may be built by another scheduler for the same handle.
+          if(h.HasProgram(kernel.kernel_file, kernel.comp_options))
+              return;
+          auto program = h.LoadProgram(kernel.kernel_file, kernel.comp_options, "");
+          h.AddProgram(program, kernel.kernel_file, kernel.comp_options);
+      })
+{
+}
+
+CompileScheduler::CompileScheduler(std::string target_, std::size_t threads_, Build build_)
+    : target(std::move(target_)), threads(threads_), build(build_)
+{
+    // As par_for(), the number of threads is limited by the CPU cores.
+    const auto cores = std::max(std::thread::hardware_concurrency(), 1u);
+    threads          = std::clamp<std::size_t>(threads, 1, cores);
+}
+
+CompileScheduler::~CompileScheduler()
+{
+    for(auto& runner : runners)
+        runner.join();
+}
+
+std::string CompileScheduler::MakeKey(const KernelInfo& kernel) const
+{
+    return target + '\n' + kernel.kernel_file + '\n' +
+           KernelBuildParameters::Canonicalize(kernel.comp_options);
+}
+
+void CompileScheduler::Start(const std::vector<KernelInfo>& kernels)
+{
+    auto batch = std::vector<std::shared_ptr<CompileJob>>{};
+    for(const auto& kernel : kernels)
+    {
+        auto key = MakeKey(kernel);
+        if(jobs.find(key) != jobs.end())
+            continue;
+
+        auto job    = std::make_shared<CompileJob>();
+        job->key    = std::move(key);
+        job->kernel = kernel;
+        job->leader = InFlightJobs::Get().Lead(job);
+        if(job->leader == nullptr)
+        {
+            job->estimate = EstimateCompileTime(kernel.kernel_file);
+            batch.push_back(job);
+        }
+        jobs.emplace(job->key, job);
+    }
+
+    if(batch.empty())
+        return;
+
+    // The pool takes the jobs in order, so the longest ones start first.
+    std::stable_sort(batch.begin(), batch.end(), [](const auto& left, const auto& right) {
+        return left->estimate > right->estimate;
+    });
+    MIOPEN_LOG_I2("Building " << batch.size() << " programs for " << kernels.size()
+                              << " kernels");
+
+    runners.emplace_back([this, batch]() {
+        CompileTimer ct;
+        ThreadPool::Get().ParallelFor(batch.size(), threads, 1, [&](std::size_t i) {
+            const auto& job = batch[i];
+            auto error      = std::exception_ptr{};
+            try
+            {
+                build(job->kernel);
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_W("Build of " << job->kernel << " failed: " << ex.what());
+                error = std::current_exception();
+            }
+            catch(...)
+            {
+                error = std::current_exception();
+            }
+            InFlightJobs::Get().Release(job);
+            job->Finish(error);
+        });
+        ct.Log("PrecompileKernels");
+    });
+}
+
+void CompileScheduler::Wait(CompileJob& job)
+{
+    if(job.leader != nullptr && !job.IsFinished())
+    {
+        // The program is stored where the leader looks it up, so it is built here too, expected
+        // to be found in the kernel cache.
+        job.leader->WaitFinished();
+        auto error = std::exception_ptr{};
+        try
+        {
+            build(job.kernel);
+        }
+        catch(...)
+        {
+            error = std::current_exception();
+        }
+        job.Finish(error);
+    }
+
+    job.WaitFinished();
+    if(job.error)
+        std::rethrow_exception(job.error);
+}
+
+void CompileScheduler::Wait(const std::vector<KernelInfo>& kernels)
+{
+    for(const auto& kernel : kernels)
+    {
+        const auto job = jobs.find(MakeKey(kernel));
+        if(job != jobs.end())
+            Wait(*job->second);
+    }
+}
+
+void CompileScheduler::WaitAll()
+{
+    for(auto& job : jobs)
+        Wait(*job.second);
+}
+
+} // namespace solver
+} // namespace miopen
@@ -103,7 +103,64 @@ void ProblemDescription::HeuristicUpdateLayouts()
     // If we did not find consistent layout, leave them as-is
 }
 
+ProblemKey ProblemDescription::MakeKey() const
+{
+    const auto cast_type = [](std::optional<miopenDataType_t> type) -> std::uint64_t {
+        return type ? *type + 1 : 0;
+    };
+
+    constexpr std::uint64_t tag = 0x766e6f63; // "conv"
+    auto key                    = ProblemKey{tag};
+
+    key.Add(GetSpatialDims())
+        .Add(GetInBatchSize())
+        .Add(GetInChannels())
+        .Add(GetInDepth())
+        .Add(GetInHeight())
+        .Add(GetInWidth())
+        .Add(GetWeightsDepth())
+        .Add(GetWeightsHeight())
+        .Add(GetWeightsWidth())
+        .Add(GetOutChannels())
+        .Add(GetOutDepth())
+        .Add(GetOutHeight())
+        .Add(GetOutWidth())
+        .Add(GetPadD())
+        .Add(GetPadH())
+        .Add(GetPadW())
+        .Add(GetKernelStrideD())
+        .Add(GetKernelStrideH())
+        .Add(GetKernelStrideW())
+        .Add(GetDilationD())
+        .Add(GetDilationH())
+        .Add(GetDilationW())
+        .Add(GetGroupCount())
+        .Add(GetBias())
+        .Add(static_cast<std::uint64_t>(GetDirection()))
+        .Add(GetInDataType())
+        .Add(GetWeightsDataType())
+        .Add(GetOutDataType())
+        .Add(cast_type(GetInCastType()))
+        .Add(cast_type(GetWeightsCastType()))
+        .Add(cast_type(GetOutCastType()))
+        .Add(std::string_view{in_layout})
+        .Add(std::string_view{weights_layout})
+        .Add(std::string_view{out_layout});
+
+    return key;
+}
+
 void ProblemDescription::MakeNetworkConfig(std::string& conf_key) const
+{
+    conf_key = ProblemTextCache::Get(ProblemTextCache::Form::NetworkConfig)
+                   .GetOrBuild(MakeKey(), [&]() {
+                       auto text = std::string{};
+                       MakeNetworkConfigText(text);
+                       return text;
+                   });
+}
+
+void ProblemDescription::MakeNetworkConfigText(std::string& conf_key) const
 {
     std::ostringstream ss;
 
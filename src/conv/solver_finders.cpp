@@ -26,7 +26,9 @@
 
 #include <miopen/conv/solver_finders.hpp>
 
+#include <miopen/compile_scheduler.hpp>
 #include <miopen/conv_algo_name.hpp>
+#include <miopen/generic_search.hpp>
 #include <miopen/config.h>
 #include <miopen/mlo_internal.hpp>
 #include <miopen/perf_field.hpp>
@@ -217,7 +219,8 @@ static void EvaluateInvokers(Handle& handle,
                              const AlgorithmName& algorithm_name,
                              const NetworkConfig& network_config,
                              const AnyInvokeParams& invoke_ctx,
-                             DbRecord& record)
+                             DbRecord& record,
+                             solver::CompileScheduler& scheduler)
 {
     const auto& arch = miopen::GetStringEnv(ENV(MIOPEN_DEVICE_ARCH));
     if(!arch.empty())
@@ -250,9 +253,13 @@ static void EvaluateInvokers(Handle& handle,
         if(!sol.invoker_factory)
             MIOPEN_THROW("Invoker is not provided by solver " + sol.solver_id);
 
-        const auto invoker = handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
         try
         {
+            // The other kernels may be still building meanwhile. A solution whose kernels
+            // failed to build is skipped.
+            scheduler.Wait(sol.construction_params);
+            const auto invoker =
+                handle.PrepareInvoker(*sol.invoker_factory, sol.construction_params);
             invoker(handle, invoke_ctx);
             const auto elapsed = handle.GetKernelTime();
             record.SetValues(sol.solver_id, FindDbData{elapsed, sol.workspace_sz, algorithm_name});
@@ -306,7 +313,8 @@ void FindCore(const AnyInvokeParams& invoke_ctx,
                                   f->Find(ctx, problem, invoke_ctx, parameters, options));
         });
 
-    // Precompile
+    // Precompile in the background, the invokers are evaluated as their kernels are ready
+    auto scheduler = solver::CompileScheduler{handle, solver::GetTuningThreadsMax()};
     {
         auto all = std::vector<const miopen::solver::ConvSolution*>{};
         all.reserve(
@@ -315,7 +323,7 @@ void FindCore(const AnyInvokeParams& invoke_ctx,
             }));
         for(const auto& ss : solutions)
             AppendPointersToElements(ss.second, all);
-        PrecompileSolutions(handle, all);
+        PrecompileSolutions(handle, all, scheduler);
     }
 
     // Evaluate Invokers
@@ -325,7 +333,8 @@ void FindCore(const AnyInvokeParams& invoke_ctx,
     for(const auto& ss : solutions)
     {
         if(!ss.second.empty())
-            EvaluateInvokers(handle, ss.second, ss.first, network_config, invoke_ctx, record);
+            EvaluateInvokers(
+                handle, ss.second, ss.first, network_config, invoke_ctx, record, scheduler);
     }
 }
 
@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 #include <miopen/db.hpp>
+#include <miopen/db_file_index.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
@@ -40,9 +41,11 @@
 #include <cstdio>
 #include <fstream>
 #include <ios>
+#include <map>
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <system_error>
 #include <vector>
 
 namespace miopen {
@@ -51,6 +54,8 @@ PlainTextDb::PlainTextDb(DbKinds db_kind_, const std::string& filename_, bool is
     : db_kind(db_kind_),
       filename(filename_),
       lock_file(LockFile::Get(LockFilePath(filename_).c_str())),
+      index(DbFileIndex::Get(filename_)),
+      journal_index(DbFileIndex::Get(GetJournalPath(filename_), true)),
       warning_if_unreadable(is_system)
 {
     if(is_system)
@@ -83,6 +88,8 @@ PlainTextDb::PlainTextDb(DbKinds db_kind_, const std::string& filename_, bool is
 
 static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
 
+static bool IsJournalEnabled() { return IsEnabled(ENV(MIOPEN_DEBUG_USER_DB_JOURNAL)); }
+
 using exclusive_lock = std::unique_lock<LockFile>;
 using shared_lock    = std::shared_lock<LockFile>;
 
@@ -92,7 +99,9 @@ boost::optional<DbRecord> PlainTextDb::FindRecord(const std::string& key)
         return {};
     const auto lock = shared_lock(lock_file, GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
-    return FindRecordUnsafe(key, nullptr);
+    auto record = FindRecordUnsafe(key, nullptr);
+    DbStats::Get(db_kind).AddBytesRead(record);
+    return record;
 }
 
 bool PlainTextDb::StoreRecord(const DbRecord& record)
@@ -122,6 +131,16 @@ bool PlainTextDb::RemoveRecord(const std::string& key)
     return RemoveRecordUnsafe(key);
 }
 
+bool PlainTextDb::CommitBatch(const std::vector<DbChange>& changes)
+{
+    if(DisableUserDbFileIO)
+        return true;
+    const auto lock = exclusive_lock(lock_file, GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+    auto results = std::vector<DbRecord>{};
+    return CommitBatchUnsafe(changes, results);
+}
+
 bool PlainTextDb::Remove(const std::string& key, const std::string& id)
 {
     if(DisableUserDbFileIO)
@@ -148,9 +167,39 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
 
     MIOPEN_LOG_I2("Looking for key " << key << " in file " << filename);
 
-    std::ifstream file(filename, std::ios::binary);
+    const auto parse = [&](const DbTextIndex::Entry& entry, const std::string& path) {
+        MIOPEN_LOG_I2("Key match: " << entry.key);
+        MIOPEN_LOG_I2("Contents found: " << entry.contents);
+
+        DbRecord record(key);
+        const bool is_parse_ok = record.ParseContents(std::string{entry.contents});
+
+        if(!is_parse_ok)
+        {
+            MIOPEN_LOG_E("Error parsing payload under the key: " << entry.key << " form file "
+                                                                 << path << "#" << entry.line);
+            MIOPEN_LOG_E("Contents: " << entry.contents);
+        }
+        return record;
+    };
+
+    // The journal is newer than the db file. Its records have no position in the db file,
+    // which is fine, as in-place updates compact the journal first.
+    if(const auto journal = journal_index.Acquire())
+    {
+        const auto entry = journal->Find(key);
+
+        if(entry != nullptr)
+        {
+            if(entry->contents.empty())
+                return boost::none; // Removed
+            return parse(*entry, GetJournalPath(filename));
+        }
+    }
+
+    const auto snapshot = index.Acquire();
 
-    if(!file)
+    if(!snapshot)
     {
         const auto log_level = IsWarningIfUnreadable() && !MIOPEN_DISABLE_SYSDB
                                    ? LoggingLevel::Warning
@@ -159,62 +208,23 @@ boost::optional<DbRecord> PlainTextDb::FindRecordUnsafe(const std::string& key,
         return boost::none;
     }
 
-    int n_line = 0;
-    while(true)
-    {
-        std::string line;
-        const auto line_begin = file.tellg();
-        if(!std::getline(file, line))
-            break;
-        ++n_line;
-        const auto next_line_begin = file.tellg();
-
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
-        if(!is_key)
-        {
-            if(!line.empty()) // Do not blame empty lines.
-            {
-                MIOPEN_LOG_E("Ill-formed record: key not found: " << filename << "#" << n_line);
-            }
-            continue;
-        }
-        const auto current_key = line.substr(0, key_size);
+    const auto entry = snapshot->Find(key);
 
-        if(current_key != key)
-        {
-            continue;
-        }
-        MIOPEN_LOG_I2("Key match: " << current_key);
-        const auto contents = line.substr(key_size + 1);
-
-        if(contents.empty())
-        {
-            MIOPEN_LOG_E("None contents under the key: " << current_key << " form file " << filename
-                                                         << "#" << n_line);
-            continue;
-        }
-        MIOPEN_LOG_I2("Contents found: " << contents);
+    if(entry == nullptr)
+    {
+        // Record was not found
+        return boost::none;
+    }
 
-        DbRecord record(key);
-        const bool is_parse_ok = record.ParseContents(contents);
+    auto record = parse(*entry, filename);
 
-        if(!is_parse_ok)
-        {
-            MIOPEN_LOG_E("Error parsing payload under the key: " << current_key << " form file "
-                                                                 << filename << "#" << n_line);
-            MIOPEN_LOG_E("Contents: " << contents);
-        }
-        // A record with matching key have been found.
-        if(pos != nullptr)
-        {
-            pos->begin = line_begin;
-            pos->end   = next_line_begin;
-        }
-        return record;
+    // A record with matching key have been found.
+    if(pos != nullptr)
+    {
+        pos->begin = entry->begin;
+        pos->end   = entry->end;
     }
-    // Record was not found
-    return boost::none;
+    return record;
 }
 
 static void Copy(std::istream& from, std::ostream& to, std::streamoff count)
@@ -238,6 +248,13 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
 {
     assert(pos);
 
+    // The first records of a new db go straight to the db file, there is nothing to rewrite.
+    if(IsJournalEnabled() && fs::exists(filename))
+        return AppendToJournalUnsafe({&record});
+
+    // The file is about to change, and the mapping of it shall not prevent that.
+    index.Invalidate();
+
     if(pos->begin < 0 || pos->end < 0)
     {
         {
@@ -293,8 +310,218 @@ bool PlainTextDb::FlushUnsafe(const DbRecord& record, const RecordPositions* pos
     return true;
 }
 
+bool PlainTextDb::FlushBatchUnsafe(const std::vector<DbRecord>& records,
+                                   const std::vector<RecordPositions>& positions)
+{
+    assert(records.size() == positions.size());
+
+    if(IsJournalEnabled() && fs::exists(filename))
+    {
+        auto pointers = std::vector<const DbRecord*>{};
+        pointers.reserve(records.size());
+        for(const auto& record : records)
+            pointers.push_back(&record);
+        return AppendToJournalUnsafe(pointers);
+    }
+
+    // The records already stored in the file are replaced in one pass over it,
+    // and the new ones are appended to its end.
+    auto replaced = std::vector<std::size_t>{};
+    for(auto i = 0u; i < records.size(); ++i)
+    {
+        if(positions[i].begin >= 0 && positions[i].end >= 0)
+            replaced.push_back(i);
+    }
+
+    std::sort(replaced.begin(), replaced.end(), [&](auto left, auto right) {
+        return positions[left].begin < positions[right].begin;
+    });
+
+    const auto write_new = [&](std::ostream& to) {
+        for(auto i = 0u; i < records.size(); ++i)
+        {
+            if(positions[i].begin < 0 || positions[i].end < 0)
+                records[i].WriteContents(to);
+        }
+    };
+
+    index.Invalidate();
+
+    if(replaced.empty())
+    {
+        {
+            std::ofstream file(filename, std::ios::app | std::ios::binary);
+
+            if(!file)
+            {
+                MIOPEN_LOG_E("File is unwritable: " << filename);
+                return false;
+            }
+
+            write_new(file);
+        }
+
+        fs::permissions(filename, fs::perms::all);
+        return true;
+    }
+
+    std::ifstream from(filename, std::ios::ate | std::ios::binary);
+
+    if(!from)
+    {
+        MIOPEN_LOG_E("File is unreadable: " << filename);
+        return false;
+    }
+
+    const auto temp_name = filename + ".temp";
+    std::ofstream to(temp_name, std::ios::binary);
+
+    if(!to)
+    {
+        MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+        return false;
+    }
+
+    const auto from_size = static_cast<std::streamoff>(from.tellg());
+    auto copied          = std::streamoff{0};
+    from.seekg(std::ios::beg);
+
+    for(const auto i : replaced)
+    {
+        Copy(from, to, positions[i].begin - copied);
+        records[i].WriteContents(to);
+        from.seekg(positions[i].end);
+        copied = positions[i].end;
+    }
+
+    Copy(from, to, from_size - copied);
+    write_new(to);
+
+    from.close();
+    to.close();
+
+    fs::remove(filename);
+    fs::rename(temp_name, filename);
+    fs::permissions(filename, fs::perms::all);
+    return true;
+}
+
+bool PlainTextDb::AppendToJournalUnsafe(const std::vector<const DbRecord*>& records)
+{
+    const auto journal_path = GetJournalPath(filename);
+
+    // Only the journal is about to change, the index of the db file stays valid. The journal
+    // index is extended by the appended records, instead of parsing the journal again.
+    const auto journal = journal_index.Acquire();
+
+    {
+        std::ofstream file(journal_path, std::ios::app | std::ios::binary);
+
+        if(!file)
+        {
+            MIOPEN_LOG_E("File is unwritable: " << journal_path);
+            return false;
+        }
+
+        for(const auto record : records)
+        {
+            if(record->GetSize() == 0)
+                file << record->key << '=' << std::endl;
+            else
+                record->WriteContents(file);
+        }
+    }
+
+    fs::permissions(journal_path, fs::perms::all);
+    journal_index.Extend(journal);
+
+    // The limit is relative to the db size, so that the amortized cost of the compaction
+    // stays constant per appended record.
+    auto ec                 = std::error_code{};
+    const auto journal_size = fs::file_size(journal_path, ec);
+    const auto db_size      = ec ? 0 : fs::file_size(filename, ec);
+    const auto limit =
+        std::max<std::uintmax_t>(Value(ENV(MIOPEN_DEBUG_USER_DB_JOURNAL_LIMIT)), db_size / 4);
+
+    if(ec || journal_size <= limit)
+        return true;
+    return CompactJournalUnsafe();
+}
+
+bool PlainTextDb::CompactJournalUnsafe()
+{
+    const auto journal_path = GetJournalPath(filename);
+    const auto temp_name    = filename + ".temp";
+
+    {
+        const auto journal = journal_index.Acquire();
+
+        if(!journal)
+            return true; // Nothing to compact.
+
+        const auto db = index.Acquire();
+        std::ofstream to(temp_name, std::ios::binary);
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+
+        // Both indexes are sorted by key, so they are merged in one pass. Journal records
+        // override the records of the db file and tombstones drop them.
+        const auto no_entries = std::vector<DbTextIndex::Entry>{};
+        const auto& changes   = journal->GetEntries();
+        const auto& records   = db ? db->GetEntries() : no_entries;
+        auto change           = changes.begin();
+        auto record           = records.begin();
+
+        const auto write = [&](const DbTextIndex::Entry& entry) {
+            if(!entry.contents.empty())
+                to << entry.key << '=' << entry.contents << '\n';
+        };
+
+        while(change != changes.end() || record != records.end())
+        {
+            if(record == records.end() || (change != changes.end() && change->key <= record->key))
+            {
+                if(record != records.end() && change->key == record->key)
+                    ++record;
+                write(*change++);
+            }
+            else
+            {
+                write(*record++);
+            }
+        }
+
+        to.close();
+
+        if(!to)
+        {
+            MIOPEN_LOG_E("Temp file is unwritable: " << temp_name);
+            return false;
+        }
+    }
+
+    index.Invalidate();
+    journal_index.Invalidate();
+
+    fs::remove(filename);
+    fs::rename(temp_name, filename);
+    fs::permissions(filename, fs::perms::all);
+    // If the process dies before that, the journal is merged once again. It is idempotent.
+    fs::remove(journal_path);
+
+    MIOPEN_LOG_I2("Journal has been compacted into " << filename);
+    return true;
+}
+
 bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 {
+    if(!IsJournalEnabled() && !CompactJournalUnsafe())
+        return false;
+
     MIOPEN_LOG_I2("Storing record: " << record.key);
     RecordPositions pos;
     FindRecordUnsafe(record.key, &pos);
@@ -303,6 +530,9 @@ bool PlainTextDb::StoreRecordUnsafe(const DbRecord& record)
 
 bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
 {
+    if(!IsJournalEnabled() && !CompactJournalUnsafe())
+        return false;
+
     RecordPositions pos;
     const auto old_record = FindRecordUnsafe(record.key, &pos);
     DbRecord new_record(record);
@@ -321,10 +551,59 @@ bool PlainTextDb::UpdateRecordUnsafe(DbRecord& record)
     return result;
 }
 
+bool PlainTextDb::CommitBatchUnsafe(const std::vector<DbChange>& changes,
+                                    std::vector<DbRecord>& results)
+{
+    if(!IsJournalEnabled() && !CompactJournalUnsafe())
+        return false;
+
+    MIOPEN_LOG_I2("Committing a batch of " << changes.size() << " records to " << filename);
+
+    auto positions = std::vector<RecordPositions>{};
+    auto indices   = std::map<std::string, std::size_t>{};
+    results.clear();
+
+    // Changes of the same key are applied on top of each other.
+    for(const auto& change : changes)
+    {
+        const auto found = indices.find(change.record.key);
+
+        if(found == indices.end())
+        {
+            RecordPositions pos;
+            const auto old_record = FindRecordUnsafe(change.record.key, &pos);
+            indices.emplace(change.record.key, results.size());
+            results.push_back(change.record);
+            positions.push_back(pos);
+            if(change.merge && old_record)
+                results.back().Merge(*old_record);
+            continue;
+        }
+
+        auto& result = results[found->second];
+
+        if(change.merge)
+        {
+            auto merged = change.record;
+            merged.Merge(result);
+            result = std::move(merged);
+        }
+        else
+        {
+            result = change.record;
+        }
+    }
+
+    return FlushBatchUnsafe(results, positions);
+}
+
 bool PlainTextDb::RemoveRecordUnsafe(const std::string& key)
 {
     // Create empty record with same key and replace original with that
     // This will remove record
+    if(!IsJournalEnabled() && !CompactJournalUnsafe())
+        return false;
+
     MIOPEN_LOG_I("Removing record: " << key);
     RecordPositions pos;
     FindRecordUnsafe(key, &pos);
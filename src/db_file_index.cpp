@@ -0,0 +1,268 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_file_index.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <system_error>
+
+namespace miopen {
+
+DbTextIndex::DbTextIndex(std::string_view text, const std::string& path, Kind kind)
+{
+    Parse(text, 0, path, kind);
+    Sort(kind == Kind::Journal);
+    entries.shrink_to_fit();
+}
+
+DbTextIndex::DbTextIndex(const DbTextIndex& base,
+                         std::string_view text,
+                         std::size_t from,
+                         const std::string& path)
+    : lines(base.lines)
+{
+    Parse(text, from, path, Kind::Journal);
+    Sort(true);
+
+    // Both are sorted by key, so they are merged in one pass. The appended records override
+    // the base ones, which are moved onto the new text.
+    auto merged = std::vector<Entry>{};
+    merged.reserve(base.entries.size() + entries.size());
+    auto appended = entries.begin();
+
+    for(const auto& entry : base.entries)
+    {
+        while(appended != entries.end() && appended->key < entry.key)
+            merged.push_back(*appended++);
+        if(appended != entries.end() && appended->key == entry.key)
+            continue;
+
+        const auto begin = static_cast<std::size_t>(entry.begin);
+        merged.push_back({text.substr(begin, entry.key.size()),
+                          text.substr(begin + entry.key.size() + 1, entry.contents.size()),
+                          entry.begin,
+                          entry.end,
+                          entry.line});
+    }
+
+    merged.insert(merged.end(), appended, entries.end());
+    entries = std::move(merged);
+}
+
+void DbTextIndex::Parse(std::string_view text, std::size_t from, const std::string& path, Kind kind)
+{
+    for(std::size_t line_begin = from; line_begin < text.size();)
+    {
+        const auto n_line        = ++lines;
+        const auto eol           = text.find('\n', line_begin);
+        const auto line_end      = eol == std::string_view::npos ? text.size() : eol;
+        const auto next_line     = eol == std::string_view::npos ? text.size() : eol + 1;
+        const auto line          = text.substr(line_begin, line_end - line_begin);
+        const auto line_position = static_cast<std::streamoff>(line_begin);
+        line_begin               = next_line;
+
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string_view::npos && key_size != 0);
+
+        if(!is_key)
+        {
+            if(!line.empty()) // Do not blame empty lines.
+                MIOPEN_LOG_E("Ill-formed record: key not found: " << path << "#" << n_line);
+            continue;
+        }
+
+        const auto key      = line.substr(0, key_size);
+        const auto contents = line.substr(key_size + 1);
+
+        if(contents.empty() && kind == Kind::UserDb)
+        {
+            MIOPEN_LOG_E("None contents under the key: " << key << " form file " << path << "#"
+                                                         << n_line);
+            continue;
+        }
+
+        entries.push_back(
+            {key, contents, line_position, static_cast<std::streamoff>(next_line), n_line});
+    }
+}
+
+void DbTextIndex::Sort(bool is_journal)
+{
+    // Linear scan used to return the first record with a matching key, keep it that way.
+    // Journal records override the earlier ones, so it is done in the reverse order for them.
+    if(is_journal)
+        std::reverse(entries.begin(), entries.end());
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& left, const Entry& right) {
+        return left.key < right.key;
+    });
+    entries.erase(std::unique(entries.begin(),
+                              entries.end(),
+                              [](const Entry& left, const Entry& right) {
+                                  return left.key == right.key;
+                              }),
+                  entries.end());
+}
+
+const DbTextIndex::Entry* DbTextIndex::Find(std::string_view key) const
+{
+    const auto it = std::lower_bound(
+        entries.begin(), entries.end(), key, [](const Entry& entry, std::string_view value) {
+            return entry.key < value;
+        });
+
+    if(it == entries.end() || it->key != key)
+        return nullptr;
+    return &*it;
+}
+
+DbFileIndex& DbFileIndex::Get(const std::string& path, bool is_journal)
+{
+    // The registry is never destroyed because the background prefetch thread may still
+    // be using it while the statics are destroyed at exit.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& mutex = *new std::mutex{};
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // Indexes are never destroyed, same as LockFile objects. There is one per db file.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& instances = *new std::map<std::string, std::unique_ptr<DbFileIndex>>{};
+    auto& instance        = instances[path];
+
+    if(!instance)
+        instance = std::make_unique<DbFileIndex>(path, is_journal, PassKey{});
+    return *instance;
+}
+
+std::shared_ptr<const DbFileIndex::Snapshot> DbFileIndex::Acquire()
+{
+    auto ec               = std::error_code{};
+    const auto file_size  = fs::file_size(path, ec);
+    const auto write_time = ec ? fs::file_time_type{} : fs::last_write_time(path, ec);
+
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    if(ec)
+    {
+        snapshot = nullptr;
+        return nullptr;
+    }
+
+    if(snapshot == nullptr || snapshot->file_size != file_size ||
+       snapshot->write_time != write_time)
+    {
+        snapshot = Build(file_size, write_time, nullptr);
+    }
+    else if(IsRacy(write_time))
+    {
+        snapshot = Build(file_size, write_time, snapshot);
+    }
+
+    return snapshot;
+}
+
+void DbFileIndex::Invalidate()
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    snapshot = nullptr;
+}
+
+void DbFileIndex::Extend(const std::shared_ptr<const Snapshot>& base)
+{
+    auto ec               = std::error_code{};
+    const auto file_size  = fs::file_size(path, ec);
+    const auto write_time = ec ? fs::file_time_type{} : fs::last_write_time(path, ec);
+    const auto read_time  = fs::file_time_type::clock::now();
+
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    if(ec || base == nullptr || snapshot != base || file_size < base->file_size)
+    {
+        snapshot = nullptr;
+        return;
+    }
+
+    auto extended        = std::make_shared<Snapshot>();
+    extended->file_size  = file_size;
+    extended->write_time = write_time;
+
+    const auto text = MapOrReadFile(path, extended->mapping, extended->buffer);
+    const auto from = static_cast<std::size_t>(base->file_size);
+
+    // A partial last line of the base would be continued by the appended text.
+    if(!text || text->size() != file_size || (from > 0 && (*text)[from - 1] != '\n'))
+    {
+        snapshot = nullptr;
+        return;
+    }
+
+    MIOPEN_LOG_I2("Extending index of " << path << " from " << from << " bytes");
+    extended->content_hash = std::hash<std::string_view>{}(*text);
+    extended->index        = DbTextIndex{base->index, *text, from, path};
+    snapshot               = extended;
+    verified_time          = read_time;
+}
+
+bool DbFileIndex::IsRacy(const fs::file_time_type& write_time) const
+{
+    // Coarsest timestamps of the common file systems, e.g. of FAT.
+    constexpr auto granularity = std::chrono::seconds{2};
+    return write_time + granularity >= verified_time;
+}
+
+std::shared_ptr<const DbFileIndex::Snapshot>
+DbFileIndex::Build(std::uintmax_t file_size,
+                   const fs::file_time_type& write_time,
+                   const std::shared_ptr<const Snapshot>& previous)
+{
+    // Taken before the file is read, so the writes made later are seen as racy.
+    const auto read_time = fs::file_time_type::clock::now();
+
+    auto index        = std::make_shared<Snapshot>();
+    index->file_size  = file_size;
+    index->write_time = write_time;
+
+    const auto text = MapOrReadFile(path, index->mapping, index->buffer);
+    if(!text)
+        return nullptr;
+
+    index->content_hash = std::hash<std::string_view>{}(*text);
+    verified_time       = read_time;
+
+    if(previous != nullptr && previous->content_hash == index->content_hash)
+        return previous;
+
+    MIOPEN_LOG_I2("Building index of " << path);
+    index->index = DbTextIndex{
+        *text, path, is_journal ? DbTextIndex::Kind::Journal : DbTextIndex::Kind::UserDb};
+    MIOPEN_LOG_I2("Indexed " << index->index.GetEntries().size() << " records of " << path);
+    return index;
+}
+
+} // namespace miopen
@@ -0,0 +1,193 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/db_prefetch.hpp>
+#include <miopen/binary_cache.hpp>
+#include <miopen/db.hpp>
+#include <miopen/db_file_index.hpp>
+#include <miopen/env.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mapped_file.hpp>
+#include <miopen/readonlyramdb.hpp>
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_USE_SQLITE_PERFDB
+#include <miopen/sqlite_db.hpp>
+#endif
+
+#include <chrono>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DB_PREFETCH)
+
+namespace miopen {
+
+namespace {
+
+struct PrefetchTask
+{
+    std::string path;
+    std::function<void()> load;
+};
+
+float MillisecondsSince(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start)
+        .count();
+}
+
+void Load(const ReadonlyRamDb*, DbKinds db_kind, const std::string& path)
+{
+    ReadonlyRamDb::GetCached(db_kind, path, true);
+}
+
+void Load(const PlainTextDb*, DbKinds, const std::string& path)
+{
+    auto& lock_file = LockFile::Get(LockFilePath(path).c_str());
+    const auto lock = std::shared_lock<LockFile>(lock_file, std::chrono::seconds{60});
+    if(!lock)
+        MIOPEN_THROW("Db lock has failed to lock.");
+    DbFileIndex::Get(path).Acquire();
+}
+
+/// SQLite dbs are not parsed up front, so just warm up the page cache for them.
+void Load(const void*, DbKinds, const std::string& path)
+{
+#if !MIOPEN_EMBED_DB
+    auto mapping = MappedFile{path};
+    if(!mapping.AdviseWillNeed())
+        MIOPEN_LOG_I2("DB prefetch: read-ahead is not supported for " << path);
+#else
+    std::ignore = path;
+#endif
+}
+
+#if MIOPEN_ENABLE_SQLITE && MIOPEN_USE_SQLITE_PERFDB
+using SystemPerfDb = SQLitePerfDb;
+#else
+using SystemPerfDb = ReadonlyRamDb;
+#endif
+
+bool MarkStarted(const std::string& path)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& mutex = *new std::mutex{};
+    const std::lock_guard<std::mutex> lock{mutex};
+
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& started = *new std::set<std::string>{};
+    return started.insert(path).second;
+}
+
+template <class TDb>
+void AddTask(std::vector<PrefetchTask>& tasks, DbKinds db_kind, const std::string& path)
+{
+    if(path.empty() || !MarkStarted(path))
+        return;
+
+    tasks.push_back(
+        {path, [db_kind, path]() { Load(static_cast<const TDb*>(nullptr), db_kind, path); }});
+}
+
+std::vector<PrefetchTask> CollectTasks(Handle& handle)
+{
+    auto tasks = std::vector<PrefetchTask>{};
+
+    AddTask<SystemFindDb>(tasks, DbKinds::FindDb, FindDbRecord::GetInstalledPath(handle, ""));
+    AddTask<SystemPerfDb>(tasks, DbKinds::PerfDb, ExecutionContext{&handle}.GetPerfDbPath());
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    if(!IsCacheDisabled())
+    {
+        const auto kdb_path =
+            GetSystemKernelDbPath(handle.GetTargetProperties(), handle.GetMaxComputeUnits());
+        AddTask<void>(tasks, DbKinds::KernelDb, kdb_path.string());
+    }
+#endif
+
+    return tasks;
+}
+
+} // namespace
+
+void StartDbPrefetch(Handle& handle)
+{
+    if(!IsEnabled(ENV(MIOPEN_DB_PREFETCH)))
+        return;
+
+    auto tasks = std::vector<PrefetchTask>{};
+    try
+    {
+        tasks = CollectTasks(handle);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("DB prefetch: unable to locate system databases: " << ex.what());
+        return;
+    }
+
+    if(tasks.empty())
+    {
+        MIOPEN_LOG_I2("DB prefetch: nothing to prefetch");
+        return;
+    }
+
+    MIOPEN_LOG_I("DB prefetch: started for " << tasks.size() << " file(s)");
+
+    // The thread is detached, so it may still be running while the statics are destroyed
+    // at exit. It does not refer to the handle, and every static it touches is either never
+    // destroyed (the registries of dbs, indexes and lock files, the db stats) or trivially
+    // destructible (the env vars read by the logger), so it is safe to leave it running.
+    std::thread([tasks = std::move(tasks)]() {
+        const auto start = std::chrono::steady_clock::now();
+        for(const auto& task : tasks)
+        {
+            const auto task_start = std::chrono::steady_clock::now();
+            try
+            {
+                task.load();
+                MIOPEN_LOG_I("DB prefetch: loaded " << task.path << " in "
+                                                    << MillisecondsSince(task_start) << " ms");
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_W("DB prefetch: failed to load " << task.path << ": " << ex.what());
+            }
+        }
+        MIOPEN_LOG_I("DB prefetch: finished in " << MillisecondsSince(start) << " ms");
+    }).detach();
+}
+
+} // namespace miopen
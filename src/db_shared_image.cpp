@@ -0,0 +1,394 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_shared_image.hpp>
+#include <miopen/db_binary_format.hpp>
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/md5.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DB_SHARED_CACHE)
+
+namespace miopen {
+
+namespace {
+
+enum class SegmentState : std::uint32_t
+{
+    Building = 0, // The segment is zero-filled when it is created.
+    Ready,
+};
+
+struct SegmentHeader
+{
+    char magic[8];
+    std::atomic<SegmentState> state;
+    std::uint32_t owner_pid; // For diagnostics, the owner is checked by its flock.
+    std::uint64_t image_size;
+};
+
+static_assert(std::atomic<SegmentState>::is_always_lock_free,
+              "The segment state is shared between processes");
+
+constexpr char segment_magic[8] = {'M', 'I', 'O', 'P', 'E', 'N', 'S', 'H'};
+constexpr auto build_timeout    = std::chrono::seconds{10};
+
+std::string BuildImage(std::string_view text, const fs::path& db_path)
+{
+    auto records = std::vector<binary_db::SourceRecord>{};
+    auto n_line  = 0;
+
+    while(!text.empty())
+    {
+        const auto line_size = std::min(text.find('\n'), text.size());
+        const auto line      = text.substr(0, line_size);
+        text.remove_prefix(std::min(line_size + 1, text.size()));
+        ++n_line;
+
+        if(line.empty())
+            continue;
+
+        auto record = binary_db::SourceRecord{};
+        if(!binary_db::ParseTextRecord(line, record))
+        {
+            MIOPEN_LOG_W("Ill-formed record: key not found: " << db_path << "#" << n_line);
+            continue;
+        }
+        records.push_back(std::move(record));
+    }
+
+    auto image = std::ostringstream{};
+    binary_db::Write(std::move(records), image);
+    return image.str();
+}
+
+} // namespace
+
+bool SharedDbImage::IsEnabled() { return miopen::IsEnabled(ENV(MIOPEN_DB_SHARED_CACHE)); }
+
+SharedDbImage::SharedDbImage(std::string name_, void* address_, std::size_t size_, int owner_fd_)
+    : name(std::move(name_)), address(address_), size(size_), owner_fd(owner_fd_)
+{
+}
+
+std::string_view SharedDbImage::View() const
+{
+    return {static_cast<const char*>(address) + sizeof(SegmentHeader),
+            size - sizeof(SegmentHeader)};
+}
+
+#ifdef __linux__
+
+namespace {
+
+struct FileDescriptor
+{
+    int fd;
+
+    FileDescriptor(int fd_) : fd(fd_) {}
+    FileDescriptor(const FileDescriptor&) = delete;
+    FileDescriptor& operator=(const FileDescriptor&) = delete;
+    ~FileDescriptor()
+    {
+        if(fd >= 0)
+            close(fd);
+    }
+};
+
+/// Common to the segments of all versions of the db file in the current format.
+/// Returns an empty string if the db file cannot be identified.
+std::string GetSegmentPrefix(const fs::path& db_path)
+{
+    auto ec        = std::error_code{};
+    auto canonical = fs::canonical(db_path, ec);
+    if(ec)
+        return {};
+    return "miopen-db-" + std::to_string(geteuid()) + "-" + md5(canonical.string()).substr(0, 16) +
+           "-v" + std::to_string(binary_db::version) + "-";
+}
+
+std::string GetSegmentName(const std::string& prefix, const fs::path& db_path)
+{
+    struct stat st = {};
+    if(stat(db_path.c_str(), &st) != 0)
+        return {};
+    return "/" + prefix + std::to_string(st.st_size) + "-" + std::to_string(st.st_mtim.tv_sec) +
+           "." + std::to_string(st.st_mtim.tv_nsec);
+}
+
+/// Returns true if the builder of the segment does not hold its flock anymore.
+bool IsOwnerGone(int fd)
+{
+    if(flock(fd, LOCK_SH | LOCK_NB) != 0)
+        return false;
+    flock(fd, LOCK_UN);
+    return true;
+}
+
+/// Segments of the previous versions of the db file are not used by anyone starting
+/// afterwards. The processes still using them keep their mappings. The segments in the
+/// other formats are left to the MIOpen versions using them.
+void RemoveStaleSegments(const std::string& prefix, const std::string& name)
+{
+    auto ec = std::error_code{};
+    for(const auto& entry : fs::directory_iterator{"/dev/shm", ec})
+    {
+        const auto filename = entry.path().filename().string();
+        if(filename.compare(0, prefix.size(), prefix) == 0 && "/" + filename != name)
+        {
+            MIOPEN_LOG_I2("Removing stale shared db image /" << filename);
+            shm_unlink(("/" + filename).c_str());
+        }
+    }
+}
+
+} // namespace
+
+SharedDbImage::~SharedDbImage()
+{
+    munmap(address, size);
+    if(owner_fd >= 0)
+        close(owner_fd);
+}
+
+void SharedDbImage::Unlink() const { shm_unlink(name.c_str()); }
+
+std::unique_ptr<SharedDbImage>
+SharedDbImage::Open(const fs::path& db_path, const TextLoader& load_text)
+{
+    const auto prefix = GetSegmentPrefix(db_path);
+    const auto name   = prefix.empty() ? std::string{} : GetSegmentName(prefix, db_path);
+    if(name.empty())
+        return nullptr;
+
+    auto exists = false;
+    if(auto image = Attach(name, exists))
+        return image;
+    if(exists)
+        return nullptr;
+
+    const auto text = load_text();
+    // Binary files are already shared via the page cache.
+    if(!text || binary_db::View::IsBinary(*text))
+        return nullptr;
+
+    auto image = std::string{};
+    try
+    {
+        image = BuildImage(*text, db_path);
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_W("Unable to build a shared image of " << db_path << ": " << ex.what());
+        return nullptr;
+    }
+
+    if(auto created = Create(name, image, exists))
+    {
+        RemoveStaleSegments(prefix, name);
+        return created;
+    }
+
+    // Another process has created the segment first.
+    if(exists)
+        return Attach(name, exists);
+    return nullptr;
+}
+
+std::unique_ptr<SharedDbImage> SharedDbImage::Attach(const std::string& name, bool& exists)
+{
+    const auto file = FileDescriptor{shm_open(name.c_str(), O_RDONLY, 0)};
+    exists          = file.fd >= 0 || errno != ENOENT;
+    if(file.fd < 0)
+    {
+        if(exists)
+            MIOPEN_LOG_I("Unable to open shared db image " << name << ": " << strerror(errno));
+        return nullptr;
+    }
+
+    const auto deadline = std::chrono::steady_clock::now() + build_timeout;
+    auto owner_known    = false;
+
+    for(;;)
+    {
+        struct stat st = {};
+        if(fstat(file.fd, &st) != 0 || st.st_uid != geteuid())
+        {
+            MIOPEN_LOG_W("Ignoring shared db image " << name << ": unexpected owner");
+            return nullptr;
+        }
+
+        const auto size = static_cast<std::size_t>(st.st_size);
+
+        // The header is written first, see Create().
+        if(size >= sizeof(SegmentHeader))
+        {
+            auto address = mmap(nullptr, size, PROT_READ, MAP_SHARED, file.fd, 0);
+            if(address == MAP_FAILED) // NOLINT (cppcoreguidelines-pro-type-cstyle-cast)
+            {
+                MIOPEN_LOG_W("Unable to map shared db image " << name << ": " << strerror(errno));
+                return nullptr;
+            }
+
+            // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+            auto image = std::unique_ptr<SharedDbImage>{new SharedDbImage{name, address, size}};
+            const auto& header   = *static_cast<const SegmentHeader*>(address);
+            const auto state     = header.state.load(std::memory_order_acquire);
+            const auto full_size = sizeof(SegmentHeader) + header.image_size;
+
+            if(state == SegmentState::Ready)
+            {
+                if(std::memcmp(header.magic, segment_magic, sizeof(segment_magic)) != 0 ||
+                   full_size < size)
+                {
+                    MIOPEN_LOG_W("Ignoring ill-formed shared db image " << name);
+                    return nullptr;
+                }
+                // A smaller size has been read before the image was complete, so it is read
+                // again.
+                if(full_size == size)
+                {
+                    MIOPEN_LOG_I2("Attached to shared db image " << name);
+                    return image;
+                }
+            }
+
+            owner_known = header.owner_pid != 0;
+
+            // The owner has exited without finishing the image, a next process rebuilds it.
+            // The owner locks the segment before writing the header, see Create().
+            if(owner_known && state != SegmentState::Ready && IsOwnerGone(file.fd))
+            {
+                MIOPEN_LOG_W("Removing incomplete shared db image " << name);
+                shm_unlink(name.c_str());
+                return nullptr;
+            }
+        }
+
+        if(std::chrono::steady_clock::now() > deadline)
+        {
+            // The owner has died before writing the header, or the segment would not be left
+            // without it for so long. A next process rebuilds it.
+            if(!owner_known)
+            {
+                MIOPEN_LOG_W("Removing orphaned shared db image " << name);
+                shm_unlink(name.c_str());
+                return nullptr;
+            }
+
+            MIOPEN_LOG_W("Timed out waiting for shared db image " << name);
+            return nullptr;
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds{1});
+    }
+}
+
+std::unique_ptr<SharedDbImage>
+SharedDbImage::Create(const std::string& name, const std::string& image, bool& exists)
+{
+    auto file = FileDescriptor{shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600)};
+    exists    = file.fd < 0 && errno == EEXIST;
+    if(file.fd < 0)
+    {
+        if(!exists)
+            MIOPEN_LOG_I("Unable to create shared db image " << name << ": " << strerror(errno));
+        return nullptr;
+    }
+
+    // The flock is taken and the header is written before the size is set, so the other
+    // processes always find the owner, and remove the segment if it dies before the image is
+    // complete. The state is Building, as the header is zero-filled.
+    if(flock(file.fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        MIOPEN_LOG_W("Unable to lock shared db image " << name << ": " << strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    auto header = SegmentHeader{};
+    std::memcpy(header.magic, segment_magic, sizeof(segment_magic));
+    header.owner_pid  = static_cast<std::uint32_t>(getpid());
+    header.image_size = image.size();
+
+    const auto size = sizeof(SegmentHeader) + image.size();
+    auto address    = MAP_FAILED; // NOLINT (cppcoreguidelines-pro-type-cstyle-cast)
+
+    if(pwrite(file.fd, &header, sizeof(header), 0) == static_cast<ssize_t>(sizeof(header)) &&
+       ftruncate(file.fd, static_cast<off_t>(size)) == 0)
+        address = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file.fd, 0);
+
+    if(address == MAP_FAILED) // NOLINT (cppcoreguidelines-pro-type-cstyle-cast)
+    {
+        MIOPEN_LOG_W("Unable to allocate shared db image " << name << ": " << strerror(errno));
+        shm_unlink(name.c_str());
+        return nullptr;
+    }
+
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    auto result = std::unique_ptr<SharedDbImage>{
+        new SharedDbImage{name, address, size, std::exchange(file.fd, -1)}};
+    std::memcpy(static_cast<char*>(address) + sizeof(SegmentHeader), image.data(), image.size());
+    static_cast<SegmentHeader*>(address)->state.store(SegmentState::Ready,
+                                                      std::memory_order_release);
+
+    mprotect(address, size, PROT_READ);
+    MIOPEN_LOG_I("Created shared db image " << name << ", " << image.size() << " bytes");
+    return result;
+}
+
+#else
+
+SharedDbImage::~SharedDbImage() {}
+
+void SharedDbImage::Unlink() const {}
+
+std::unique_ptr<SharedDbImage> SharedDbImage::Open(const fs::path&, const TextLoader&)
+{
+    MIOPEN_LOG_I2("Shared db images are not supported on this platform");
+    return nullptr;
+}
+
+#endif
+
+} // namespace miopen
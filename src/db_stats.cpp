@@ -0,0 +1,204 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_stats.hpp>
+#include <miopen/env.hpp>
+#include <miopen/errors.hpp>
+#include <miopen/logger.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <cstdlib>
+#include <fstream>
+#include <mutex>
+
+#ifdef __linux__
+#include <unistd.h>
+#endif
+
+MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DB_STATS_JSON)
+
+namespace miopen {
+
+namespace {
+
+std::string& DumpPath()
+{
+    // Is not destroyed, as it is used by the exit handler.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& path = *new std::string{};
+    return path;
+}
+
+void DumpAtExit()
+{
+    auto path = DumpPath();
+#ifdef __linux__
+    const auto pid = std::to_string(getpid());
+    for(auto pos = path.find("%p"); pos != std::string::npos; pos = path.find("%p", pos))
+    {
+        path.replace(pos, 2, pid);
+        pos += pid.size();
+    }
+#endif
+
+    auto file = std::ofstream{path};
+    file << DbStats::ToJson() << std::endl;
+    if(!file)
+        MIOPEN_LOG_E("Unable to write db stats to " << path);
+}
+
+DbStats* GetAll()
+{
+    // The stats are not destroyed, so the threads still running at the exit and the exit
+    // handler can use them.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto* const all = new DbStats[DbStats::kinds];
+
+    static std::once_flag dump_once;
+    std::call_once(dump_once, []() {
+        DumpPath() = GetStringEnv(ENV(MIOPEN_DB_STATS_JSON));
+        if(!DumpPath().empty())
+            std::atexit(DumpAtExit);
+    });
+
+    return all;
+}
+
+} // namespace
+
+DbStats& DbStats::Get(Kind kind) { return GetAll()[static_cast<std::size_t>(kind)]; }
+
+DbStats& DbStats::Get(DbKinds kind)
+{
+    switch(kind)
+    {
+    case DbKinds::FindDb: return Get(Kind::FindDb);
+    case DbKinds::PerfDb: return Get(Kind::PerfDb);
+    case DbKinds::KernelDb: return Get(Kind::KernelDb);
+    }
+    MIOPEN_THROW(miopenStatusInternalError, "Unknown db kind");
+}
+
+const char* DbStats::GetName(Kind kind)
+{
+    switch(kind)
+    {
+    case Kind::FindDb: return "FindDb";
+    case Kind::PerfDb: return "PerfDb";
+    case Kind::KernelDb: return "KernelDb";
+    case Kind::AnyRamDb: return "AnyRamDb";
+    case Kind::InvokerCache: return "InvokerCache";
+    case Kind::KernelCache: return "KernelCache";
+    }
+    return "Unknown";
+}
+
+void DbStats::AddLookup(bool hit, std::chrono::steady_clock::duration time)
+{
+    const auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(time).count();
+    auto bucket   = std::size_t{0};
+    for(auto us = ns / 1000; us > 0 && bucket < latency_buckets - 1; us /= 2)
+        ++bucket;
+
+    lookups.fetch_add(1, std::memory_order_relaxed);
+    if(hit)
+        hits.fetch_add(1, std::memory_order_relaxed);
+    lookup_ns.fetch_add(ns, std::memory_order_relaxed);
+    lookup_latency[bucket].fetch_add(1, std::memory_order_relaxed);
+}
+
+DbStats::Snapshot DbStats::GetSnapshot() const
+{
+    auto ret           = Snapshot{};
+    ret.lookups        = lookups.load(std::memory_order_relaxed);
+    ret.hits           = hits.load(std::memory_order_relaxed);
+    ret.misses         = ret.lookups - ret.hits;
+    ret.stores         = stores.load(std::memory_order_relaxed);
+    ret.bytes_read     = bytes_read.load(std::memory_order_relaxed);
+    ret.lookup_ns      = lookup_ns.load(std::memory_order_relaxed);
+    ret.evictions      = evictions.load(std::memory_order_relaxed);
+    ret.resident_bytes = resident_bytes.load(std::memory_order_relaxed);
+    for(auto i = std::size_t{0}; i < latency_buckets; ++i)
+        ret.lookup_latency[i] = lookup_latency[i].load(std::memory_order_relaxed);
+    return ret;
+}
+
+void DbStats::Reset()
+{
+    lookups.store(0, std::memory_order_relaxed);
+    hits.store(0, std::memory_order_relaxed);
+    stores.store(0, std::memory_order_relaxed);
+    bytes_read.store(0, std::memory_order_relaxed);
+    lookup_ns.store(0, std::memory_order_relaxed);
+    evictions.store(0, std::memory_order_relaxed);
+    for(auto& bucket : lookup_latency)
+        bucket.store(0, std::memory_order_relaxed);
+}
+
+void DbStats::ResetAll()
+{
+    for(auto i = std::size_t{0}; i < kinds; ++i)
+        Get(static_cast<Kind>(i)).Reset();
+}
+
+std::string DbStats::ToJson()
+{
+    auto json = nlohmann::json::object();
+
+    for(auto i = std::size_t{0}; i < kinds; ++i)
+    {
+        const auto kind  = static_cast<Kind>(i);
+        const auto stats = Get(kind).GetSnapshot();
+
+        auto histogram = nlohmann::json::array();
+        for(auto bucket = std::size_t{0}; bucket < latency_buckets; ++bucket)
+        {
+            if(stats.lookup_latency[bucket] == 0)
+                continue;
+            const auto less_than_us = bucket < latency_buckets - 1
+                                          ? nlohmann::json(std::uint64_t{1} << bucket)
+                                          : nlohmann::json(nullptr);
+            histogram.push_back({{"less_than_us", less_than_us},
+                                 {"count", stats.lookup_latency[bucket]}});
+        }
+
+        json[GetName(kind)] = {
+            {"lookups", stats.lookups},
+            {"hits", stats.hits},
+            {"misses", stats.misses},
+            {"stores", stats.stores},
+            {"bytes_read", stats.bytes_read},
+            {"lookup_time_us", stats.lookup_ns / 1000},
+            {"lookup_latency", histogram},
+            {"evictions", stats.evictions},
+            {"resident_bytes", stats.resident_bytes},
+        };
+    }
+
+    return json.dump(4);
+}
+
+} // namespace miopen
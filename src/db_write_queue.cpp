@@ -0,0 +1,212 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/db_write_queue.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/ramdb.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+
+namespace miopen {
+
+namespace {
+
+/// Time the writer waits for more updates before writing, to coalesce and batch them.
+constexpr auto coalescing_delay = std::chrono::milliseconds{100};
+
+std::size_t GetLimit()
+{
+    return std::max<std::size_t>(Value(ENV(MIOPEN_DB_WRITE_BEHIND_LIMIT)), 1);
+}
+
+} // namespace
+
+bool DbWriteQueue::IsEnabled()
+{
+    return !DisableUserDbFileIO && miopen::IsEnabled(ENV(MIOPEN_DB_WRITE_BEHIND));
+}
+
+DbWriteQueue& DbWriteQueue::Get()
+{
+    // The queue is not destroyed, so it can be flushed by the exit handler after the other
+    // statics are gone, and the RamDb instances it refers to are never destroyed either.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& queue = *new DbWriteQueue{};
+
+    static std::once_flag exit_once;
+    std::call_once(exit_once, []() { std::atexit([]() { Get().Stop(); }); });
+
+    return queue;
+}
+
+DbWriteQueue::DbWriteQueue() : thread([this]() { Run(); }) {}
+
+void DbWriteQueue::WaitForSpace()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    if(queued_count < GetLimit())
+        return;
+
+    MIOPEN_LOG_I2("Db write queue is full, waiting");
+    work.notify_one();
+    progress.wait(lock, [&]() { return queued_count < GetLimit() || stopping; });
+}
+
+bool DbWriteQueue::Push(RamDb& db, const std::vector<DbChange>& changes)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    if(stopping)
+        return false;
+
+    auto& pending = dbs[&db];
+    pending.db    = &db;
+
+    for(auto change : changes)
+    {
+        ++pushed;
+
+        const auto& key = change.record.GetKey();
+        const auto it   = pending.queued_index.find(key);
+
+        if(it == pending.queued_index.end())
+        {
+            pending.queued_index.emplace(key, pending.queued.size());
+            pending.queued.push_back(std::move(change));
+            ++queued_count;
+            continue;
+        }
+
+        // Same as committing both changes in a batch.
+        auto& queued = pending.queued[it->second];
+        if(change.merge)
+        {
+            change.record.Merge(queued.record);
+            queued.record = std::move(change.record);
+        }
+        else
+        {
+            queued = std::move(change);
+        }
+    }
+
+    work.notify_one();
+    return true;
+}
+
+void DbWriteQueue::ForEachPending(const RamDb& db, const std::function<void(const DbChange&)>& f)
+{
+    const std::lock_guard<std::mutex> lock{mutex};
+    const auto it = dbs.find(&db);
+    if(it == dbs.end())
+        return;
+
+    for(const auto& change : it->second.writing)
+        f(change);
+    for(const auto& change : it->second.queued)
+        f(change);
+}
+
+void DbWriteQueue::Flush()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+    const auto target = pushed;
+    if(written >= target)
+        return;
+
+    flush_requested = true;
+    work.notify_one();
+    progress.wait(lock, [&]() { return written >= target; });
+}
+
+void DbWriteQueue::Run()
+{
+    std::unique_lock<std::mutex> lock{mutex};
+
+    while(true)
+    {
+        work.wait(lock, [&]() { return queued_count > 0 || stopping; });
+        if(queued_count == 0)
+            break;
+
+        work.wait_for(lock, coalescing_delay, [&]() {
+            return stopping || flush_requested || queued_count >= GetLimit();
+        });
+
+        // The changes stay visible to ForEachPending() until they are written.
+        const auto target = pushed;
+        auto batches      = std::vector<Pending*>{};
+        for(auto& db : dbs)
+        {
+            if(db.second.queued.empty())
+                continue;
+            db.second.writing = std::move(db.second.queued);
+            db.second.queued.clear();
+            db.second.queued_index.clear();
+            batches.push_back(&db.second);
+        }
+        queued_count    = 0;
+        flush_requested = false;
+        progress.notify_all();
+
+        lock.unlock();
+        for(const auto pending : batches)
+        {
+            try
+            {
+                if(!pending->db->PersistChanges(pending->writing))
+                    MIOPEN_LOG_E("Failed to write the queued db updates to "
+                                 << pending->db->GetFileName());
+            }
+            catch(const std::exception& ex)
+            {
+                MIOPEN_LOG_E("Failed to write the queued db updates: " << ex.what());
+            }
+        }
+        lock.lock();
+
+        for(const auto pending : batches)
+            pending->writing.clear();
+        written = target;
+        progress.notify_all();
+    }
+}
+
+void DbWriteQueue::Stop()
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+        work.notify_one();
+    }
+
+    if(thread.joinable())
+        thread.join();
+}
+
+} // namespace miopen
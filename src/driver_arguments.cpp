@@ -25,6 +25,12 @@
  *******************************************************************************/
 #include <miopen/driver_arguments.hpp>
 #include <miopen/fusion_plan.hpp>
+#include <miopen/problem.hpp>
+
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
 
 namespace miopen {
 namespace debug {
@@ -208,6 +214,147 @@ std::string ConvArgsForMIOpenDriver(const miopen::TensorDescriptor& xDesc,
     return ss.str();
 }
 
+namespace {
+
+miopenTensorLayout_t LayoutFromString(const std::string& layout)
+{
+    if(layout == "NCHW")
+        return miopenTensorNCHW;
+    if(layout == "NHWC")
+        return miopenTensorNHWC;
+    if(layout == "NCDHW")
+        return miopenTensorNCDHW;
+    if(layout == "NDHWC")
+        return miopenTensorNDHWC;
+    MIOPEN_THROW(miopenStatusBadParm, "Unsupported layout: " + layout);
+}
+
+} // namespace
+
+std::vector<Problem> ParseConvDriverArgs(const std::string& line)
+{
+    // Long names of the flags printed by ConvArgsForMIOpenDriver.
+    static const std::map<char, std::string> short_names = {
+        {'n', "batchsize"},     {'c', "in_channels"},   {'!', "in_d"},
+        {'H', "in_h"},          {'W', "in_w"},          {'k', "out_channels"},
+        {'@', "fil_d"},         {'y', "fil_h"},         {'x', "fil_w"},
+        {'$', "pad_d"},         {'p', "pad_h"},         {'q', "pad_w"},
+        {'#', "conv_stride_d"}, {'u', "conv_stride_h"}, {'v', "conv_stride_w"},
+        {'^', "dilation_d"},    {'l', "dilation_h"},    {'j', "dilation_w"},
+        {'g', "group_count"},   {'m', "mode"},          {'F', "forw"},
+        {'_', "spatial_dim"},   {'I', "in_layout"},     {'f', "fil_layout"},
+        {'O', "out_layout"},
+    };
+
+    auto ss    = std::istringstream{line};
+    auto token = std::string{};
+    auto type  = boost::optional<miopenDataType_t>{};
+
+    while(!type && ss >> token)
+    {
+        if(token == "conv")
+            type = miopenFloat;
+        else if(token == "convfp16")
+            type = miopenHalf;
+        else if(token == "convbfp16")
+            type = miopenBFloat16;
+    }
+
+    if(!type)
+        return {};
+
+    auto args = std::map<std::string, std::string>{};
+    while(ss >> token)
+    {
+        auto name = std::string{};
+        if(token.size() > 2 && token[0] == '-' && token[1] == '-')
+        {
+            name = token.substr(2);
+        }
+        else if(token.size() == 2 && token[0] == '-')
+        {
+            const auto it = short_names.find(token[1]);
+            if(it != short_names.end())
+                name = it->second;
+        }
+
+        auto value = std::string{};
+        if(!(ss >> value))
+            break;
+        if(!name.empty())
+            args[name] = value;
+    }
+
+    const auto get = [&](const std::string& name, int default_value) {
+        const auto it = args.find(name);
+        return it == args.end() ? default_value : std::stoi(it->second);
+    };
+
+    const auto spatial_dim = get("spatial_dim", 2);
+    if(spatial_dim != 2 && spatial_dim != 3)
+        MIOPEN_THROW(miopenStatusBadParm, "Unsupported spatial_dim: " + args["spatial_dim"]);
+
+    const auto is_3d = spatial_dim == 3;
+    const auto group = std::max(get("group_count", 1), 1);
+    const auto trans = args.count("mode") != 0 && args["mode"] == "trans";
+    const auto c     = get("in_channels", 3);
+    const auto k     = get("out_channels", 32);
+
+    const auto spatial = [&](const std::string& prefix, int default_value) {
+        auto lens = std::vector<int>{};
+        if(is_3d)
+            lens.push_back(get(prefix + "d", default_value));
+        lens.push_back(get(prefix + "h", default_value));
+        lens.push_back(get(prefix + "w", default_value));
+        return lens;
+    };
+
+    auto in_lens  = std::vector<int>{get("batchsize", 100), c};
+    auto wei_lens = trans ? std::vector<int>{c, k / group} : std::vector<int>{k, c / group};
+
+    const auto in_spatial  = spatial("in_", 32);
+    const auto wei_spatial = spatial("fil_", 3);
+    in_lens.insert(in_lens.end(), in_spatial.begin(), in_spatial.end());
+    wei_lens.insert(wei_lens.end(), wei_spatial.begin(), wei_spatial.end());
+
+    const auto default_layout = is_3d ? std::string{"NCDHW"} : std::string{"NCHW"};
+    const auto layout         = [&](const std::string& name) {
+        const auto it = args.find(name);
+        return it == args.end() ? default_layout : it->second;
+    };
+
+    const auto conv = ConvolutionDescriptor{static_cast<std::size_t>(spatial_dim),
+                                            trans ? miopenTranspose : miopenConvolution,
+                                            miopenPaddingDefault,
+                                            spatial("pad_", 0),
+                                            spatial("conv_stride_", 1),
+                                            spatial("dilation_", 1),
+                                            std::vector<int>(spatial_dim, 0),
+                                            group};
+    const auto x = TensorDescriptor{*type, LayoutFromString(layout("in_layout")), in_lens};
+    const auto w = TensorDescriptor{*type, LayoutFromString(layout("fil_layout")), wei_lens};
+    const auto y = conv.GetForwardOutputTensorWithLayout(x, w, layout("out_layout"), *type);
+
+    // 0 stands for all the directions.
+    const auto directions = get("forw", 0) == 0 ? 7 : get("forw", 0);
+    auto problems         = std::vector<Problem>{};
+
+    for(const auto direction : {ConvDirection::Fwd, ConvDirection::Bwd, ConvDirection::WrW})
+    {
+        if((directions & static_cast<int>(direction)) == 0)
+            continue;
+
+        auto& problem = problems.emplace_back();
+        problem.SetDirection(CmdArgToDirection(direction));
+        problem.SetOperatorDescriptor(conv);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionX, x);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionW, w);
+        problem.RegisterTensorDescriptor(miopenTensorConvolutionY, y);
+    }
+
+    return problems;
+}
+
 std::string BnormArgsForMIOpenDriver(miopenTensorDescriptor_t xDesc,
                                      miopenBatchNormMode_t bn_mode,
                                      const void* resultRunningMean,
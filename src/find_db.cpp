@@ -33,6 +33,12 @@
 #include <miopen_data.hpp>
 #endif
 #include <miopen/filesystem.hpp>
+#include <miopen/rank.hpp>
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -53,6 +59,84 @@ boost::optional<std::string>& testing_find_db_path_override()
 
 } // namespace debug
 
+namespace {
+
+template <class TDb, class TFunc>
+auto ForEachFindDbKey(rank<1>, TDb& db, TFunc&& f) -> decltype(db.ForEachKey(f))
+{
+    db.ForEachKey(f);
+}
+
+/// Dbs which do not keep the records in memory are not searched for similar problems.
+template <class TDb, class TFunc>
+void ForEachFindDbKey(rank<0>, TDb&, TFunc&&)
+{
+}
+
+const FindDbNeighbours& GetSystemFindDbNeighbours(const std::string& path, FindDbNearestMode mode)
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::map<std::pair<std::string, FindDbNearestMode>, std::unique_ptr<FindDbNeighbours>>
+        indices;
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    auto& index = indices[{path, mode}];
+
+    // System find-db does not change, so its index is built once.
+    if(!index)
+    {
+        index             = std::make_unique<FindDbNeighbours>(mode);
+        decltype(auto) db = GetDbInstance<SystemFindDb>(DbKinds::FindDb, path, true);
+        ForEachFindDbKey(rank<1>{}, db, [&](std::string_view key) { index->Add(key); });
+    }
+
+    return *index;
+}
+
+/// User find-db is updated by Find, so its index is rebuilt when its records change.
+template <class TDb>
+auto GetUserFindDbNeighbours(rank<1>, TDb& db, const std::string& path, FindDbNearestMode mode)
+    -> decltype(db.GetGeneration(), std::shared_ptr<const FindDbNeighbours>{})
+{
+    struct Index
+    {
+        std::uint64_t generation = 0;
+        std::shared_ptr<const FindDbNeighbours> neighbours;
+    };
+
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static std::map<std::pair<std::string, FindDbNearestMode>, Index> indices;
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    auto& index = indices[{path, mode}];
+
+    // The records changed while the keys are read are picked up by the next lookup.
+    const auto generation = db.GetGeneration();
+    if(!index.neighbours || index.generation != generation)
+    {
+        auto neighbours = std::make_shared<FindDbNeighbours>(mode);
+        ForEachFindDbKey(rank<1>{}, db, [&](std::string_view key) { neighbours->Add(key); });
+        index.generation = generation;
+        index.neighbours = std::move(neighbours);
+    }
+
+    return index.neighbours;
+}
+
+/// Dbs which do not keep the records in memory are not searched for similar problems.
+template <class TDb>
+std::shared_ptr<const FindDbNeighbours>
+GetUserFindDbNeighbours(rank<0>, TDb&, const std::string&, FindDbNearestMode)
+{
+    return nullptr;
+}
+
+} // namespace
+
 #if MIOPEN_EMBED_DB
 template <class TDb>
 std::string FindDbRecord_t<TDb>::GetInstalledPathEmbed(Handle& handle,
@@ -233,6 +317,48 @@ std::string FindDbRecord_t<TDb>::GetUserPath(Handle& handle, const std::string&
 #endif
 }
 
+template <class TDb>
+void FindDbRecord_t<TDb>::LoadNearest(const std::string& key)
+{
+    const auto mode  = FindDbNeighbours::GetMode();
+    const auto shape = FindDbKeyShape::Parse(key, mode);
+    if(!shape)
+        return;
+
+    auto nearest        = boost::optional<FindDbNeighbours::Match>{};
+    const auto consider = [&](boost::optional<FindDbNeighbours::Match> match) {
+        if(match && (!nearest || match->distance < nearest->distance))
+            nearest = std::move(match);
+    };
+
+#if !MIOPEN_DISABLE_USERDB
+    {
+        decltype(auto) user_db = GetDbInstance<UserFindDb>(DbKinds::FindDb, path, false);
+        const auto user_index  = GetUserFindDbNeighbours(rank<1>{}, user_db, path, mode);
+        if(user_index)
+            consider(user_index->FindNearest(*shape));
+    }
+#endif
+
+    if(!installed_path.empty())
+        consider(GetSystemFindDbNeighbours(installed_path, mode).FindNearest(*shape));
+
+    if(!nearest)
+    {
+        MIOPEN_LOG_I2("Find-db has no records of similar problems for " << key);
+        return;
+    }
+
+    content = db->FindRecord(nearest->key);
+    if(!content)
+        return;
+
+    // The record belongs to the other problem and must not be stored under this key.
+    in_sync     = true;
+    approximate = true;
+    MIOPEN_LOG_I("Find-db approximate match: using " << nearest->key << " for " << key);
+}
+
 template <class TDb>
 bool FindDbRecord_t<TDb>::Validate(Handle& handle, const NetworkConfig& config) const
 {
@@ -0,0 +1,155 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/find_db_nearest.hpp>
+
+#include <miopen/env.hpp>
+
+#include <charconv>
+#include <cmath>
+
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_FIND_DB_NEAREST)
+
+namespace miopen {
+
+namespace {
+
+bool ParseSize(std::string_view field, std::uint64_t& value)
+{
+    const auto end    = field.data() + field.size();
+    const auto result = std::from_chars(field.data(), end, value);
+    return result.ec == std::errc{} && result.ptr == end && value > 0;
+}
+
+} // namespace
+
+boost::optional<FindDbKeyShape> FindDbKeyShape::Parse(std::string_view key, FindDbNearestMode mode)
+{
+    if(mode == FindDbNearestMode::Disabled)
+        return boost::none;
+
+    auto fields = std::vector<std::string_view>{};
+    for(auto pos = std::size_t{0};;)
+    {
+        const auto sep = key.find('-', pos);
+        fields.push_back(key.substr(pos, sep == std::string_view::npos ? sep : sep - pos));
+        if(sep == std::string_view::npos)
+            break;
+        pos = sep + 1;
+    }
+
+    // 2D: C-H-W-FyxFx-K-OH-OW-N-..., 3D: C-D-H-W-FzxFyxFx-K-OD-OH-OW-N-...
+    if(fields.size() < 8)
+        return boost::none;
+    const auto dims      = std::size_t{fields[3].find('x') != std::string_view::npos ? 2U : 3U};
+    const auto filter    = dims + 1;
+    const auto batch_idx = 2 * dims + 3;
+    if(fields.size() <= batch_idx + 1 || fields[filter].find('x') == std::string_view::npos)
+        return boost::none;
+
+    auto shape  = FindDbKeyShape{};
+    auto masked = std::vector<bool>(fields.size(), false);
+
+    if(!ParseSize(fields[batch_idx], shape.batch))
+        return boost::none;
+    masked[batch_idx] = true;
+
+    if(mode == FindDbNearestMode::BatchAndSpatial)
+    {
+        for(auto i = std::size_t{1}; i <= dims; ++i)
+        {
+            auto size = std::uint64_t{};
+            if(!ParseSize(fields[i], size))
+                return boost::none;
+            shape.spatial *= size;
+            // The output spatial sizes follow the output channels.
+            masked[i] = masked[filter + 1 + i] = true;
+        }
+    }
+
+    for(auto i = std::size_t{0}; i < fields.size(); ++i)
+    {
+        if(i != 0)
+            shape.masked += '-';
+        if(masked[i])
+            shape.masked += '*';
+        else
+            shape.masked.append(fields[i]);
+    }
+
+    return shape;
+}
+
+double FindDbKeyShape::Distance(const FindDbKeyShape& other) const
+{
+    const auto ratio = [](std::uint64_t left, std::uint64_t right) {
+        return std::abs(std::log2(static_cast<double>(left) / static_cast<double>(right)));
+    };
+    return ratio(batch, other.batch) + ratio(spatial, other.spatial);
+}
+
+FindDbNearestMode FindDbNeighbours::GetMode()
+{
+    const auto value = Value(ENV(MIOPEN_FIND_DB_NEAREST));
+    if(value >= static_cast<std::uint64_t>(FindDbNearestMode::BatchAndSpatial))
+        return FindDbNearestMode::BatchAndSpatial;
+    return static_cast<FindDbNearestMode>(value);
+}
+
+void FindDbNeighbours::Add(std::string_view key)
+{
+    auto shape = FindDbKeyShape::Parse(key, mode);
+    if(!shape)
+        return;
+    auto masked = std::move(shape->masked);
+    entries[std::move(masked)].push_back({std::string{key}, std::move(*shape)});
+}
+
+boost::optional<FindDbNeighbours::Match>
+FindDbNeighbours::FindNearest(const FindDbKeyShape& shape) const
+{
+    const auto it = entries.find(shape.masked);
+    if(it == entries.end())
+        return boost::none;
+
+    const Entry* best  = nullptr;
+    auto best_distance = 0.;
+    for(const auto& entry : it->second)
+    {
+        const auto distance = shape.Distance(entry.shape);
+        // On a tie the larger problem is preferred.
+        if(best == nullptr || distance < best_distance ||
+           (distance == best_distance && entry.shape.batch > best->shape.batch))
+        {
+            best          = &entry;
+            best_distance = distance;
+        }
+    }
+
+    return Match{best->key, best_distance};
+}
+
+} // namespace miopen
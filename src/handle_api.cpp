@@ -25,6 +25,9 @@
  *******************************************************************************/
 #include <cstdio>
 #include <miopen/version.h>
+#include <miopen/db_prefetch.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle.hpp>
 
@@ -72,14 +75,20 @@ extern "C" miopenStatus_t miopenGetVersion(size_t* major, size_t* minor, size_t*
 extern "C" miopenStatus_t miopenCreate(miopenHandle_t* handle)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(); });
+    return miopen::try_([&] {
+        miopen::deref(handle) = new miopen::Handle();
+        miopen::StartDbPrefetch(miopen::deref(*handle));
+    });
 }
 
 extern "C" miopenStatus_t miopenCreateWithStream(miopenHandle_t* handle,
                                                  miopenAcceleratorQueue_t stream)
 {
 
-    return miopen::try_([&] { miopen::deref(handle) = new miopen::Handle(stream); });
+    return miopen::try_([&] {
+        miopen::deref(handle) = new miopen::Handle(stream);
+        miopen::StartDbPrefetch(miopen::deref(*handle));
+    });
 }
 
 extern "C" miopenStatus_t miopenSetStream(miopenHandle_t handle, miopenAcceleratorQueue_t streamID)
@@ -114,3 +123,37 @@ extern "C" miopenStatus_t miopenEnableProfiling(miopenHandle_t handle, bool enab
 {
     return miopen::try_([&] { miopen::deref(handle).EnableProfiling(enable); });
 }
+
+extern "C" miopenStatus_t miopenFlushUserDb(void)
+{
+    return miopen::try_([&] {
+        if(miopen::DbWriteQueue::IsEnabled())
+            miopen::DbWriteQueue::Get().Flush();
+    });
+}
+
+extern "C" miopenStatus_t miopenGetDbStats(miopenDbKind_t kind, miopenDbStats_t* stats)
+{
+    return miopen::try_([&] {
+        const auto index = static_cast<std::size_t>(kind);
+        if(index >= miopen::DbStats::kinds)
+            MIOPEN_THROW(miopenStatusBadParm, "Unknown db kind");
+
+        const auto snapshot =
+            miopen::DbStats::Get(static_cast<miopen::DbStats::Kind>(index)).GetSnapshot();
+        auto& out         = miopen::deref(stats);
+        out.lookups       = snapshot.lookups;
+        out.hits          = snapshot.hits;
+        out.misses        = snapshot.misses;
+        out.stores        = snapshot.stores;
+        out.bytesRead     = snapshot.bytes_read;
+        out.lookupTimeUs  = snapshot.lookup_ns / 1000;
+        out.evictions     = snapshot.evictions;
+        out.residentBytes = snapshot.resident_bytes;
+    });
+}
+
+extern "C" miopenStatus_t miopenResetDbStats(void)
+{
+    return miopen::try_([&] { miopen::DbStats::ResetAll(); });
+}
@@ -28,6 +28,8 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_lease.hpp>
+#include <miopen/compile_scheduler.hpp>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
@@ -55,6 +57,7 @@
 #include <chrono>
 #include <thread>
 #include <mutex>
+#include <optional>
 #include <shared_mutex>
 
 /// hipMemGetInfo constantly fails on gfx906/900 and Navi21.
@@ -469,8 +472,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -512,6 +515,17 @@ Program Handle::LoadProgram(const std::string& program_name,
         }
     }
 
+    // Let one of the processes sharing the cache build the object while the others wait for it
+    std::optional<CompileLease> lease;
+    if(hsaco.empty())
+    {
+        lease.emplace(this->GetTargetProperties(), program_name, params);
+        hsaco = lease->Wait([&]() {
+            return miopen::LoadBinary(
+                this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+        });
+    }
+
     // Still unable to find the object, build it with the available compiler possibly a target ID
     // specific code object
     if(hsaco.empty())
@@ -519,6 +533,7 @@ Program Handle::LoadProgram(const std::string& program_name,
         CompileTimer ct;
         auto p = HIPOCProgram{program_name, params, this->GetTargetProperties(), kernel_src};
         ct.Log("Kernel", program_name);
+        RecordCompileTime(program_name, ct.ElapsedMs());
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
@@ -365,6 +365,11 @@ std::string HIPOCProgram::GetCodeObjectBlob() const
     return {impl->binary.data(), impl->binary.size()};
 }
 
+std::size_t HIPOCProgram::GetCodeObjectSize() const
+{
+    return impl == nullptr ? 0 : impl->binary.size();
+}
+
 void HIPOCProgram::FreeCodeObjectFileStorage()
 {
     impl->dir = boost::none;
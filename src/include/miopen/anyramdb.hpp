@@ -25,29 +25,33 @@
  *******************************************************************************/
 #pragma once
 
+#include <miopen/clock_map.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
-#include <miopen/lock_file.hpp>
+#include <miopen/db_stats.hpp>
 
 #include <boost/optional.hpp>
 #include <boost/any.hpp>
 
+#include <array>
 #include <chrono>
-#include <map>
+#include <shared_mutex>
 #include <string>
 #include <sstream>
 
 namespace miopen {
 
-class LockFile;
-
+/// In-memory cache of the TunaNet heuristic results. The records live only in the process
+/// memory, so the cache is guarded by in-process locks, sharded by the key hash so concurrent
+/// lookups of different problems do not contend and lookups never wait for each other.
+/// MIOPEN_ANYRAMDB_CACHE_LIMIT bounds the number of the records, the least recently used ones
+/// are evicted by the CLOCK algorithm.
 struct AnyRamDb
 {
     using TRecord = std::vector<boost::any>;
 
 public:
-    AnyRamDb(std::string filename_)
-        : filename(filename_), lock_file(LockFile::Get(LockFilePath(filename_).c_str())){};
+    AnyRamDb(std::string filename_);
 
     AnyRamDb(const AnyRamDb&) = delete;
     AnyRamDb(AnyRamDb&&)      = delete;
@@ -87,11 +91,21 @@ public:
     }
 
 private:
-    std::map<std::string, std::vector<boost::any>> cache;
+    static constexpr std::size_t shard_count = 16;
+
+    // Aligned so the locks of neighbour shards do not share a cache line.
+    struct alignas(64) Shard
+    {
+        std::shared_mutex mutex;
+        ClockMap<std::string, TRecord> records;
+    };
+
     std::string filename;
-    LockFile& lock_file;
-    boost::optional<TRecord> FindRecordUnsafe(const std::string& problem);
-    void UpdateCacheEntryUnsafe(const std::string& key, const TRecord& value);
+    std::array<Shard, shard_count> shards;
+    DbResidentBytes resident_bytes{DbStats::Kind::AnyRamDb};
+
+    Shard& GetShard(const std::string& key);
+    static std::ptrdiff_t GetSize(const std::string& key, const TRecord& record);
 };
 
 /// \todo This is modified copy of code from db.hpp. Make a proper fix.
@@ -28,8 +28,11 @@
 #define GUARD_MLOPEN_BINARY_CACHE_HPP
 
 #include <miopen/config.h>
+#include <miopen/export.h>
 #include <miopen/target_properties.hpp>
 #include <miopen/filesystem.hpp>
+#include <chrono>
+#include <cstddef>
 #include <string>
 
 namespace miopen {
@@ -40,6 +43,31 @@ fs::path GetCacheFile(const std::string& device, const std::string& name, const
 
 fs::path GetCachePath(bool is_system);
 
+struct KernelCacheUsage
+{
+    std::size_t kernels = 0;
+    std::size_t bytes   = 0; ///< The size of the stored binaries.
+};
+
+/// The path is either a user kernel db (*.ukdb) or a directory of the cache layout that keeps
+/// each kernel in a separate file.
+MIOPEN_EXPORT KernelCacheUsage GetKernelCacheUsage(const fs::path& path);
+
+/// Removes the kernels of a user kernel cache that were last used before unused_since, then the
+/// least recently used ones until the rest take at most max_bytes. Compacting a kernel db
+/// returns the freed space to the filesystem, otherwise it is reused by the following stores.
+MIOPEN_EXPORT KernelCacheUsage
+TrimKernelCache(const fs::path& path,
+                std::size_t max_bytes,
+                std::chrono::system_clock::time_point unused_since = {},
+                bool compact                                        = false);
+
+/// Adds the kernels of the kernel db at src to the one at dst, which is created if there is
+/// none. The kernels of dst with the same name and arguments are replaced. Either can be a
+/// system (*.kdb) or a user (*.ukdb) kernel db. A system dst is left ready to be installed, see
+/// KernDb::PrepareForInstall(). Returns the usage of dst.
+MIOPEN_EXPORT KernelCacheUsage MergeKernelDb(const fs::path& src, const fs::path& dst);
+
 #if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
 fs::path LoadBinary(const TargetProperties& target,
                     std::size_t num_cu,
@@ -51,6 +79,9 @@ void SaveBinary(const fs::path& binary_path,
                 const std::string& name,
                 const std::string& args);
 #else
+/// Path to the installed kernel db for the target, empty if there is none.
+fs::path GetSystemKernelDbPath(const TargetProperties& target, std::size_t num_cu);
+
 std::string LoadBinary(const TargetProperties& target,
                        std::size_t num_cu,
                        const std::string& name,
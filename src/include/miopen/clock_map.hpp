@@ -0,0 +1,205 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_CLOCK_MAP_HPP_
+#define GUARD_MIOPEN_CLOCK_MAP_HPP_
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace miopen {
+
+/// Hash map with a bounded number of entries. When an insertion exceeds the capacity, the
+/// entries are evicted by the CLOCK algorithm: a lookup marks the entry as referenced, and the
+/// clock hand goes round the entries in the insertion order, clearing the marks, until it finds
+/// an entry that has not been referenced since the previous round. A capacity of zero means no
+/// limit.
+///
+/// Not thread-safe, except that concurrent Find() calls on a const object are allowed, so the
+/// map may be guarded by a shared mutex taken exclusively only for modifications.
+template <class TKey, class TValue, class THash = std::hash<TKey>>
+class ClockMap
+{
+    using Ring = std::list<const TKey*>;
+
+    struct Item
+    {
+        template <class... TArgs>
+        explicit Item(TArgs&&... args) : value(std::forward<TArgs>(args)...)
+        {
+        }
+
+        TValue value;
+        mutable std::atomic<bool> referenced{false};
+        typename Ring::iterator position;
+    };
+
+    using Map = std::unordered_map<TKey, Item, THash>;
+
+public:
+    explicit ClockMap(std::size_t capacity_ = 0) : capacity(capacity_) {}
+
+    ClockMap(const ClockMap&) = delete;
+    ClockMap& operator=(const ClockMap&) = delete;
+
+    // Swapping the list and the map keeps the iterators and the key pointers valid.
+    ClockMap(ClockMap&& other) noexcept : capacity(other.capacity)
+    {
+        const auto hand_at_end = other.hand == other.ring.end();
+        items.swap(other.items);
+        ring.swap(other.ring);
+        hand       = hand_at_end ? ring.end() : other.hand;
+        other.hand = other.ring.end();
+    }
+
+    ClockMap& operator=(ClockMap&&) = delete;
+
+    std::size_t GetCapacity() const { return capacity; }
+    void SetCapacity(std::size_t value) { capacity = value; }
+
+    std::size_t Size() const { return items.size(); }
+    bool Empty() const { return items.empty(); }
+
+    /// Returns nullptr if there is no such entry. Marks the entry as referenced.
+    const TValue* Find(const TKey& key) const
+    {
+        const auto it = items.find(key);
+        if(it == items.end())
+            return nullptr;
+        Touch(it->second);
+        return &it->second.value;
+    }
+
+    TValue* Find(const TKey& key)
+    {
+        const auto it = items.find(key);
+        if(it == items.end())
+            return nullptr;
+        Touch(it->second);
+        return &it->second.value;
+    }
+
+    /// Returns the value under the key, inserting the value constructed from args if there is
+    /// none. An insertion over the capacity first evicts an entry, calling
+    /// on_evict(key, value) for it.
+    template <class TOnEvict, class... TArgs>
+    std::pair<TValue&, bool> TryEmplace(const TKey& key, TOnEvict&& on_evict, TArgs&&... args)
+    {
+        const auto it = items.find(key);
+        if(it != items.end())
+        {
+            Touch(it->second);
+            return {it->second.value, false};
+        }
+
+        if(capacity != 0)
+        {
+            while(items.size() >= capacity)
+                EvictOne(on_evict);
+        }
+
+        const auto inserted = items
+                                  .emplace(std::piecewise_construct,
+                                           std::forward_as_tuple(key),
+                                           std::forward_as_tuple(std::forward<TArgs>(args)...))
+                                  .first;
+        auto& item = inserted->second;
+        // New entries are placed right behind the hand, so they are checked last.
+        item.position = ring.insert(hand, &inserted->first);
+        item.referenced.store(true, std::memory_order_relaxed);
+        return {item.value, true};
+    }
+
+    bool Erase(const TKey& key)
+    {
+        const auto it = items.find(key);
+        if(it == items.end())
+            return false;
+        Unlink(it->second);
+        items.erase(it);
+        return true;
+    }
+
+    /// Calls f(key, value) for every entry.
+    template <class TFunc>
+    void ForEach(TFunc&& f) const
+    {
+        for(const auto& item : items)
+            f(item.first, item.second.value);
+    }
+
+private:
+    std::size_t capacity;
+    Map items;
+    Ring ring;
+    typename Ring::iterator hand = ring.end();
+
+    static void Touch(const Item& item)
+    {
+        // Avoids writing to the cache line of a hot entry over and over.
+        if(!item.referenced.load(std::memory_order_relaxed))
+            item.referenced.store(true, std::memory_order_relaxed);
+    }
+
+    void Unlink(const Item& item)
+    {
+        if(hand == item.position)
+            ++hand;
+        ring.erase(item.position);
+    }
+
+    template <class TOnEvict>
+    void EvictOne(TOnEvict&& on_evict)
+    {
+        while(true)
+        {
+            if(hand == ring.end())
+                hand = ring.begin();
+
+            const auto it = items.find(**hand);
+            auto& item    = it->second;
+
+            if(item.referenced.exchange(false, std::memory_order_relaxed))
+            {
+                ++hand;
+                continue;
+            }
+
+            on_evict(it->first, item.value);
+            Unlink(item);
+            items.erase(it);
+            return;
+        }
+    }
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_CLOCK_MAP_HPP_
@@ -0,0 +1,106 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_LEASE_HPP_
+#define GUARD_MIOPEN_COMPILE_LEASE_HPP_
+
+#include <miopen/exp_backoff.hpp>
+#include <miopen/filesystem.hpp>
+#include <miopen/logger.hpp>
+
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+namespace miopen {
+
+struct TargetProperties;
+struct CompileLeaseSlot;
+
+/// Lets one of the processes and threads sharing the user kernel cache compile a kernel which
+/// is missing in it, while the others wait for the binary to appear in the cache instead of
+/// compiling it too. The lease is a file lock in the cache directory, one per kernel, so it is
+/// released by the OS if the compiling process dies. The lock file is removed when the last
+/// lease of the process on it is released.
+///
+/// The lease is disabled, and every caller compiles, if the cache is disabled or if the wait
+/// time set by MIOPEN_COMPILE_LEASE_TIMEOUT (seconds) is zero.
+class CompileLease
+{
+public:
+    CompileLease(const TargetProperties& target, const std::string& name, const std::string& args);
+    CompileLease(fs::path lock_path_, std::chrono::seconds timeout_);
+    ~CompileLease();
+
+    CompileLease(const CompileLease&) = delete;
+    CompileLease& operator=(const CompileLease&) = delete;
+
+    bool IsHeld() const { return held; }
+
+    /// Waits until either the binary is loaded by `load`, or this caller gets the lease. Returns
+    /// the result of `load`, which is empty if the caller should compile the kernel and store it.
+    /// The lease stays held until the object is destroyed, so that must happen after the binary
+    /// is stored. If the wait times out, the caller compiles without the lease.
+    template <class TLoad>
+    auto Wait(TLoad&& load) -> decltype(load())
+    {
+        if(lock_path.empty())
+            return {};
+
+        auto exp_bo = LazyExponentialBackoff{10, 2, timeout};
+        while(exp_bo)
+        {
+            if(TryAcquire())
+                return load(); // The owner of the previous lease may have just stored it.
+
+            auto binary = load();
+            if(!binary.empty())
+            {
+                MIOPEN_LOG_I2("Loaded the binary compiled under the lease " << lock_path);
+                return binary;
+            }
+
+            const auto slot = *exp_bo;
+            std::this_thread::sleep_for(std::chrono::milliseconds(slot));
+        }
+
+        MIOPEN_LOG_W("Timeout while waiting for the compilation of " << lock_path);
+        return {};
+    }
+
+private:
+    fs::path lock_path;
+    std::chrono::seconds timeout;
+    CompileLeaseSlot* slot = nullptr;
+    std::unique_lock<std::mutex> thread_lock;
+    bool held = false;
+
+    bool TryAcquire();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_LEASE_HPP_
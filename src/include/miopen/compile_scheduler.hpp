@@ -0,0 +1,100 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_COMPILE_SCHEDULER_HPP_
+#define GUARD_MIOPEN_COMPILE_SCHEDULER_HPP_
+
+#include <miopen/config.h>
+#include <miopen/export.h>
+#include <miopen/kernel_info.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Records the time the program took to build, see CompileTimer.
+MIOPEN_EXPORT void RecordCompileTime(const std::string& program_name, float ms);
+
+/// Estimates the build time of the program by the latest build of the same source file, with
+/// any options, or by the language of the source, if the file was not built in the process yet.
+MIOPEN_EXPORT float EstimateCompileTime(const std::string& program_name);
+
+namespace solver {
+
+struct CompileJob;
+
+/// Builds the programs of the kernels of a Find in the ThreadPool, in the background, so that the
+/// solutions whose kernels are ready can be benchmarked meanwhile.
+///
+/// Each program is built once. The duplicates within and across the batches of Start() are
+/// skipped, and a program which is being built by another scheduler in the process, e.g. for a
+/// Find in another thread, is waited for and then loaded from the kernel cache. The builds which
+/// are expected to take the longest, see EstimateCompileTime(), start first, so that a slow
+/// kernel is not left for the end.
+class MIOPEN_EXPORT CompileScheduler
+{
+public:
+    /// Builds the program of the kernel and stores it where the kernel is looked up.
+    using Build = std::function<void(const KernelInfo&)>;
+
+    /// Builds with Handle::LoadProgram() into the kernel cache of the handle, by up to
+    /// `threads` threads.
+    CompileScheduler(const Handle& h, std::size_t threads);
+    /// `target` distinguishes the builds of different devices in the process.
+    CompileScheduler(std::string target, std::size_t threads, Build build);
+    ~CompileScheduler();
+
+    CompileScheduler(const CompileScheduler&) = delete;
+    CompileScheduler& operator=(const CompileScheduler&) = delete;
+
+    /// Starts the builds of the kernels which are not started yet. The caller skips the kernels
+    /// which are in the cache already.
+    void Start(const std::vector<KernelInfo>& kernels);
+    /// Blocks until the programs of the kernels are built. Rethrows the build error of the first
+    /// failed one. The kernels which were not started are ignored.
+    void Wait(const std::vector<KernelInfo>& kernels);
+    void WaitAll();
+
+private:
+    std::string target;
+    std::size_t threads;
+    Build build;
+    std::map<std::string, std::shared_ptr<CompileJob>> jobs;
+    std::vector<std::thread> runners;
+
+    std::string MakeKey(const KernelInfo& kernel) const;
+    void Wait(CompileJob& job);
+};
+
+} // namespace solver
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_COMPILE_SCHEDULER_HPP_
@@ -31,6 +31,7 @@
 #include <miopen/names.hpp>
 
 #include <miopen/problem_description_base.hpp>
+#include <miopen/problem_key.hpp>
 #include <miopen/tensor.hpp>
 #include <miopen/convolution.hpp>
 
@@ -398,6 +399,10 @@ struct ProblemDescription : ProblemDescriptionBase
 
     void HeuristicUpdateLayouts();
 
+    /// Binary key of the problem. Problems with equal keys have equal network configs and db
+    /// keys.
+    ProblemKey MakeKey() const;
+
     void MakeNetworkConfig(std::string& conf_key) const;
 
     NetworkConfig MakeNetworkConfig() const override
@@ -470,6 +475,8 @@ struct ProblemDescription : ProblemDescriptionBase
     void SetupFloats(ExecutionContext& ctx) const;
 
 private:
+    void MakeNetworkConfigText(std::string& conf_key) const;
+
     TensorDescriptor in;
     TensorDescriptor weights;
     TensorDescriptor out;
@@ -89,7 +89,14 @@ struct ConvSolution
 
 std::ostream& operator<<(std::ostream& os, const ConvSolution& s);
 
+class CompileScheduler;
+
+/// Builds the programs of the solutions which are not in the cache of the handle.
 void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols);
+/// Starts the builds in the scheduler and returns.
+void PrecompileSolutions(const Handle& h,
+                         const std::vector<const ConvSolution*>& sols,
+                         CompileScheduler& scheduler);
 
 } // namespace solver
 } // namespace miopen
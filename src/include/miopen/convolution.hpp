@@ -330,7 +330,7 @@ struct MIOPEN_EXPORT ConvolutionDescriptor : miopenConvolutionDescriptor
                                      std::size_t workSpaceSize,
                                      bool exhaustiveSearch) const;
 
-    void ConvolutionBackwardWeights(const Handle& handle,
+    void ConvolutionBackwardWeights(Handle& handle,
                                     const void* alpha,
                                     const TensorDescriptor& dyDesc,
                                     ConstData_t dy,
@@ -27,6 +27,8 @@
 #define GUARD_MIOPEN_DB_HPP_
 
 #include <miopen/db_record.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/env.hpp>
 #include <miopen/rank.hpp>
 
 #include <boost/core/explicit_operator_bool.hpp>
@@ -34,7 +36,16 @@
 #include <boost/optional/optional.hpp>
 
 #include <chrono>
+#include <cstdint>
+#include <exception>
 #include <string>
+#include <utility>
+#include <vector>
+
+/// Appends updates of user dbs to a journal instead of rewriting the db files.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_USER_DB_JOURNAL)
+/// Size of a journal, in bytes, that triggers its compaction into the db file.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_USER_DB_JOURNAL_LIMIT, uint64_t, 1024 * 1024)
 
 namespace miopen {
 
@@ -44,16 +55,103 @@ struct RecordPositions
     std::streamoff end   = -1;
 };
 
+class DbFileIndex;
 class LockFile;
 
 constexpr bool DisableUserDbFileIO = MIOPEN_DISABLE_USERDB;
 
+struct DbChange
+{
+    DbRecord record;
+    bool merge; // UpdateRecord() if true, StoreRecord() otherwise.
+};
+
+/// Buffers writes to a text db and commits them at once, under a single lock of the
+/// db file and with at most one rewrite of it. Buffered records are not visible to
+/// lookups until the batch is committed. The batch is committed on destruction.
+template <class TDb>
+class DbBatch
+{
+public:
+    DbBatch(TDb& db_, DbKinds db_kind_) : db(&db_), db_kind(db_kind_) {}
+    DbBatch(DbBatch&& other) noexcept
+        : db(std::exchange(other.db, nullptr)),
+          db_kind(other.db_kind),
+          changes(std::move(other.changes))
+    {
+    }
+    DbBatch(const DbBatch&) = delete;
+    DbBatch& operator=(const DbBatch&) = delete;
+    DbBatch& operator=(DbBatch&&) = delete;
+
+    ~DbBatch()
+    {
+        try
+        {
+            if(!Commit())
+                MIOPEN_LOG_E("Failed to commit a batch of db records");
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Failed to commit a batch of db records: " << ex.what());
+        }
+    }
+
+    bool StoreRecord(const DbRecord& record)
+    {
+        changes.push_back({record, false});
+        return true;
+    }
+
+    bool UpdateRecord(DbRecord& record)
+    {
+        changes.push_back({record, true});
+        return true;
+    }
+
+    /// Unlike the db, returns the buffered record without values of the stored one.
+    template <class T, class V>
+    boost::optional<DbRecord>
+    Update(const T& problem_config, const std::string& id, const V& values)
+    {
+        DbRecord record(db_kind, problem_config);
+        record.SetValues(id, values);
+        changes.push_back({record, true});
+        return record;
+    }
+
+    std::size_t Size() const { return changes.size(); }
+
+    bool Commit()
+    {
+        if(db == nullptr || changes.empty())
+            return true;
+        auto committed = std::move(changes);
+        changes.clear();
+        const auto ok = db->CommitBatch(committed);
+        if(ok)
+            DbStats::Get(db_kind).AddStore(committed.size());
+        return ok;
+    }
+
+private:
+    TDb* db;
+    DbKinds db_kind;
+    std::vector<DbChange> changes;
+};
+
 /// No instance of this class should be used from several threads at the same time.
 class PlainTextDb
 {
 public:
     PlainTextDb(DbKinds db_kind_, const std::string& filename_, bool is_system = false);
 
+    /// In journal mode (see MIOPEN_DEBUG_USER_DB_JOURNAL) records are not updated in place.
+    /// Each change is appended to the journal file instead, and a removal is recorded as
+    /// KEY= line. Lookups prefer the journal to the db file. The journal is merged into
+    /// the db file once it grows over the limit, or by the first write in normal mode.
+    static std::string GetJournalPath(const std::string& filename) { return filename + ".journal"; }
+
     /// Searches db for provided key and returns found record or none if key not found in database
     boost::optional<DbRecord> FindRecord(const std::string& key);
 
@@ -103,6 +201,14 @@ public:
         return RemoveRecord(key);
     }
 
+    /// Starts buffering of writes, see DbBatch.
+    DbBatch<PlainTextDb> BeginBatch() { return {*this, db_kind}; }
+
+    /// Applies the changes in order under a single lock.
+    ///
+    /// Returns true if all the records were written, false otherwise.
+    bool CommitBatch(const std::vector<DbChange>& changes);
+
     /// Updates record under key PROBLEM_CONFIG with data ID:VALUES in database.
     /// Both T and V classes should have "void Serialize(std::ostream&) const" member function
     /// available.
@@ -147,13 +253,21 @@ protected:
     bool StoreRecordUnsafe(const DbRecord& record);
     bool UpdateRecordUnsafe(DbRecord& record);
     bool RemoveRecordUnsafe(const std::string& key);
+    /// Returns the resulting records via the second parameter, once per key.
+    bool CommitBatchUnsafe(const std::vector<DbChange>& changes, std::vector<DbRecord>& results);
 
 private:
     std::string filename;
     LockFile& lock_file;
+    DbFileIndex& index;
+    DbFileIndex& journal_index;
     const bool warning_if_unreadable;
 
     bool FlushUnsafe(const DbRecord& record, const RecordPositions* pos);
+    bool FlushBatchUnsafe(const std::vector<DbRecord>& records,
+                          const std::vector<RecordPositions>& positions);
+    bool AppendToJournalUnsafe(const std::vector<const DbRecord*>& records);
+    bool CompactJournalUnsafe();
 
     template <class T>
     inline boost::optional<DbRecord> FindRecordUnsafe(const T& problem_config)
@@ -258,6 +372,8 @@ public:
         return _user.Remove(args...);
     }
 
+    auto BeginBatch() { return _user.BeginBatch(); }
+
 private:
     template <class TDb, class TRet = decltype(TDb::GetCached(DbKinds::FindDb, "", true))>
     static TRet
@@ -285,31 +401,87 @@ private:
 #endif
 };
 
+/// Reads through the db and buffers the writes in the batch, so that the code written
+/// against a db, e.g. FindSolution(), may be used with a batch.
+template <class TDb, class TBatch>
+class DbWithBatch
+{
+public:
+    DbWithBatch(TDb& db_, TBatch& batch_) : db(db_), batch(batch_) {}
+
+    template <typename... U>
+    auto FindRecord(const U&... args)
+    {
+        return db.FindRecord(args...);
+    }
+
+    template <typename... U>
+    auto StoreRecord(U&... args)
+    {
+        return batch.StoreRecord(args...);
+    }
+
+    template <typename... U>
+    auto UpdateRecord(U&... args)
+    {
+        return batch.UpdateRecord(args...);
+    }
+
+    template <typename... U>
+    auto RemoveRecord(const U&... args)
+    {
+        return db.RemoveRecord(args...);
+    }
+
+    template <typename... U>
+    auto Update(const U&... args)
+    {
+        return batch.Update(args...);
+    }
+
+    template <typename... U>
+    bool Load(U&... args)
+    {
+        return db.Load(args...);
+    }
+
+    template <typename... U>
+    bool Remove(const U&... args)
+    {
+        return db.Remove(args...);
+    }
+
+private:
+    TDb& db;
+    TBatch& batch;
+};
+
 template <class TInnerDb>
 class DbTimer
 {
 public:
     template <class... TArgs>
-    DbTimer(TArgs&&... args) : inner(args...)
+    DbTimer(DbKinds db_kind, TArgs&&... args)
+        : inner(db_kind, args...), stats(&DbStats::Get(db_kind))
     {
     }
 
     template <typename... U>
     auto FindRecord(const U&... args)
     {
-        return Measure("FindRecord", [&]() { return inner.FindRecord(args...); });
+        return MeasureLookup("FindRecord", [&]() { return inner.FindRecord(args...); });
     }
 
     template <typename... U>
     auto StoreRecord(U&... record)
     {
-        return Measure("StoreRecord", [&]() { return inner.StoreRecord(record...); });
+        return MeasureStore("StoreRecord", [&]() { return inner.StoreRecord(record...); });
     }
 
     template <typename... U>
     auto UpdateRecord(U&... args)
     {
-        return Measure("UpdateRecord", [&]() { return inner.UpdateRecord(args...); });
+        return MeasureStore("UpdateRecord", [&]() { return inner.UpdateRecord(args...); });
     }
 
     template <typename... U>
@@ -321,13 +493,13 @@ public:
     template <typename... U>
     auto Update(const U&... args)
     {
-        return Measure("Update", [&]() { return inner.Update(args...); });
+        return MeasureStore("Update", [&]() { return inner.Update(args...); });
     }
 
     template <typename... U>
     bool Load(U&... args)
     {
-        return Measure("Load", [&]() { return inner.Load(args...); });
+        return MeasureLookup("Load", [&]() { return inner.Load(args...); });
     }
 
     template <typename... U>
@@ -336,8 +508,11 @@ public:
         return Measure("Remove", [&]() { return inner.Remove(args...); });
     }
 
+    auto BeginBatch() { return inner.BeginBatch(); }
+
 private:
     TInnerDb inner;
+    DbStats* stats;
 
     template <class TFunc>
     static auto Measure(const std::string& funcName, TFunc&& func)
@@ -351,6 +526,21 @@ private:
         MIOPEN_LOG_I2("Db::" << funcName << " time: " << (end - start).count() * .000001f << " ms");
         return ret;
     }
+
+    template <class TFunc>
+    auto MeasureLookup(const std::string& funcName, TFunc&& func)
+    {
+        return Measure(funcName, [&]() { return stats->MeasureLookup(func); });
+    }
+
+    template <class TFunc>
+    auto MeasureStore(const std::string& funcName, TFunc&& func)
+    {
+        auto ret = Measure(funcName, func);
+        if(static_cast<bool>(ret))
+            stats->AddStore();
+        return ret;
+    }
 };
 } // namespace miopen
 
@@ -0,0 +1,356 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_BINARY_FORMAT_HPP_
+#define GUARD_MIOPEN_DB_BINARY_FORMAT_HPP_
+
+// This header is shared with the tools and must depend on the standard library only.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace binary_db {
+
+/// Binary representation of a text perf-db or find-db (see db_record.hpp for the text format).
+/// Records are pre-split into the key and a list of (ID, VALUES) items, so loading the db does
+/// not scan the text and a lookup does not split the record. VALUES are kept as is, as their
+/// format is Solver-specific.
+///
+/// Layout, all integers are in the host byte order (little-endian on the supported platforms):
+///   Header
+///   Record[header.record_count], sorted by key
+///   Item[header.item_count], items of a record are contiguous
+///   char[header.strings_size], keys, IDs and VALUES without terminators
+///
+/// The format is versioned. A reader shall reject the files of unknown versions.
+constexpr char magic[8]       = {'M', 'I', 'O', 'P', 'E', 'N', 'D', 'B'};
+constexpr std::uint32_t version = 1;
+
+struct String
+{
+    std::uint32_t offset; // from the beginning of the strings section
+    std::uint32_t size;
+};
+
+struct Header
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t record_count;
+    std::uint32_t item_count;
+    std::uint32_t strings_size;
+};
+
+struct Record
+{
+    String key;
+    std::uint32_t first_item;
+    std::uint32_t item_count;
+};
+
+struct Item
+{
+    String id;
+    String values;
+};
+
+/// A record as it is stored in a text db.
+struct SourceRecord
+{
+    std::string key;
+    std::vector<std::pair<std::string, std::string>> items;
+};
+
+/// Read-only view of a binary db. Does not own the data.
+class View
+{
+public:
+    static bool IsBinary(std::string_view data)
+    {
+        return data.size() >= sizeof(magic) && std::memcmp(data.data(), magic, sizeof(magic)) == 0;
+    }
+
+    /// Returns none and sets the error if the data is not a valid binary db.
+    static std::optional<View> Open(std::string_view data, std::string& error)
+    {
+        if(!IsBinary(data) || data.size() < sizeof(Header))
+        {
+            error = "not a binary db";
+            return std::nullopt;
+        }
+
+        auto view = View{};
+        view.data = data;
+        std::memcpy(&view.header, data.data(), sizeof(Header));
+
+        if(view.header.version != version)
+        {
+            error = "unsupported binary db version " + std::to_string(view.header.version);
+            return std::nullopt;
+        }
+
+        const auto expected_size = sizeof(Header) +
+                                   std::uint64_t{view.header.record_count} * sizeof(Record) +
+                                   std::uint64_t{view.header.item_count} * sizeof(Item) +
+                                   view.header.strings_size;
+        if(data.size() != expected_size)
+        {
+            error = "binary db size mismatch";
+            return std::nullopt;
+        }
+
+        for(std::uint32_t i = 0; i < view.header.record_count; ++i)
+        {
+            const auto record = view.GetRecord(i);
+            if(!view.IsValid(record.key) ||
+               std::uint64_t{record.first_item} + record.item_count > view.header.item_count)
+            {
+                error = "ill-formed record #" + std::to_string(i);
+                return std::nullopt;
+            }
+        }
+
+        for(std::uint32_t i = 0; i < view.header.item_count; ++i)
+        {
+            const auto item = view.GetItem(i);
+            if(!view.IsValid(item.id) || !view.IsValid(item.values))
+            {
+                error = "ill-formed item #" + std::to_string(i);
+                return std::nullopt;
+            }
+        }
+
+        return view;
+    }
+
+    std::size_t GetRecordCount() const { return header.record_count; }
+
+    Record GetRecord(std::size_t idx) const
+    {
+        return Read<Record>(sizeof(Header) + idx * sizeof(Record));
+    }
+
+    Item GetItem(std::size_t idx) const
+    {
+        return Read<Item>(sizeof(Header) + header.record_count * sizeof(Record) +
+                          idx * sizeof(Item));
+    }
+
+    std::string_view GetString(const String& str) const
+    {
+        const auto strings = sizeof(Header) + header.record_count * sizeof(Record) +
+                             header.item_count * sizeof(Item);
+        return data.substr(strings + str.offset, str.size);
+    }
+
+    std::optional<Record> Find(std::string_view key) const
+    {
+        auto first = std::size_t{0};
+        auto count = GetRecordCount();
+
+        while(count > 0)
+        {
+            const auto step   = count / 2;
+            const auto middle = first + step;
+            if(GetString(GetRecord(middle).key) < key)
+            {
+                first = middle + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+
+        if(first == GetRecordCount())
+            return std::nullopt;
+        const auto record = GetRecord(first);
+        if(GetString(record.key) != key)
+            return std::nullopt;
+        return record;
+    }
+
+    /// Calls f(id, values) for every item of the record.
+    template <class TFunc>
+    void ForEachItem(const Record& record, TFunc&& f) const
+    {
+        for(auto i = record.first_item; i < record.first_item + record.item_count; ++i)
+        {
+            const auto item = GetItem(i);
+            f(GetString(item.id), GetString(item.values));
+        }
+    }
+
+    /// Writes the record in the text format, without the trailing newline.
+    void WriteText(const Record& record, std::ostream& out) const
+    {
+        out << GetString(record.key) << '=';
+        WriteIdsAndValues(record, out);
+    }
+
+    /// Writes the items of the record in the text format.
+    void WriteIdsAndValues(const Record& record, std::ostream& out) const
+    {
+        auto first = true;
+        ForEachItem(record, [&](std::string_view id, std::string_view values) {
+            if(!first)
+                out << ';';
+            out << id << ':' << values;
+            first = false;
+        });
+    }
+
+private:
+    std::string_view data;
+    Header header{};
+
+    template <class T>
+    T Read(std::size_t offset) const
+    {
+        // The data may be not aligned, e.g. if it is embedded into the binary.
+        T ret;
+        std::memcpy(&ret, data.data() + offset, sizeof(T));
+        return ret;
+    }
+
+    bool IsValid(const String& str) const
+    {
+        return std::uint64_t{str.offset} + str.size <= header.strings_size;
+    }
+};
+
+/// Splits a record of the text format. Returns false if the key is not found.
+/// Items without an ID and duplicate IDs are skipped.
+inline bool ParseTextRecord(std::string_view line, SourceRecord& record)
+{
+    const auto key_size = line.find('=');
+    if(key_size == std::string_view::npos || key_size == 0)
+        return false;
+
+    record.key = std::string{line.substr(0, key_size)};
+    record.items.clear();
+    auto contents = line.substr(key_size + 1);
+
+    while(!contents.empty())
+    {
+        const auto item_size = std::min(contents.find(';'), contents.size());
+        const auto item      = contents.substr(0, item_size);
+        contents.remove_prefix(std::min(item_size + 1, contents.size()));
+
+        const auto id_size = item.find(':');
+        if(id_size == std::string_view::npos || id_size == 0)
+            continue;
+
+        const auto id = item.substr(0, id_size);
+        if(std::any_of(record.items.begin(), record.items.end(), [&](auto&& other) {
+               return other.first == id;
+           }))
+            continue;
+
+        record.items.emplace_back(id, item.substr(id_size + 1));
+    }
+
+    return true;
+}
+
+/// Writes the records in the binary format. Records are sorted by key; if a key is repeated,
+/// the first record wins, as it does in the text db. Repeated strings (e.g. Solver IDs) are
+/// stored once. Throws std::length_error if the db is too large for the format.
+inline void Write(std::vector<SourceRecord> records, std::ostream& out)
+{
+    std::stable_sort(records.begin(), records.end(), [](auto&& left, auto&& right) {
+        return left.key < right.key;
+    });
+    records.erase(std::unique(records.begin(),
+                              records.end(),
+                              [](auto&& left, auto&& right) { return left.key == right.key; }),
+                  records.end());
+
+    auto strings     = std::string{};
+    auto string_ids  = std::unordered_map<std::string, String>{};
+    const auto limit = std::uint64_t{std::numeric_limits<std::uint32_t>::max()};
+
+    const auto add_string = [&](const std::string& str) {
+        const auto it = string_ids.find(str);
+        if(it != string_ids.end())
+            return it->second;
+        if(strings.size() + str.size() > limit)
+            throw std::length_error("binary db strings section is too large");
+        const auto ret = String{static_cast<std::uint32_t>(strings.size()),
+                                static_cast<std::uint32_t>(str.size())};
+        strings.append(str);
+        string_ids.emplace(str, ret);
+        return ret;
+    };
+
+    auto out_records = std::vector<Record>{};
+    auto out_items   = std::vector<Item>{};
+    out_records.reserve(records.size());
+
+    for(const auto& record : records)
+    {
+        if(out_items.size() + record.items.size() > limit)
+            throw std::length_error("binary db has too many items");
+
+        out_records.push_back({add_string(record.key),
+                               static_cast<std::uint32_t>(out_items.size()),
+                               static_cast<std::uint32_t>(record.items.size())});
+        for(const auto& item : record.items)
+            out_items.push_back({add_string(item.first), add_string(item.second)});
+    }
+
+    if(out_records.size() > limit)
+        throw std::length_error("binary db has too many records");
+
+    auto header = Header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.version      = version;
+    header.record_count = static_cast<std::uint32_t>(out_records.size());
+    header.item_count   = static_cast<std::uint32_t>(out_items.size());
+    header.strings_size = static_cast<std::uint32_t>(strings.size());
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(out_records.data()),
+              out_records.size() * sizeof(Record));
+    out.write(reinterpret_cast<const char*>(out_items.data()), out_items.size() * sizeof(Item));
+    out.write(strings.data(), strings.size());
+}
+
+} // namespace binary_db
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_BINARY_FORMAT_HPP_
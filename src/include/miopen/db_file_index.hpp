@@ -0,0 +1,168 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_FILE_INDEX_HPP_
+#define GUARD_MIOPEN_DB_FILE_INDEX_HPP_
+
+#include <miopen/filesystem.hpp>
+#include <miopen/mapped_file.hpp>
+
+#include <cstdint>
+#include <ios>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace miopen {
+
+/// Sorted index of the records of a text db, i.e. of its KEY=CONTENTS lines.
+/// Only the key boundaries are parsed. Keys and contents are views into the
+/// indexed text, which shall outlive the index.
+///
+/// A journal of a db is indexed the other way around: the last record with a key
+/// wins, and a record with empty contents is a tombstone of a removed record.
+class DbTextIndex
+{
+public:
+    enum class Kind
+    {
+        UserDb,   ///< Records with empty contents are ill-formed and skipped.
+        SystemDb, ///< Records with empty contents are kept, as ReadonlyRamDb always did.
+        Journal,
+    };
+
+    struct Entry
+    {
+        std::string_view key;
+        std::string_view contents;
+        std::streamoff begin;
+        std::streamoff end;
+        int line;
+    };
+
+    DbTextIndex() = default;
+    /// The path is only used for logging.
+    DbTextIndex(std::string_view text, const std::string& path, Kind kind);
+    /// Index of a journal extended by the records appended to it, i.e. only the text from the
+    /// offset is parsed. The text shall start with the text of the base index.
+    DbTextIndex(const DbTextIndex& base,
+                std::string_view text,
+                std::size_t from,
+                const std::string& path);
+
+    /// Returns the first (the last for a journal) well-formed record with the key
+    /// or nullptr if there is none.
+    const Entry* Find(std::string_view key) const;
+
+    const std::vector<Entry>& GetEntries() const { return entries; }
+
+private:
+    std::vector<Entry> entries;
+    int lines = 0;
+
+    void Parse(std::string_view text, std::size_t from, const std::string& path, Kind kind);
+    void Sort(bool is_journal);
+};
+
+/// Key index of a text db file. Replaces a linear scan of the file on each lookup
+/// with a binary search over the keys of a memory-mapped copy of the file.
+///
+/// The index is shared by all PlainTextDb objects targeting the same file. It is
+/// rebuilt lazily when the size or the modification time of the file changes,
+/// i.e. when some other process has written to the file. Writers of the current
+/// process invalidate it explicitly, or extend it after appending to a journal.
+/// A write of the same size made within the timestamp granularity of the file
+/// system keeps the modification time, so until the file is older than that, its
+/// contents are hashed and compared as well.
+class DbFileIndex
+{
+public:
+    class Snapshot
+    {
+    public:
+        const DbTextIndex::Entry* Find(std::string_view key) const { return index.Find(key); }
+        const std::vector<DbTextIndex::Entry>& GetEntries() const { return index.GetEntries(); }
+
+    private:
+        MappedFile mapping;
+        std::string buffer; // Used if the file cannot be mapped.
+        DbTextIndex index;
+        std::uintmax_t file_size = 0;
+        fs::file_time_type write_time;
+        std::size_t content_hash = 0;
+
+        friend class DbFileIndex;
+    };
+
+    DbFileIndex(const DbFileIndex&) = delete;
+    DbFileIndex& operator=(const DbFileIndex&) = delete;
+
+    /// Journal flag of the index is set by the first call for the path.
+    static DbFileIndex& Get(const std::string& path, bool is_journal = false);
+
+    /// Returns up-to-date index of the file or nullptr if the file is unreadable.
+    /// Returned snapshot stays valid after the file is changed.
+    /// Shall be called with the db file lock acquired at least in shared mode.
+    std::shared_ptr<const Snapshot> Acquire();
+
+    /// Drops the index, so it is rebuilt on the next call of Acquire().
+    /// Shall be called with the db file lock acquired exclusively.
+    void Invalidate();
+
+    /// Extends the index of a journal by the records appended to the file since the base
+    /// snapshot was acquired, or drops the index if it is not the base anymore.
+    /// Shall be called with the db file lock acquired exclusively since the base was acquired.
+    void Extend(const std::shared_ptr<const Snapshot>& base);
+
+private:
+    struct PassKey
+    {
+    };
+
+public:
+    DbFileIndex(const std::string& path_, bool is_journal_, PassKey)
+        : path(path_), is_journal(is_journal_)
+    {
+    }
+
+private:
+    std::string path;
+    bool is_journal;
+    std::mutex mutex;
+    std::shared_ptr<const Snapshot> snapshot;
+    /// The contents of the snapshot are known to match the file at this time.
+    fs::file_time_type verified_time;
+
+    bool IsRacy(const fs::file_time_type& write_time) const;
+    std::shared_ptr<const Snapshot> Build(std::uintmax_t file_size,
+                                          const fs::file_time_type& write_time,
+                                          const std::shared_ptr<const Snapshot>& previous);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_FILE_INDEX_HPP_
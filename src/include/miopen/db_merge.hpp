@@ -0,0 +1,174 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_MERGE_HPP_
+#define GUARD_MIOPEN_DB_MERGE_HPP_
+
+// This header is shared with the tools and must depend on the standard library only.
+
+#include <miopen/db_binary_format.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace miopen {
+namespace db_merge {
+
+/// Selects the item kept when several dbs have the same ID under the same KEY.
+enum class Conflict
+{
+    /// The item of the db added first wins, as the user db wins over the system one in
+    /// MultiFileDb. Used for perf-dbs, as their VALUES are not comparable.
+    KeepFirst,
+    /// The item with the lowest time wins. Used for find-dbs, whose VALUES start with the
+    /// time of the solution (see FindDbData). Items with unreadable times never win.
+    KeepFastest,
+};
+
+struct Stats
+{
+    std::size_t records  = 0; ///< Records added.
+    std::size_t items    = 0; ///< Items added.
+    std::size_t replaced = 0; ///< Items replaced by a faster one.
+    std::size_t ignored  = 0; ///< Items lost to the kept ones.
+    std::size_t dropped  = 0; ///< Items with unknown IDs.
+};
+
+/// Returns the time of a find-db item, or infinity if VALUES do not start with a time.
+inline float GetFindDbTime(std::string_view values)
+{
+    const auto time = std::string{values.substr(0, values.find(','))};
+    char* end       = nullptr;
+    const auto ret  = std::strtof(time.c_str(), &end);
+    if(time.empty() || *end != '\0' || !(ret >= 0))
+        return std::numeric_limits<float>::infinity();
+    return ret;
+}
+
+/// Merges records of several dbs of the same kind into one db: the records with the same KEY
+/// are merged as DbRecord::Merge() does, with conflicting IDs resolved by the Conflict policy.
+class Merger
+{
+public:
+    /// Items, whose IDs are rejected by is_known_id, are dropped. All the IDs are kept if
+    /// is_known_id is empty.
+    Merger(Conflict conflict_, std::function<bool(const std::string&)> is_known_id_ = {})
+        : conflict(conflict_), is_known_id(std::move(is_known_id_))
+    {
+    }
+
+    void Add(binary_db::SourceRecord record)
+    {
+        ++stats.records;
+        const auto inserted = index.emplace(record.key, records.size());
+        if(inserted.second)
+            records.push_back({std::move(record.key), {}});
+        auto& items = records[inserted.first->second].items;
+
+        for(auto& item : record.items)
+        {
+            ++stats.items;
+            if(is_known_id && !is_known_id(item.first))
+            {
+                ++stats.dropped;
+                continue;
+            }
+
+            const auto it = std::find_if(items.begin(), items.end(), [&](auto&& other) {
+                return other.first == item.first;
+            });
+            if(it == items.end())
+            {
+                items.push_back(std::move(item));
+            }
+            else if(conflict == Conflict::KeepFastest &&
+                    GetFindDbTime(item.second) < GetFindDbTime(it->second))
+            {
+                it->second = std::move(item.second);
+                ++stats.replaced;
+            }
+            else
+            {
+                ++stats.ignored;
+            }
+        }
+    }
+
+    /// Returns the merged records sorted by KEY. Records left without items are skipped.
+    std::vector<binary_db::SourceRecord> Release()
+    {
+        auto ret = std::move(records);
+        records.clear();
+        index.clear();
+
+        ret.erase(std::remove_if(
+                      ret.begin(), ret.end(), [](auto&& record) { return record.items.empty(); }),
+                  ret.end());
+        std::sort(ret.begin(), ret.end(), [](auto&& left, auto&& right) {
+            return left.key < right.key;
+        });
+        return ret;
+    }
+
+    const Stats& GetStats() const { return stats; }
+
+private:
+    Conflict conflict;
+    std::function<bool(const std::string&)> is_known_id;
+    std::unordered_map<std::string, std::size_t> index;
+    std::vector<binary_db::SourceRecord> records;
+    Stats stats;
+};
+
+/// Writes the records in the text format, one record per line.
+inline void WriteText(const std::vector<binary_db::SourceRecord>& records, std::ostream& out)
+{
+    for(const auto& record : records)
+    {
+        out << record.key << '=';
+        auto first = true;
+        for(const auto& item : record.items)
+        {
+            if(!first)
+                out << ';';
+            out << item.first << ':' << item.second;
+            first = false;
+        }
+        out << '\n';
+    }
+}
+
+} // namespace db_merge
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_MERGE_HPP_
@@ -29,6 +29,8 @@
 #include <miopen/config.h>
 
 #include <miopen/logger.hpp>
+#include <miopen/problem_key.hpp>
+#include <miopen/rank.hpp>
 
 #include <cassert>
 #include <istream>
@@ -181,6 +183,23 @@ private:
     static // 'static' is for calling from ctor
         std::string
         SerializeKey(DbKinds db_kind, const T& data)
+    {
+        return SerializeKeyImpl(rank<1>{}, db_kind, data);
+    }
+
+    /// Problems having a binary key get their text keys from the cache.
+    template <class T>
+    static auto SerializeKeyImpl(rank<1>, DbKinds db_kind, const T& data)
+        -> decltype(data.MakeKey(), std::string{})
+    {
+        const auto form = db_kind == DbKinds::FindDb ? ProblemTextCache::Form::FindDbKey
+                                                     : ProblemTextCache::Form::PerfDbKey;
+        return ProblemTextCache::Get(form).GetOrBuild(
+            data.MakeKey(), [&]() { return SerializeKeyImpl(rank<0>{}, db_kind, data); });
+    }
+
+    template <class T>
+    static std::string SerializeKeyImpl(rank<0>, DbKinds db_kind, const T& data)
     {
         std::ostringstream ss;
         if(db_kind == DbKinds::FindDb)
@@ -199,6 +218,8 @@ private:
     }
 
     bool ParseContents(std::istream& contents);
+    /// Adds an already split ID:VALUES item. Returns false if the item is skipped.
+    bool AddItem(std::string id, std::string values);
     void WriteContents(std::ostream& stream) const;
     void WriteIdsAndValues(std::ostream& stream) const;
     bool SetValues(const std::string& id, const std::string& values);
@@ -227,6 +248,9 @@ public:
 
     auto GetSize() const { return map.size(); }
 
+    /// Size of the record in the text format, without the trailing newline.
+    std::size_t GetTextSize() const;
+
     const std::string& GetKey() const { return key; }
 
     /// Merges data from this record to data from that record if their keys are same.
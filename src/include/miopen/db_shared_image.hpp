@@ -0,0 +1,89 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_SHARED_IMAGE_HPP_
+#define GUARD_MIOPEN_DB_SHARED_IMAGE_HPP_
+
+#include <miopen/filesystem.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace miopen {
+
+/// A text db converted to the binary format (see db_binary_format.hpp) and kept in a POSIX
+/// shared memory segment, so the processes of a node share one parsed copy of a system db.
+/// Enabled by MIOPEN_DB_SHARED_CACHE.
+///
+/// The segment name is derived from the user, the path, the size and the modification time
+/// of the db file, so a changed file gets a new segment. The first process to miss the
+/// segment builds it, the others attach to it read-only and wait until it is complete.
+/// The builder holds a flock on the segment for the lifetime of its image, so the others
+/// can tell if it has died before completing the image.
+class SharedDbImage
+{
+public:
+    using TextLoader = std::function<boost::optional<std::string_view>()>;
+
+    static bool IsEnabled();
+
+    /// Attaches to the segment of the db file or builds it from the text returned by
+    /// load_text, which is called only if the segment does not exist. Returns nullptr if the
+    /// segment can be neither attached nor built, a private copy of the db shall be used then.
+    static std::unique_ptr<SharedDbImage> Open(const fs::path& db_path,
+                                               const TextLoader& load_text);
+
+    SharedDbImage(const SharedDbImage&) = delete;
+    SharedDbImage& operator=(const SharedDbImage&) = delete;
+    ~SharedDbImage();
+
+    /// The binary db. Shall be validated by the user, as any other binary db file.
+    std::string_view View() const;
+    const std::string& GetName() const { return name; }
+
+    /// Removes the segment, so the next Open builds it again. Existing mappings stay valid.
+    void Unlink() const;
+
+private:
+    std::string name;
+    void* address;
+    std::size_t size;
+    int owner_fd; // Holds the flock of the builder, or -1.
+
+    SharedDbImage(std::string name_, void* address_, std::size_t size_, int owner_fd_ = -1);
+
+    static std::unique_ptr<SharedDbImage> Attach(const std::string& name, bool& exists);
+    static std::unique_ptr<SharedDbImage>
+    Create(const std::string& name, const std::string& image, bool& exists);
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_SHARED_IMAGE_HPP_
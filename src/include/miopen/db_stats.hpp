@@ -0,0 +1,175 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_STATS_HPP_
+#define GUARD_MIOPEN_DB_STATS_HPP_
+
+#include <miopen/db_record.hpp>
+
+#include <boost/optional.hpp>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace miopen {
+
+/// Process-wide counters of the db accesses, one set per kind of db. Lookups, hits, misses
+/// and successful stores are counted by DbTimer for the perf-db, find-db and kernel db, and by AnyRamDb
+/// for the TunaNet cache. Bytes read are the sizes of the records returned by the lookups in
+/// the individual db files, so a lookup in a MultiFileDb may read both files.
+///
+/// The in-memory caches also report the number of entries they have evicted and the approximate
+/// size of the data they hold, not counting the file mappings. The invoker and kernel caches of
+/// the handles are counted as kinds of their own.
+///
+/// If MIOPEN_DB_STATS_JSON is set, the stats are written to that file at the process exit,
+/// with %p in the path replaced by the process id. Applications read them with
+/// miopenGetDbStats().
+class DbStats
+{
+public:
+    /// Lookup latency histogram. Bucket i counts the lookups that took less than 2^i
+    /// microseconds, the last bucket counts the rest.
+    static constexpr std::size_t latency_buckets = 24;
+
+    /// The values match miopenDbKind_t.
+    enum class Kind : std::uint8_t
+    {
+        FindDb,
+        PerfDb,
+        KernelDb,
+        AnyRamDb,
+        InvokerCache,
+        KernelCache,
+    };
+
+    static constexpr std::size_t kinds = 6;
+
+    struct Snapshot
+    {
+        std::uint64_t lookups       = 0;
+        std::uint64_t hits          = 0;
+        std::uint64_t misses        = 0;
+        std::uint64_t stores        = 0;
+        std::uint64_t bytes_read    = 0;
+        std::uint64_t lookup_ns     = 0;
+        std::uint64_t evictions     = 0;
+        std::int64_t resident_bytes = 0;
+        std::array<std::uint64_t, latency_buckets> lookup_latency{};
+    };
+
+    static DbStats& Get(Kind kind);
+    static DbStats& Get(DbKinds kind);
+    static const char* GetName(Kind kind);
+
+    /// Stats of all the kinds of dbs as a JSON object.
+    static std::string ToJson();
+    static void ResetAll();
+
+    void AddLookup(bool hit, std::chrono::steady_clock::duration time);
+    void AddStore(std::size_t count = 1) { stores.fetch_add(count, std::memory_order_relaxed); }
+    void AddEvictions(std::size_t count = 1)
+    {
+        evictions.fetch_add(count, std::memory_order_relaxed);
+    }
+    void AddResidentBytes(std::ptrdiff_t size)
+    {
+        resident_bytes.fetch_add(size, std::memory_order_relaxed);
+    }
+    void AddBytesRead(std::size_t size) { bytes_read.fetch_add(size, std::memory_order_relaxed); }
+    void AddBytesRead(const boost::optional<DbRecord>& record)
+    {
+        if(record)
+            AddBytesRead(record->GetTextSize());
+    }
+    void AddBytesRead(const boost::optional<std::string>& record)
+    {
+        if(record)
+            AddBytesRead(record->size());
+    }
+
+    Snapshot GetSnapshot() const;
+    /// Resets the counters. The resident bytes describe the current state and are kept.
+    void Reset();
+
+    /// Measures the lookup done by func, which returns something convertible to bool.
+    template <class TFunc>
+    auto MeasureLookup(TFunc&& func)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        auto ret         = func();
+        AddLookup(static_cast<bool>(ret), std::chrono::steady_clock::now() - start);
+        return ret;
+    }
+
+private:
+    std::atomic<std::uint64_t> lookups{0};
+    std::atomic<std::uint64_t> hits{0};
+    std::atomic<std::uint64_t> stores{0};
+    std::atomic<std::uint64_t> bytes_read{0};
+    std::atomic<std::uint64_t> lookup_ns{0};
+    std::atomic<std::uint64_t> evictions{0};
+    std::atomic<std::int64_t> resident_bytes{0};
+    std::array<std::atomic<std::uint64_t>, latency_buckets> lookup_latency{};
+};
+
+/// Resident bytes of one cache object. They are added to the resident bytes of the kind and
+/// subtracted when the object is destroyed, so the caches owned by the handles may come and go.
+class DbResidentBytes
+{
+public:
+    explicit DbResidentBytes(DbStats::Kind kind_) : kind(kind_) {}
+
+    DbResidentBytes(DbResidentBytes&& other) noexcept
+        : kind(other.kind), size(other.size.exchange(0))
+    {
+    }
+
+    DbResidentBytes(const DbResidentBytes&) = delete;
+    DbResidentBytes& operator=(const DbResidentBytes&) = delete;
+    DbResidentBytes& operator=(DbResidentBytes&&) = delete;
+
+    ~DbResidentBytes() { DbStats::Get(kind).AddResidentBytes(-size.load()); }
+
+    void Add(std::ptrdiff_t delta)
+    {
+        size.fetch_add(delta, std::memory_order_relaxed);
+        DbStats::Get(kind).AddResidentBytes(delta);
+    }
+
+    std::ptrdiff_t Get() const { return size.load(std::memory_order_relaxed); }
+
+private:
+    DbStats::Kind kind;
+    std::atomic<std::ptrdiff_t> size{0};
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_STATS_HPP_
@@ -0,0 +1,103 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
+#define GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
+
+#include <miopen/db.hpp>
+#include <miopen/env.hpp>
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+/// Writes the user db updates from a background thread, see DbWriteQueue.
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DB_WRITE_BEHIND)
+/// Number of records queued for writing that blocks the writers.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DB_WRITE_BEHIND_LIMIT, uint64_t, 4096)
+
+namespace miopen {
+
+class RamDb;
+
+/// Background writer of the User Db updates, enabled by MIOPEN_DB_WRITE_BEHIND. RamDb applies
+/// an update to its in-process cache, so lookups see it at once, and queues it here instead of
+/// writing the file in the calling thread. A dedicated thread writes the queued updates of each
+/// db as one batch. Updates of the same record are coalesced while they wait. The queue is
+/// bounded by MIOPEN_DB_WRITE_BEHIND_LIMIT records: a writer blocks while it is full. Pending
+/// updates are written at the process exit.
+class DbWriteQueue
+{
+public:
+    static bool IsEnabled();
+    static DbWriteQueue& Get();
+
+    DbWriteQueue(const DbWriteQueue&) = delete;
+    DbWriteQueue& operator=(const DbWriteQueue&) = delete;
+
+    /// Blocks while the queue is full.
+    void WaitForSpace();
+    /// Queues all the changes or, if the queue is stopped at the exit, none of them and returns
+    /// false. Then the caller writes the changes.
+    bool Push(RamDb& db, const std::vector<DbChange>& changes);
+    /// Calls f() for the changes of the db that are not written yet, in the order of pushing.
+    void ForEachPending(const RamDb& db, const std::function<void(const DbChange&)>& f);
+    /// Blocks until the changes queued before the call are written.
+    void Flush();
+
+private:
+    struct Pending
+    {
+        RamDb* db = nullptr;
+        std::vector<DbChange> writing;
+        std::vector<DbChange> queued;
+        std::map<std::string, std::size_t> queued_index;
+    };
+
+    std::mutex mutex;
+    std::condition_variable work;
+    std::condition_variable progress;
+    std::map<const RamDb*, Pending> dbs;
+    std::size_t queued_count = 0;
+    std::uint64_t pushed     = 0;
+    std::uint64_t written    = 0;
+    bool flush_requested     = false;
+    bool stopping            = false;
+    std::thread thread;
+
+    DbWriteQueue();
+
+    void Run();
+    void Stop();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_DB_WRITE_QUEUE_HPP_
@@ -36,8 +36,13 @@
 #include <miopen/tensor_ops.hpp>
 
 #include <algorithm>
+#include <string>
+#include <vector>
 
 namespace miopen {
+
+struct Problem;
+
 namespace debug {
 
 int GetFusionMode(const miopenFusionPlanDescriptor_t& fusePlanDesc);
@@ -66,6 +71,11 @@ std::string ConvArgsForMIOpenDriver(const miopen::TensorDescriptor& xDesc,
                                     std::optional<uint64_t> immediate_mode_solver_id,
                                     bool print_for_conv_driver = true);
 
+/// Parses a MIOpenDriver convolution command, e.g. one printed by ConvArgsForMIOpenDriver.
+/// Returns a problem per direction enabled by the -F flag, or none if the line has no
+/// convolution command. Flags which do not change the problem are ignored.
+std::vector<Problem> ParseConvDriverArgs(const std::string& line);
+
 std::string BnormArgsForMIOpenDriver(miopenTensorDescriptor_t xDesc,
                                      miopenBatchNormMode_t bn_mode,
                                      const void* resultRunningMean,
@@ -32,6 +32,7 @@
 #include <miopen/db_path.hpp>
 #include <miopen/db_record.hpp>
 #include <miopen/env.hpp>
+#include <miopen/find_db_nearest.hpp>
 #include <miopen/perf_field.hpp>
 #include <miopen/ramdb.hpp>
 #include <miopen/readonlyramdb.hpp>
@@ -106,6 +107,9 @@ public:
 
         content = db->FindRecord(problem);
         in_sync = content.is_initialized();
+
+        if(!content && FindDbNeighbours::GetMode() != FindDbNearestMode::Disabled)
+            LoadNearest(DbRecord{DbKinds::FindDb, problem}.GetKey());
     }
 
     template <class TProblemDescription, class TTestDb = TDb>
@@ -143,6 +147,8 @@ public:
     auto end() const { return content->As<FindDbData>().end(); }
     auto end() { return content->As<FindDbData>().end(); }
     bool empty() const { return !content.is_initialized(); }
+    /// True if the record is of the closest problem found by MIOPEN_FIND_DB_NEAREST.
+    bool IsApproximate() const { return approximate; }
 
     template <class TProblemDescription>
     static std::vector<PerfField> TryLoad(Handle& handle,
@@ -171,18 +177,24 @@ public:
         return ret;
     }
 
+    static std::string GetInstalledPath(Handle& handle, const std::string& path_suffix);
+
 private:
     std::string path;
     std::string installed_path;
     boost::optional<DbTimer<TDb>> db;
     boost::optional<DbRecord> content{boost::none};
-    bool in_sync = false;
+    bool in_sync     = false;
+    bool approximate = false;
 
-    static std::string GetInstalledPath(Handle& handle, const std::string& path_suffix);
     static std::string GetInstalledPathEmbed(Handle& handle, const std::string& path_suffix);
     static std::string GetInstalledPathFile(Handle& handle, const std::string& path_suffix);
     static std::string GetUserPath(Handle& handle, const std::string& path_suffix);
 
+    /// Loads the record of the closest problem having the same key with the batch size
+    /// (and the spatial sizes) masked out.
+    void LoadNearest(const std::string& key);
+
     // Returns true if rebuild is required
     bool Validate(Handle& handle, const NetworkConfig& config) const;
     void CopyTo(std::vector<PerfField>& to) const;
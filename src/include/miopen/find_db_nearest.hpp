@@ -0,0 +1,96 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_FIND_DB_NEAREST_HPP_
+#define GUARD_MIOPEN_FIND_DB_NEAREST_HPP_
+
+#include <boost/optional.hpp>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace miopen {
+
+/// Fields of a problem masked out of the find-db keys by the nearest-neighbour lookup.
+/// Set by MIOPEN_FIND_DB_NEAREST.
+enum class FindDbNearestMode
+{
+    Disabled        = 0,
+    Batch           = 1,
+    BatchAndSpatial = 2,
+};
+
+/// Find-db key of a convolution split into the masked fields and the rest of the key, e.g.
+/// 64-28-28-3x3-128-28-28-16-1x1-1x1-1x1-0-NCHW-FP32-F has batch size 16 and
+/// 64-*-*-3x3-128-*-*-*-1x1-1x1-1x1-0-NCHW-FP32-F as the masked key.
+struct FindDbKeyShape
+{
+    std::string masked;
+    std::uint64_t batch   = 0;
+    std::uint64_t spatial = 1; // The product of the input spatial sizes, if they are masked.
+
+    /// Returns none for keys of other formats.
+    static boost::optional<FindDbKeyShape> Parse(std::string_view key, FindDbNearestMode mode);
+
+    /// Distance between the problems in the log scale.
+    double Distance(const FindDbKeyShape& other) const;
+};
+
+/// Index of the find-db keys by the masked keys.
+class FindDbNeighbours
+{
+public:
+    struct Match
+    {
+        std::string key;
+        double distance;
+    };
+
+    static FindDbNearestMode GetMode();
+
+    explicit FindDbNeighbours(FindDbNearestMode mode_) : mode(mode_) {}
+
+    void Add(std::string_view key);
+
+    /// Returns the key of the closest problem having the same masked key.
+    boost::optional<Match> FindNearest(const FindDbKeyShape& shape) const;
+
+private:
+    struct Entry
+    {
+        std::string key;
+        FindDbKeyShape shape;
+    };
+
+    FindDbNearestMode mode;
+    std::unordered_map<std::string, std::vector<Entry>> entries;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_FIND_DB_NEAREST_HPP_
@@ -29,6 +29,7 @@
 
 #include <miopen/env.hpp>
 #include <miopen/conv_solution.hpp>
+#include <miopen/db.hpp>
 #include <miopen/execution_context.hpp>
 #include <miopen/find_controls.hpp>
 #include <miopen/handle.hpp>
@@ -37,6 +38,7 @@
 #include <miopen/solver.hpp>
 
 #include <limits>
+#include <type_traits>
 #include <vector>
 
 namespace miopen {
@@ -216,6 +218,9 @@ struct SolverContainer
         std::vector<Solution> ss;
         std::size_t count    = 0;
         const auto find_only = GetEnvFindOnlySolver();
+        // Search results of all the solvers are written to the db at once.
+        auto batch    = db.BeginBatch();
+        auto batch_db = DbWithBatch<std::remove_reference_t<Db>, decltype(batch)>{db, batch};
         miopen::each_args(
             [&](auto solver) {
                 if(count >= limit)
@@ -238,7 +243,7 @@ struct SolverContainer
                 else
                 {
                     const Solution s =
-                        FindSolution(solver, ctx, problem, db, invoke_ctx, "", options);
+                        FindSolution(solver, ctx, problem, batch_db, invoke_ctx, "", options);
                     if(s.Succeeded())
                     {
                         ++count;
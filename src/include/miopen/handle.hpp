@@ -111,23 +111,25 @@ struct MIOPEN_EXPORT Handle : miopenHandle
 
     auto GetKernels(const std::string& algorithm, const std::string& network_config) const
     {
-        return this->GetKernelsImpl(algorithm, network_config) |
-               boost::adaptors::transformed([this](Kernel k) { return this->Run(k); });
+        // The range holds the kernel set, which is replaced and not changed by the cache.
+        auto kernels = this->GetKernelsImpl(algorithm, network_config);
+        return *kernels | boost::adaptors::transformed(
+                              [this, kernels](Kernel k) { return this->Run(k); });
     }
     KernelInvoke GetKernel(const std::string& algorithm, const std::string& network_config) const
     {
         auto ks = this->GetKernelsImpl(algorithm, network_config);
-        if(ks.empty())
+        if(ks->empty())
         {
             MIOPEN_THROW("looking for default kernel (does not exist): " + algorithm + ", " +
                          network_config);
         }
-        return this->Run(ks.front());
+        return this->Run(ks->front());
     }
 
     KernelInvoke Run(Kernel k) const;
-    const std::vector<Kernel>& GetKernelsImpl(const std::string& algorithm,
-                                              const std::string& network_config) const;
+    std::shared_ptr<const std::vector<Kernel>>
+    GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const;
 
     Program LoadProgram(const std::string& program_name,
                         std::string params,
@@ -58,6 +58,8 @@ struct HIPOCProgram
     fs::path GetCodeObjectPathname() const;
     /// \return Copy of in-memory CO blob.
     std::string GetCodeObjectBlob() const;
+    /// \return Size of in-memory CO blob, zero if CO resides on filesystem.
+    std::size_t GetCodeObjectSize() const;
     /// \return True if CO blob resides in-memory.
     /// False if CO resides on filesystem.
     bool IsCodeObjectInMemory() const;
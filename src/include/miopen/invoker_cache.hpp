@@ -26,6 +26,9 @@
 
 #pragma once
 
+#include <miopen/clock_map.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/invoker.hpp>
 
@@ -36,18 +39,31 @@
 #include <string>
 #include <utility>
 
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_INVOKER_CACHE_LIMIT)
+
 namespace miopen {
 
+/// MIOPEN_INVOKER_CACHE_LIMIT bounds the number of network configs the invokers are kept for.
+/// The invokers of the least recently used configs are evicted by the CLOCK algorithm.
+/// The invoker references returned by the lookups are valid until the next Register() call.
+/// The find 1.0 results of the evicted configs are kept, so that their invokers can be
+/// prepared again for the same solvers.
 class InvokerCache
 {
 public:
     // network_config, solver_id
     using Key = std::pair<std::string, std::string>;
 
+    InvokerCache();
+
+    /// True if MIOPEN_INVOKER_CACHE_LIMIT is set, so the invokers may be evicted.
+    static bool IsBounded();
+
     boost::optional<const Invoker&> operator[](const Key& key) const;
     // For find 1.0
     boost::optional<const Invoker&> GetFound1_0(const std::string& network_config,
                                                 const std::string& algorithm) const;
+    // Also returns the find 1.0 results of the evicted items.
     boost::optional<const std::string&> GetFound1_0SolverId(const std::string& network_config,
                                                             const std::string& algorithm) const;
 
@@ -68,7 +84,13 @@ private:
     };
 
     // network_config -> Item
-    std::map<std::string, Item> invokers;
+    ClockMap<std::string, Item> invokers;
+    // network_config -> algorithm -> solver_id
+    // find 1.0 results of the evicted items
+    std::map<std::string, std::map<std::string, std::string>> evicted_found_1_0;
+    DbResidentBytes resident_bytes{DbStats::Kind::InvokerCache};
+
+    void Evict(const std::string& network_config, const Item& item);
 };
 
 } // namespace miopen
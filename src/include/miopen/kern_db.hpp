@@ -30,6 +30,7 @@
 
 #if MIOPEN_ENABLE_SQLITE
 
+#include <miopen/binary_cache.hpp>
 #include <miopen/sqlite_db.hpp>
 #include <miopen/bz2.hpp>
 #include <miopen/md5.hpp>
@@ -38,9 +39,12 @@
 #include <boost/none.hpp>
 #include <boost/optional/optional.hpp>
 
+#include <cstdint>
 #include <string>
 #include <chrono>
 #include <thread>
+#include <tuple>
+#include <vector>
 
 namespace miopen {
 struct KernelConfig
@@ -63,6 +67,7 @@ struct KernelConfig
            << ",`kernel_blob` BLOB NOT NULL"
            << ",`kernel_hash` TEXT NOT NULL"
            << ",`uncompressed_size` INT NOT NULL"
+           << ",`last_access` INT NOT NULL DEFAULT 0"
            << ");"
            << "CREATE UNIQUE INDEX IF NOT EXISTS "
            << "`idx_" << KernelConfig::table_name() << "` "
@@ -76,21 +81,48 @@ struct KernelConfig
            << " AND (kernel_args = '" << kernel_args << "')";
         return ss.str();
     }
+    /// The same condition with the values to bind, so the query text does not change.
+    std::tuple<std::string, std::vector<std::string>> WhereClause() const
+    {
+        return {"(kernel_name = ?) AND (kernel_args = ?)", {kernel_name, kernel_args}};
+    }
 };
 
+/// The user kernel dbs track when each kernel was looked up last, so that the least recently
+/// used ones can be removed when the db grows over its size limit. The time is updated at most
+/// once per access_resolution seconds, to keep the lookups free of writes.
 class KernDb : public SQLiteBase<KernDb>
 {
     std::function<std::string(std::string, bool*)> compress_fn;
     std::function<std::string(std::string, unsigned int)> decompress_fn;
+    bool track_access = false;
+
+    void Touch(std::int64_t id, std::int64_t last_access);
 
 public:
-    KernDb(DbKinds db_kind, const std::string& filename_, bool is_system);
+    static constexpr std::int64_t access_resolution = 60 * 60;
+
+    /// Seconds since the epoch.
+    static std::int64_t GetAccessTime();
+
+    KernDb(DbKinds db_kind_, const std::string& filename_, bool is_system);
     // This constructor is only intended for testing
-    KernDb(DbKinds db_kind,
+    KernDb(DbKinds db_kind_,
            const std::string& filename_,
            bool is_system_,
            std::function<std::string(std::string, bool*)> compress_fn_,
            std::function<std::string(std::string, unsigned int)> decompress_fn_);
+    KernelCacheUsage GetUsage();
+    /// Removes the kernels last used before unused_since, then the least recently used ones
+    /// until the rest take at most max_bytes. Compacting shrinks the file, which is slow.
+    KernelCacheUsage Trim(std::size_t max_bytes, std::int64_t unused_since, bool compact);
+    /// Adds the kernels of the kernel db in the other file, replacing those with the same name
+    /// and arguments.
+    KernelCacheUsage Merge(const std::string& other);
+    /// Leaves the WAL mode and compacts the file, so that it can be installed as a system
+    /// kernel db, which is read from a read-only directory.
+    void PrepareForInstall();
+
     template <typename T>
     bool RemoveRecordUnsafe(const T& problem_config)
     {
@@ -116,10 +148,13 @@ public:
     {
         if(filename.empty())
             return boost::none;
-        // Where clause with inserted values defeats the purpose of a prepraed statement
-        auto select_query = "SELECT kernel_blob, kernel_hash, uncompressed_size FROM " +
-                            T::table_name() + " WHERE " + problem_config.Where() + ";";
-        auto stmt = SQLite::Statement{sql, select_query};
+        std::string clause;
+        std::vector<std::string> values;
+        std::tie(clause, values) = problem_config.WhereClause();
+        auto select_query = std::string{"SELECT kernel_blob, kernel_hash, uncompressed_size"} +
+                            (track_access ? ", id, last_access" : "") + " FROM " +
+                            T::table_name() + " WHERE " + clause + ";";
+        auto stmt = sql.Prepare(select_query, values, true);
         // only one result field
         // assert one row
         auto rc = stmt.Step(sql);
@@ -129,6 +164,15 @@ public:
             auto md5_hash                  = stmt.ColumnText(1);
             auto uncompressed_size         = stmt.ColumnInt64(2);
             std::string& decompressed_blob = compressed_blob;
+            if(track_access)
+            {
+                const auto id          = stmt.ColumnInt64(3);
+                const auto last_access = stmt.ColumnInt64(4);
+
+                // Lets the update run without a pending read.
+                stmt = SQLite::Statement{};
+                Touch(id, last_access);
+            }
             if(uncompressed_size != 0)
             {
                 decompressed_blob = decompress_fn(compressed_blob, uncompressed_size);
@@ -144,7 +188,7 @@ public:
         }
         else
         {
-            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            MIOPEN_THROW(miopenStatusInternalError, stmt.ErrorMessage());
         }
         return boost::none;
     }
@@ -156,12 +200,12 @@ public:
             return false;
         auto insert_query = "INSERT OR REPLACE INTO " + T::table_name() +
                             "(kernel_name, kernel_args, kernel_blob, kernel_hash, "
-                            "uncompressed_size) VALUES(?, ?, ?, ?, ?);";
+                            "uncompressed_size, last_access) VALUES(?, ?, ?, ?, ?, ?);";
         auto md5_sum           = md5(problem_config.kernel_blob);
         auto uncompressed_size = problem_config.kernel_blob.size();
         bool success           = false;
         auto compressed_blob   = compress_fn(problem_config.kernel_blob, &success);
-        auto stmt              = SQLite::Statement{sql, insert_query};
+        auto stmt              = sql.Prepare(insert_query, {}, false);
         stmt.BindText(1, problem_config.kernel_name);
         stmt.BindText(2, problem_config.kernel_args);
         if(!success)
@@ -175,6 +219,7 @@ public:
             stmt.BindInt64(5, uncompressed_size);
         }
         stmt.BindText(4, md5_sum);
+        stmt.BindInt64(6, GetAccessTime());
 
         auto rc = stmt.Step(sql);
         if(rc != SQLITE_DONE)
@@ -122,6 +122,12 @@ public:
         return TFor::Generate(options);
     }
 
+    /// Returns the compile options in a canonical form, which the caches use as the key, so that
+    /// the equivalent options share the entries. The whitespace is normalized, and the defines
+    /// (-D, -U and -Wa,-defsym,) are stably sorted by name and put after the other options, which
+    /// keep their order. The options with quotes are only trimmed.
+    static std::string Canonicalize(const std::string& options);
+
 private:
     std::vector<KernelBuildParameter> options = {};
 
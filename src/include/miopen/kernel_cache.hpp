@@ -42,12 +42,16 @@
 #ifndef GUARD_MIOPEN_KERNEL_CACHE_HPP_
 #define GUARD_MIOPEN_KERNEL_CACHE_HPP_
 
+#include <miopen/clock_map.hpp>
+#include <miopen/db_stats.hpp>
 #include <miopen/handle.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/simple_hash.hpp>
 #include <miopen/miopen.h>
+#include <memory>
+#include <shared_mutex>
 #include <string>
-#include <unordered_map>
+#include <string_view>
 #include <vector>
 
 namespace miopen {
@@ -55,14 +59,21 @@ namespace miopen {
 /**
  * @brief The KernelCache class Build and cache kernels
  *
+ * MIOPEN_KERNEL_CACHE_LIMIT bounds the number of the cached programs and, separately, of the
+ * cached kernel sets. The least recently used ones are evicted by the CLOCK algorithm.
+ *
+ * The entries are found by the hash of their key, computed from the strings of the caller, and
+ * the stored key is compared then, so a lookup copies no strings. The cache may be used by
+ * several threads: lookups share a lock, and changes take it exclusively. A kernel set is
+ * replaced as a whole on a change, so the one returned by GetKernels() stays valid while it is
+ * held.
  */
 class KernelCache
 {
 
 public:
     using Key        = std::pair<std::string, std::string>;
-    using KernelMap  = std::unordered_map<Key, std::vector<Kernel>, SimpleHash>;
-    using ProgramMap = std::unordered_map<Key, Program, SimpleHash>;
+    using KernelsPtr = std::shared_ptr<const std::vector<Kernel>>;
 
     Kernel AddKernel(const Handle& h,
                      const std::string& algorithm,
@@ -75,12 +86,12 @@ public:
                      std::size_t cache_index       = 0,
                      const std::string& kernel_src = "");
 
-    void AddKernel(Key key, Kernel k, std::size_t cache_index);
+    void AddKernel(const Key& key, Kernel k, std::size_t cache_index);
 
     void ClearKernels(const std::string& algorithm, const std::string& network_config);
 
-    const std::vector<Kernel>& GetKernels(const std::string& algorithm,
-                                          const std::string& network_config);
+    /// Never returns nullptr.
+    KernelsPtr GetKernels(const std::string& algorithm, const std::string& network_config) const;
 
     bool HasProgram(const std::string& name, const std::string& params) const;
     void ClearProgram(const std::string& name, const std::string& params);
@@ -90,8 +101,34 @@ public:
     KernelCache();
 
 private:
+    template <class TValue>
+    struct Entry
+    {
+        Key key;
+        TValue value;
+
+        bool Matches(std::string_view first, std::string_view second) const
+        {
+            return key.first == first && key.second == second;
+        }
+    };
+
+    /// The maps are keyed by SimpleHash values.
+    struct Prehashed
+    {
+        std::size_t operator()(std::size_t hash) const { return hash; }
+    };
+
+    using KernelMap  = ClockMap<std::size_t, Entry<KernelsPtr>, Prehashed>;
+    using ProgramMap = ClockMap<std::size_t, Entry<Program>, Prehashed>;
+
+    mutable std::shared_timed_mutex mutex;
     KernelMap kernel_map;
     ProgramMap program_map;
+    DbResidentBytes resident_bytes{DbStats::Kind::KernelCache};
+
+    const Program* FindProgram(const std::string& name, const std::string& params) const;
+    void StoreProgram(const Key& key, const Program& program);
 };
 
 } // namespace miopen
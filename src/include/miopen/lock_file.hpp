@@ -171,8 +171,9 @@ private:
 
     static std::map<std::string, LockFile>& LockFiles()
     {
-        // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-        static std::map<std::string, LockFile> lock_files;
+        // Never destroyed, so the locks can be used by the threads still running at exit.
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        static auto& lock_files = *new std::map<std::string, LockFile>{};
         return lock_files;
     }
 
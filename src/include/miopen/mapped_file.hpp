@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_MAPPED_FILE_HPP_
+#define GUARD_MIOPEN_MAPPED_FILE_HPP_
+
+#include <miopen/filesystem.hpp>
+
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/optional.hpp>
+
+#include <string>
+#include <string_view>
+
+namespace miopen {
+
+/// Read-only memory mapping of a whole file.
+/// Empty files are not mapped, View() returns an empty view for them.
+/// Throws if the file cannot be mapped.
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    explicit MappedFile(const fs::path& path);
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile(MappedFile&&)      = default;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile& operator=(MappedFile&&) = default;
+
+    std::string_view View() const
+    {
+        return {static_cast<const char*>(region.get_address()), region.get_size()};
+    }
+
+    /// Asks the OS to read the file in ahead of the first access. Returns false if the hint
+    /// is not supported.
+    bool AdviseWillNeed();
+
+private:
+    boost::interprocess::file_mapping mapping;
+    boost::interprocess::mapped_region region;
+};
+
+/// Maps the file or, if that is not possible, reads it into the buffer.
+/// Returns the contents of the file or none if it is unreadable.
+boost::optional<std::string_view>
+MapOrReadFile(const fs::path& path, MappedFile& mapping, std::string& buffer);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_MAPPED_FILE_HPP_
@@ -27,70 +27,32 @@
 #ifndef MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 #define MIOPEN_GUARD_MLOPEN_PAR_FOR_HPP
 
+#include <miopen/thread_pool.hpp>
+
 #include <algorithm>
-#include <cassert>
-#include <cmath>
+#include <cstddef>
 #include <functional>
-#include <numeric>
-#include <vector>
-
 #include <thread>
 
 namespace miopen {
 
-struct joinable_thread : std::thread
-{
-    template <class... Xs>
-    joinable_thread(Xs&&... xs) : std::thread(std::forward<Xs>(xs)...) // NOLINT
-    {
-    }
-
-    joinable_thread& operator=(joinable_thread&& other) = default;
-    joinable_thread(joinable_thread&& other)            = default;
-
-    ~joinable_thread()
-    {
-        if(this->joinable())
-            this->join();
-    }
-};
-
-struct thread_factory
-{
-    template <class F>
-    joinable_thread operator()(std::size_t& work, std::size_t n, std::size_t grainsize, F f) const
-    {
-        auto result = joinable_thread([=] {
-            std::size_t start = work;
-            std::size_t last  = std::min(n, work + grainsize);
-            for(std::size_t i = start; i < last; i++)
-            {
-                f(i);
-            }
-        });
-        work += grainsize;
-        return result;
-    }
-};
-
+/// Calls f(i) for each i in [0, n) by up to `threadsize` threads of the ThreadPool, including
+/// the calling one. The range is split into several chunks per thread, so the threads which are
+/// done early take over the rest.
 template <class F>
 void par_for_impl(std::size_t n, std::size_t threadsize, F f)
 {
-    if(threadsize <= 1)
+    if(threadsize <= 1 || n <= 1)
     {
         for(std::size_t i = 0; i < n; i++)
             f(i);
     }
     else
     {
-        std::vector<joinable_thread> threads(threadsize);
-        const std::size_t grainsize = std::ceil(static_cast<double>(n) / threads.size());
-
-        std::size_t work = 0;
-        std::generate(threads.begin(),
-                      threads.end(),
-                      std::bind(thread_factory{}, std::ref(work), n, grainsize, f));
-        assert(work >= n);
+        constexpr std::size_t chunks_per_thread = 4;
+        const auto chunks    = std::min(n, threadsize * chunks_per_thread);
+        const auto grainsize = (n + chunks - 1) / chunks;
+        ThreadPool::Get().ParallelFor(n, threadsize, grainsize, std::ref(f));
     }
 }
 
@@ -0,0 +1,208 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_PROBLEM_KEY_HPP_
+#define GUARD_MIOPEN_PROBLEM_KEY_HPP_
+
+#include <miopen/errors.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace miopen {
+
+struct Hash128
+{
+    std::uint64_t lo = 0;
+    std::uint64_t hi = 0;
+
+    friend bool operator==(const Hash128& left, const Hash128& right)
+    {
+        return left.lo == right.lo && left.hi == right.hi;
+    }
+    friend bool operator!=(const Hash128& left, const Hash128& right) { return !(left == right); }
+};
+
+/// Fixed-width binary key of a problem: the fields of the problem descriptor packed into
+/// 64-bit words. Unlike the text keys of the dbs and the network configs, it is built without
+/// formatting or allocations, so it can be built on every call. Keys are equal if all their
+/// words are equal, the 128-bit hash is only used to find them.
+class ProblemKey
+{
+public:
+    static constexpr std::size_t max_words = 48;
+
+    /// The tag distinguishes the keys of different problem types.
+    explicit ProblemKey(std::uint64_t tag) { Add(tag); }
+
+    ProblemKey& Add(std::uint64_t value)
+    {
+        if(size == max_words)
+            MIOPEN_THROW(miopenStatusInternalError, "Too many fields in a problem key");
+        words[size++] = value;
+        return *this;
+    }
+
+    /// Short strings, e.g. layouts, are packed into the words with their size.
+    ProblemKey& Add(std::string_view value)
+    {
+        Add(value.size());
+        for(auto pos = std::size_t{0}; pos < value.size(); pos += sizeof(std::uint64_t))
+        {
+            auto word = std::uint64_t{0};
+            std::memcpy(&word, value.data() + pos, std::min(sizeof(word), value.size() - pos));
+            Add(word);
+        }
+        return *this;
+    }
+
+    /// MurmurHash3 x64/128 of the words.
+    Hash128 GetHash() const
+    {
+        constexpr std::uint64_t c1 = 0x87c37b91114253d5ULL;
+        constexpr std::uint64_t c2 = 0x4cf5ad432745937fULL;
+
+        auto h1 = std::uint64_t{size};
+        auto h2 = std::uint64_t{size};
+
+        auto i = std::size_t{0};
+        for(; i + 1 < size; i += 2)
+        {
+            h1 ^= Rotl(words[i] * c1, 31) * c2;
+            h1 = (Rotl(h1, 27) + h2) * 5 + 0x52dce729;
+            h2 ^= Rotl(words[i + 1] * c2, 33) * c1;
+            h2 = (Rotl(h2, 31) + h1) * 5 + 0x38495ab5;
+        }
+        if(i < size)
+            h1 ^= Rotl(words[i] * c1, 31) * c2;
+
+        h1 ^= size * sizeof(std::uint64_t);
+        h2 ^= size * sizeof(std::uint64_t);
+        h1 += h2;
+        h2 += h1;
+        h1 = Fmix(h1);
+        h2 = Fmix(h2);
+        h1 += h2;
+        h2 += h1;
+        return {h1, h2};
+    }
+
+    friend bool operator==(const ProblemKey& left, const ProblemKey& right)
+    {
+        const auto bytes = left.size * sizeof(std::uint64_t);
+        return left.size == right.size &&
+               std::memcmp(left.words.data(), right.words.data(), bytes) == 0;
+    }
+    friend bool operator!=(const ProblemKey& left, const ProblemKey& right)
+    {
+        return !(left == right);
+    }
+
+    struct Hasher
+    {
+        std::size_t operator()(const ProblemKey& key) const { return key.GetHash().lo; }
+    };
+
+private:
+    std::array<std::uint64_t, max_words> words{};
+    std::size_t size = 0;
+
+    static std::uint64_t Rotl(std::uint64_t value, int shift)
+    {
+        return (value << shift) | (value >> (64 - shift));
+    }
+
+    static std::uint64_t Fmix(std::uint64_t value)
+    {
+        value ^= value >> 33;
+        value *= 0xff51afd7ed558ccdULL;
+        value ^= value >> 33;
+        value *= 0xc4ceb9fe1a85ec53ULL;
+        value ^= value >> 33;
+        return value;
+    }
+};
+
+/// Process-wide memo of the text forms of problems: the db keys and the network configs, which
+/// the on-disk dbs and the caches are keyed by. The text is built once per distinct problem
+/// instead of on every call. Disabled by MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE.
+class ProblemTextCache
+{
+public:
+    enum class Form : std::uint8_t
+    {
+        FindDbKey,
+        PerfDbKey,
+        NetworkConfig,
+    };
+
+    static ProblemTextCache& Get(Form form);
+    static bool IsEnabled();
+
+    /// Returns the text of the problem, calling build() if it is not in the cache.
+    template <class TBuild>
+    std::string GetOrBuild(const ProblemKey& key, TBuild&& build)
+    {
+        if(!IsEnabled())
+            return build();
+
+        {
+            const std::shared_lock<std::shared_mutex> lock{mutex};
+            const auto it = texts.find(key);
+            if(it != texts.end())
+                return it->second;
+        }
+
+        auto text = build();
+
+        {
+            const std::unique_lock<std::shared_mutex> lock{mutex};
+            // Distinct problems of a process are few, so the limit is only a safety net.
+            if(texts.size() >= max_size)
+                texts.clear();
+            texts.emplace(key, text);
+        }
+
+        return text;
+    }
+
+private:
+    static constexpr std::size_t max_size = 64 * 1024;
+
+    std::shared_mutex mutex;
+    std::unordered_map<ProblemKey, std::string, ProblemKey::Hasher> texts;
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_PROBLEM_KEY_HPP_
@@ -30,23 +30,42 @@
 
 #include <boost/optional.hpp>
 
+#include <array>
+#include <atomic>
 #include <chrono>
-#include <map>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <sstream>
+#include <string_view>
+#include <unordered_map>
 
 // Value of one enables experimental write-through feature of RamDb.
 // It provides some performance gain in case of multi-threaded cache write operations.
 #define MIOPEN_DB_CACHE_WRITE_THROUGH 1
 
+/// Interval of the checks of a user db file for the changes made by other processes.
+MIOPEN_DECLARE_ENV_VAR(MIOPEN_DEBUG_RAMDB_REVALIDATION_MS, uint64_t, 1000)
+
 namespace miopen {
 
 using ramdb_clock = std::chrono::steady_clock;
 
 class LockFile;
 
+/// Caches a user db file in memory. Lookups read immutable snapshots of the cache shards and
+/// mostly take no locks. They take the db file lock, and so may wait for a write by another
+/// process, in two cases:
+/// - one lookup per MIOPEN_DEBUG_RAMDB_REVALIDATION_MS checks the file for the changes made by
+///   other processes, under the exclusive lock; the concurrent lookups use the snapshot;
+/// - a lookup of a record evicted by MIOPEN_DB_CACHE_LIMIT reads it from the file under the
+///   shared lock.
 class RamDb : protected PlainTextDb
 {
+    friend class DbWriteQueue;
+
 public:
     RamDb(DbKinds db_kind_,
           std::string path,
@@ -94,6 +113,12 @@ public:
         return record->GetValues(id, value);
     }
 
+    /// Calls f(key) for every record of the db.
+    void ForEachKey(const std::function<void(std::string_view)>& f);
+    /// Changes whenever the cached records change, so the data built from them, e.g. an index
+    /// of the keys, needs to be rebuilt only then.
+    std::uint64_t GetGeneration() const { return generation.load(std::memory_order_acquire); }
+
     bool StoreRecord(const DbRecord& record);
     bool UpdateRecord(DbRecord& record);
     bool RemoveRecord(const std::string& key);
@@ -126,24 +151,119 @@ public:
             return boost::none;
     }
 
+    DbBatch<RamDb> BeginBatch() { return {*this, db_kind}; }
+    bool CommitBatch(const std::vector<DbChange>& changes);
+
 private:
+    /// Atomic flag which is copied along with the snapshot it belongs to.
+    struct ReferencedFlag
+    {
+        ReferencedFlag() = default;
+        ReferencedFlag(const ReferencedFlag& other)
+            : value(other.value.load(std::memory_order_relaxed))
+        {
+        }
+        ReferencedFlag& operator=(const ReferencedFlag& other)
+        {
+            value.store(other.value.load(std::memory_order_relaxed), std::memory_order_relaxed);
+            return *this;
+        }
+
+        mutable std::atomic<bool> value{false};
+    };
+
     struct CacheItem
     {
+        CacheItem(int line_, std::string content_) : line(line_), content(std::move(content_)) {}
+
         int line;
         std::string content;
+        /// Set by the lookups and cleared by the eviction, see EvictUnsafe().
+        ReferencedFlag referenced;
     };
 
+    using Cache = std::unordered_map<std::string, CacheItem>;
+
+    static constexpr std::size_t shard_count = 16;
+
+    /// The cache is split into shards by the key hash. Each shard is an immutable snapshot:
+    /// readers load it through an atomic pointer without taking any locks, and writers, which
+    /// hold the file lock, publish modified copies. So a write copies only one shard.
+    std::array<std::shared_ptr<const Cache>, shard_count> shards;
+    /// Incremented after a shard is replaced.
+    std::atomic<std::uint64_t> generation{0};
+
+    // Guarded by the file lock.
     ramdb_clock::time_point file_read_time;
-    std::map<std::string, CacheItem> cache;
+    // Written under the file lock.
+    std::atomic<bool> binary_file{false};
+
+    /// MIOPEN_DB_CACHE_LIMIT split between the shards. Zero for the system dbs, which do not
+    /// grow, and if the user db file io is disabled, as then the cache is the only copy.
+    const std::size_t shard_limit;
+    /// Set once a record is evicted. From then on the records missing in the cache are looked
+    /// up in the file.
+    std::atomic<bool> evicted{false};
+
+    /// The file is checked for modifications by other processes at most once per
+    /// MIOPEN_DEBUG_RAMDB_REVALIDATION_MS instead of on every lookup.
+    std::atomic<ramdb_clock::rep> next_validation{0};
+    std::mutex validation_mutex;
+
+    static std::size_t GetShardIndex(const std::string& key);
+    std::shared_ptr<const Cache> LoadShard(std::size_t idx) const;
+    bool IsCacheEmpty() const;
+
+    /// Serializes the modifications of the cache.
+    std::mutex cache_mutex;
+    // Guarded by the cache mutex.
+    std::array<std::ptrdiff_t, shard_count> shard_sizes{};
+
+    static std::string GetCacheContent(const DbRecord& record);
+    static std::ptrdiff_t GetCacheSize(const Cache& cache);
+    static void ApplyChange(Cache& cache, const DbChange& change);
+
+    /// Publishes the loaded cache, replacing all shards, with the updates waiting in the
+    /// write-behind queue applied on top of it.
+    void Publish(Cache&& cache);
+    // Guarded by the cache mutex.
+    void SetCacheItemUnsafe(const DbRecord& record);
+    void EraseCacheItemUnsafe(const std::string& key);
+    void StoreShardUnsafe(std::size_t idx, std::shared_ptr<const Cache> shard);
+    /// Evicts the records over the shard limit, except the one under the kept key. The records
+    /// looked up since the previous eviction get a second chance. The evicted records are read
+    /// from the file again when they are looked up.
+    void EvictUnsafe(Cache& shard, const std::string* kept);
+
+    /// Looks the record up in the cache or, if it has been evicted, in the file.
+    boost::optional<DbRecord> FindCachedRecord(const std::string& key);
+    /// Reads the record evicted from the cache from the file and caches it again. Takes the
+    /// shared file lock.
+    boost::optional<DbRecord> LoadEvictedRecord(const std::string& key);
+    /// Reads the record from the file and applies the updates waiting in the write-behind
+    /// queue to it. Requires the file lock.
+    boost::optional<DbRecord> FindEvictedRecordUnsafe(const std::string& key);
+
+    /// Applies the changes to the cache and queues them for the write-behind. Merges the
+    /// changes to be merged with the cached records. Returns false, with none of the changes
+    /// applied or queued, if the queue is stopped.
+    bool QueueChanges(std::vector<DbChange>& changes);
+    /// Writes the changes from the write-behind queue to the file.
+    bool PersistChanges(const std::vector<DbChange>& changes);
+
+    template <class TFunc>
+    void RefreshCacheUnsafe(bool is_valid, TFunc&& apply);
 
-    boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem);
+    /// Reloads the cache if the file has been changed by another process. Takes the exclusive
+    /// file lock if the check is due.
+    void RevalidateIfDue();
+    boost::optional<miopen::DbRecord> FindRecordUnsafe(const std::string& problem) const;
 
     bool ValidateUnsafe();
     void Prefetch();
-
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-    void UpdateCacheEntryUnsafe(const DbRecord& record);
-#endif
+    void PrefetchBinary(std::istream& file, Cache& cache);
+    void PrefetchJournal(Cache& cache);
+    bool ConvertToTextUnsafe();
 };
 
 /// \todo This is modified copy of code from db.hpp. Make a proper fix.
@@ -152,6 +272,7 @@ template <>
 class DbTimer<RamDb>
 {
     RamDb& inner;
+    DbStats& stats;
 
     template <class TFunc>
     static auto Measure(const std::string& funcName, TFunc&& func)
@@ -166,26 +287,42 @@ class DbTimer<RamDb>
         return ret;
     }
 
+    template <class TFunc>
+    auto MeasureLookup(const std::string& funcName, TFunc&& func)
+    {
+        return Measure(funcName, [&]() { return stats.MeasureLookup(func); });
+    }
+
+    template <class TFunc>
+    auto MeasureStore(const std::string& funcName, TFunc&& func)
+    {
+        auto ret = Measure(funcName, func);
+        if(static_cast<bool>(ret))
+            stats.AddStore();
+        return ret;
+    }
+
 public:
     template <class... TArgs>
-    DbTimer(TArgs&&... args) : inner(RamDb::GetCached(args...))
+    DbTimer(DbKinds db_kind, TArgs&&... args)
+        : inner(RamDb::GetCached(db_kind, args...)), stats(DbStats::Get(db_kind))
     {
     }
 
     template <class TProblem>
     auto FindRecord(const TProblem& problem)
     {
-        return Measure("FindRecord", [&]() { return inner.FindRecord(problem); });
+        return MeasureLookup("FindRecord", [&]() { return inner.FindRecord(problem); });
     }
 
     bool StoreRecord(const DbRecord& record)
     {
-        return Measure("StoreRecord", [&]() { return inner.StoreRecord(record); });
+        return MeasureStore("StoreRecord", [&]() { return inner.StoreRecord(record); });
     }
 
     bool UpdateRecord(DbRecord& record)
     {
-        return Measure("UpdateRecord", [&]() { return inner.UpdateRecord(record); });
+        return MeasureStore("UpdateRecord", [&]() { return inner.UpdateRecord(record); });
     }
 
     template <class TProblem>
@@ -197,13 +334,13 @@ public:
     template <class TProblem, class TValue>
     auto Update(const TProblem& problem, const std::string& id, const TValue& value)
     {
-        return Measure("Update", [&]() { return inner.Update(problem, id, value); });
+        return MeasureStore("Update", [&]() { return inner.Update(problem, id, value); });
     }
 
     template <class TProblem, class TValue>
     bool Load(const TProblem& problem, const std::string& id, TValue& value)
     {
-        return Measure("Load", [&]() { return inner.Load(problem, id, value); });
+        return MeasureLookup("Load", [&]() { return inner.Load(problem, id, value); });
     }
 
     template <class TProblem>
@@ -211,6 +348,8 @@ public:
     {
         return Measure("Remove", [&]() { return inner.Remove(problem, id); });
     }
+
+    auto BeginBatch() { return inner.BeginBatch(); }
 };
 
 } // namespace miopen
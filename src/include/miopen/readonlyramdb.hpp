@@ -26,13 +26,22 @@
 #ifndef MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 #define MIOPEN_GUARD_MLOPEN_READONLYRAMDB_HPP
 
+#include <miopen/db_binary_format.hpp>
+#include <miopen/db_file_index.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_shared_image.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/mapped_file.hpp>
 
 #include <boost/optional.hpp>
 
-#include <unordered_map>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
-#include <sstream>
+#include <string_view>
+#include <vector>
 
 namespace miopen {
 
@@ -51,21 +60,26 @@ public:
     boost::optional<DbRecord> FindRecord(const std::string& problem) const
     {
         MIOPEN_LOG_I2("Looking for key " << problem << " in file " << db_path);
-        const auto it = cache.find(problem);
 
-        if(it == cache.end())
+        if(binary)
+            return FindBinaryRecord(problem);
+
+        const auto item = index.Find(problem);
+
+        if(item == nullptr)
             return boost::none;
 
         auto record = DbRecord{problem};
 
         MIOPEN_LOG_I2("Key match: " << problem);
-        MIOPEN_LOG_I2("Contents found: " << it->second.content);
+        MIOPEN_LOG_I2("Contents found: " << item->contents);
+        DbStats::Get(db_kind).AddBytesRead(problem.size() + 1 + item->contents.size());
 
-        if(!record.ParseContents(it->second.content))
+        if(!record.ParseContents(std::string{item->contents}))
         {
             MIOPEN_LOG_E("Error parsing payload under the key: "
-                         << problem << " form file " << db_path << "#" << it->second.line);
-            MIOPEN_LOG_E("Contents: " << it->second.content);
+                         << problem << " form file " << db_path << "#" << item->line);
+            MIOPEN_LOG_E("Contents: " << item->contents);
             return boost::none;
         }
 
@@ -88,26 +102,50 @@ public:
         return record->GetValues(id, value);
     }
 
-    struct CacheItem
+    /// Calls f(key) for every record of the db.
+    template <class TFunc>
+    void ForEachKey(TFunc&& f) const
     {
-        int line;
-        std::string content;
-    };
+        if(binary)
+        {
+            for(auto i = std::size_t{0}; i < binary->GetRecordCount(); ++i)
+                f(binary->GetString(binary->GetRecord(i).key));
+            return;
+        }
 
-    const std::unordered_map<std::string, CacheItem>& GetCacheMap() const { return cache; }
+        for(const auto& item : index.GetEntries())
+            f(item.key);
+    }
+
+    using CacheItem = DbTextIndex::Entry;
+
+    /// Records sorted by key. Keys and contents point into the db file mapping
+    /// (or into the embedded db) and are valid during the lifetime of the object.
+    /// Empty if the db is in the binary format or is loaded from a shared image.
+    const std::vector<CacheItem>& GetCacheItems() const { return index.GetEntries(); }
 
 private:
     DbKinds db_kind;
     std::string db_path;
-    std::unordered_map<std::string, CacheItem> cache;
-
-    ReadonlyRamDb(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb(ReadonlyRamDb&&)      = default;
-    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = default;
-    ReadonlyRamDb& operator=(ReadonlyRamDb&&) = default;
-
+    MappedFile mapping;
+    std::string buffer; // Used if the file cannot be mapped.
+    DbTextIndex index;
+    std::optional<binary_db::View> binary;
+    std::unique_ptr<SharedDbImage> shared;
+    std::once_flag prefetch_once;
+    std::atomic<bool> prefetched{false};
+
+    ReadonlyRamDb(const ReadonlyRamDb&) = delete;
+    ReadonlyRamDb& operator=(const ReadonlyRamDb&) = delete;
+
+    /// Loads the db unless it is already loaded. If another thread (e.g. the background
+    /// prefetch) is loading it, blocks until that finishes.
+    void EnsurePrefetched(bool warn_if_unreadable);
     void Prefetch(bool warn_if_unreadable);
-    void ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable);
+    /// Uses the shared image of the db if it is enabled and available. Otherwise may map or
+    /// read the db file into the text.
+    bool LoadShared(boost::optional<std::string_view>& text);
+    boost::optional<DbRecord> FindBinaryRecord(const std::string& problem) const;
 };
 
 } // namespace miopen
@@ -27,15 +27,35 @@
 #ifndef GUARD_MLOPEN_SIMPLE_HASH_HPP
 #define GUARD_MLOPEN_SIMPLE_HASH_HPP
 
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <utility>
 
 namespace miopen {
+/// Hash of a pair of strings. The hashes of the members are mixed, so that swapping them changes
+/// the result, and the members may be passed as views to hash a pair without building it.
 struct SimpleHash
 {
-    size_t operator()(const std::pair<std::string, std::string>& p) const
+    std::size_t operator()(std::string_view first, std::string_view second) const
     {
         using std::hash;
-        return (hash<std::string>()(p.first) ^ hash<std::string>()(p.second));
+        return Combine(hash<std::string_view>()(first), hash<std::string_view>()(second));
+    }
+
+    std::size_t operator()(const std::pair<std::string, std::string>& p) const
+    {
+        return (*this)(p.first, p.second);
+    }
+
+    static std::size_t Combine(std::size_t first, std::size_t second)
+    {
+        // The finalizer of SplitMix64: each bit of both hashes affects all the bits.
+        auto h = static_cast<std::uint64_t>(first) * 0x9e3779b97f4a7c15ULL + second;
+        h      = (h ^ (h >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        h      = (h ^ (h >> 27)) * 0x94d049bb133111ebULL;
+        return static_cast<std::size_t>(h ^ (h >> 31));
     }
 };
 
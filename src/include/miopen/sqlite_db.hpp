@@ -50,9 +50,15 @@
 
 #include <string>
 #include <chrono>
+#include <exception>
+#include <functional>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_SQL_WAL)
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_SQL_MMAP)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DB_SQLITE_READERS)
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEBUG_PERFDB_OVERRIDE)
 
 namespace miopen {
@@ -171,6 +177,9 @@ public:
         class impl;
         std::unique_ptr<impl> pImpl;
 
+        friend class SQLite;
+        explicit Statement(std::unique_ptr<impl> pImpl_);
+
     public:
         Statement(const SQLite& sql, const std::string& query);
         Statement(const SQLite& sql,
@@ -188,6 +197,8 @@ public:
         int BindText(int idx, const std::string& txt);
         int BindBlob(int idx, const std::string& blob);
         int BindInt64(int idx, int64_t);
+        /// Error message of the connection the statement runs on.
+        std::string ErrorMessage() const;
     };
 
     using result_type = std::vector<std::unordered_map<std::string, std::string>>;
@@ -199,19 +210,92 @@ public:
     SQLite& operator=(const SQLite&) = delete;
     bool Valid() const;
     result_type Exec(const std::string& query) const;
+    /// Returns the statement for the query with the values bound. The statements are prepared
+    /// once per connection and query text and reset and kept for reuse when destroyed, so the
+    /// query text should not contain the values. If read_only is set, the statement runs on one
+    /// of up to MIOPEN_DB_SQLITE_READERS read-only connections of the db, if there is an idle one,
+    /// so the lookups from different threads do not wait for each other.
+    Statement
+    Prepare(const std::string& query, const std::vector<std::string>& vals, bool read_only) const;
     int Changes() const;
+    /// Serializes the writes through the connection, so that a write of one thread does not run
+    /// inside a transaction of another thread. The reads do not need it.
+    std::mutex& GetWriteMutex() const;
     int Retry(std::function<int()>) const;
     static int Retry(std::function<int()> f, std::string filename);
     std::string ErrorMessage() const;
 };
 
+/// Buffers writes to a SQLite db and commits them in a single transaction, see DbBatch.
+template <class TDb>
+class SQLiteDbBatch
+{
+public:
+    explicit SQLiteDbBatch(TDb& db_) : db(&db_) {}
+    SQLiteDbBatch(SQLiteDbBatch&& other) noexcept
+        : db(std::exchange(other.db, nullptr)), changes(std::move(other.changes))
+    {
+    }
+    SQLiteDbBatch(const SQLiteDbBatch&) = delete;
+    SQLiteDbBatch& operator=(const SQLiteDbBatch&) = delete;
+    SQLiteDbBatch& operator=(SQLiteDbBatch&&) = delete;
+
+    ~SQLiteDbBatch()
+    {
+        try
+        {
+            if(!Commit())
+                MIOPEN_LOG_E("Failed to commit a batch of db records");
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_E("Failed to commit a batch of db records: " << ex.what());
+        }
+    }
+
+    /// Unlike the db, returns whether the change is buffered: the SQLite problems have no text
+    /// key to build the record with.
+    template <class T, class V>
+    bool Update(const T& problem_config, const std::string& id, const V& values)
+    {
+        changes.push_back([=](TDb& target) {
+            return static_cast<bool>(target.UpdateUnsafe(problem_config, id, values));
+        });
+        return true;
+    }
+
+    template <class T, class V>
+    bool StoreRecord(const T& problem_config, const std::string& id, const V& values)
+    {
+        changes.push_back([=](TDb& target) {
+            return target.StoreRecordUnsafe(problem_config, id, values);
+        });
+        return true;
+    }
+
+    std::size_t Size() const { return changes.size(); }
+
+    bool Commit()
+    {
+        if(db == nullptr || changes.empty())
+            return true;
+        auto committed = std::move(changes);
+        changes.clear();
+        return db->CommitBatch(committed);
+    }
+
+private:
+    TDb* db;
+    std::vector<std::function<bool(TDb&)>> changes;
+};
+
 template <typename Derived>
 class SQLiteBase
 {
 protected:
 public:
-    SQLiteBase(DbKinds, const std::string& filename_, bool is_system_)
-        : filename(filename_), is_system(is_system_)
+    SQLiteBase(DbKinds db_kind_, const std::string& filename_, bool is_system_)
+        : filename(filename_), is_system(is_system_), db_kind(db_kind_)
     {
         if(DisableUserDbFileIO && !is_system)
             return;
@@ -325,7 +409,9 @@ public:
         using Ret = decltype(reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...));
         if(!is_system && DisableUserDbFileIO)
             return Ret{};
-        return reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...);
+        auto record = reinterpret_cast<Derived*>(this)->FindRecordUnsafe(args...);
+        DbStats::Get(db_kind).AddBytesRead(record);
+        return record;
     }
 
     template <typename... U>
@@ -333,6 +419,7 @@ public:
     {
         if(!is_system && DisableUserDbFileIO)
             return true;
+        const auto lock = LockWrites();
         return reinterpret_cast<Derived*>(this)->RemoveRecordUnsafe(args...);
     }
 
@@ -341,6 +428,7 @@ public:
     {
         if(!is_system && DisableUserDbFileIO)
             return true;
+        const auto lock = LockWrites();
         return reinterpret_cast<Derived*>(this)->StoreRecordUnsafe(args...);
     }
 
@@ -349,6 +437,7 @@ public:
     {
         if(!is_system && DisableUserDbFileIO)
             return true;
+        const auto lock = LockWrites();
         return reinterpret_cast<Derived*>(this)->RemoveUnsafe(args...);
     }
 
@@ -358,6 +447,7 @@ public:
         using Ret = decltype(reinterpret_cast<Derived*>(this)->UpdateUnsafe(args...));
         if(!is_system && DisableUserDbFileIO)
             return Ret{};
+        const auto lock = LockWrites();
         return reinterpret_cast<Derived*>(this)->UpdateUnsafe(args...);
     }
 
@@ -369,10 +459,56 @@ public:
         return reinterpret_cast<Derived*>(this)->LoadUnsafe(args...);
     }
 
+    SQLiteDbBatch<Derived> BeginBatch()
+    {
+        return SQLiteDbBatch<Derived>{*reinterpret_cast<Derived*>(this)};
+    }
+
+    /// Applies the changes in order in a single transaction.
+    inline bool CommitBatch(const std::vector<std::function<bool(Derived&)>>& changes)
+    {
+        if(!is_system && DisableUserDbFileIO)
+            return true;
+        if(dbInvalid)
+            return false;
+
+        // The connection is shared, and SQLite transactions do not nest.
+        const auto lock = LockWrites();
+
+        MIOPEN_LOG_I2("Committing a batch of " << changes.size() << " records to " << filename);
+        sql.Exec("BEGIN IMMEDIATE;");
+        auto ok = true;
+
+        try
+        {
+            for(const auto& change : changes)
+                ok = change(*reinterpret_cast<Derived*>(this)) && ok;
+        }
+        catch(...)
+        {
+            sql.Exec("ROLLBACK;");
+            throw;
+        }
+
+        sql.Exec("COMMIT;");
+        if(ok)
+            DbStats::Get(db_kind).AddStore(changes.size());
+        return ok;
+    }
+
+    /// Taken by the writes, see SQLite::GetWriteMutex().
+    std::unique_lock<std::mutex> LockWrites() const
+    {
+        if(dbInvalid)
+            return {};
+        return std::unique_lock<std::mutex>{sql.GetWriteMutex()};
+    }
+
     std::string filename;
     bool dbInvalid;
     SQLite sql;
     bool is_system;
+    DbKinds db_kind;
 };
 
 template <typename Derived>
@@ -397,7 +533,7 @@ class SQLitePerfDb : public SQLiteBase<SQLitePerfDb>
 {
 public:
     static constexpr char const* MIOPEN_PERFDB_SCHEMA_VER = "1.1.0";
-    SQLitePerfDb(DbKinds db_kind, const std::string& filename_, bool is_system);
+    SQLitePerfDb(DbKinds db_kind_, const std::string& filename_, bool is_system);
 
     template <class T>
     inline void InsertConfig(const T& prob_desc)
@@ -405,7 +541,7 @@ public:
         std::string clause;
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.InsertQuery();
-        auto stmt              = SQLite::Statement{sql, clause, vals};
+        auto stmt              = sql.Prepare(clause, vals, false);
         auto rc                = stmt.Step(sql);
         if(rc != SQLITE_DONE)
         {
@@ -422,7 +558,7 @@ public:
         std::vector<std::string> vals;
         std::tie(clause, vals) = prob_desc.WhereClause();
         auto query = "SELECT id FROM " + prob_desc.table_name() + " WHERE ( " + clause + " );";
-        auto stmt  = SQLite::Statement{sql, query, vals};
+        auto stmt  = sql.Prepare(query, vals, true);
         while(true)
         {
             auto rc = stmt.Step(sql);
@@ -436,7 +572,7 @@ public:
             }
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
             {
-                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                MIOPEN_THROW(miopenStatusInternalError, stmt.ErrorMessage());
             }
         }
     }
@@ -481,7 +617,7 @@ public:
             "WHERE "
             "( " + clause + " );";
         // clang-format on
-        auto stmt = SQLite::Statement{sql, select_query, values};
+        auto stmt = sql.Prepare(select_query, values, true);
         DbRecord rec;
         while(true)
         {
@@ -496,7 +632,7 @@ public:
             }
             else if(rc == SQLITE_ERROR || rc == SQLITE_MISUSE)
             {
-                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+                MIOPEN_THROW(miopenStatusInternalError, stmt.ErrorMessage());
             }
         }
         if(rec.GetSize() == 0)
@@ -552,7 +688,7 @@ public:
             std::string clause;
             std::vector<std::string> vals;
             std::tie(clause, vals) = problem_config.InsertQuery();
-            auto stmt              = SQLite::Statement{sql, clause, vals};
+            auto stmt              = sql.Prepare(clause, vals, false);
             auto rc                = stmt.Step(sql);
             if(rc != SQLITE_DONE)
             {
@@ -581,7 +717,7 @@ public:
             // clang-format on
             vals.push_back(id);
             vals.push_back(params.str());
-            auto stmt = SQLite::Statement{sql, query, vals};
+            auto stmt = sql.Prepare(query, vals, false);
             auto rc   = stmt.Step(sql);
             if(rc != SQLITE_DONE)
             {
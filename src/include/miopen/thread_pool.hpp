@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_THREAD_POOL_HPP_
+#define GUARD_MIOPEN_THREAD_POOL_HPP_
+
+#include <miopen/config.h>
+#include <miopen/export.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+
+/// Stops a loop of ThreadPool::ParallelFor(): the chunks which are not started yet are skipped.
+/// The running ones are not interrupted.
+class CancellationToken
+{
+public:
+    void Cancel() { cancelled = true; }
+    bool IsCancelled() const { return cancelled; }
+
+private:
+    std::atomic<bool> cancelled{false};
+};
+
+/// Process-wide pool of the threads running the loops of par_for(). Each worker has a deque of
+/// tasks: it takes its own tasks from the back and steals the tasks of the others from the front.
+/// A loop is split into chunks, which are taken by the calling thread and by the workers that
+/// pick up its tasks, so the caller always makes progress. A loop called from a worker pushes its
+/// tasks to the deque of that worker, thus nested loops share the same threads instead of
+/// spawning more.
+///
+/// Workers are started on demand, up to the widest loop run, and never stopped before the exit.
+/// MIOPEN_THREAD_POOL_SIZE limits the number of workers, then the wider loops are run by fewer
+/// threads.
+class MIOPEN_EXPORT ThreadPool
+{
+public:
+    static ThreadPool& Get();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /// Calls f(i) for each i in [0, n), in chunks of `grain` consecutive indices, by at most
+    /// `width` threads including the caller. Returns when all of the calls are done. If a call
+    /// throws, the loop is cancelled and the first exception is rethrown.
+    void ParallelFor(std::size_t n,
+                     std::size_t width,
+                     std::size_t grain,
+                     const std::function<void(std::size_t)>& f,
+                     const CancellationToken* token = nullptr);
+
+    std::size_t GetWorkerCount() const;
+
+private:
+    struct Loop;
+    using Task = std::shared_ptr<Loop>;
+
+    struct Worker
+    {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+        std::thread thread;
+    };
+
+    std::size_t limit;
+    mutable std::mutex mutex;
+    std::condition_variable work;
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::atomic<std::size_t> worker_count{0};
+    std::atomic<std::size_t> queued{0};
+    std::atomic<std::size_t> next_worker{0};
+    bool stopping = false;
+
+    ThreadPool();
+
+    void StartWorkers(std::size_t count);
+    void Push(const Task& task);
+    Task Pop(std::size_t self);
+    void Run(std::size_t self);
+    void Stop();
+};
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_THREAD_POOL_HPP_
@@ -50,16 +50,10 @@ private:
 
 class CompileTimer
 {
-#if MIOPEN_BUILD_DEV
     Timer timer;
-#endif
+
 public:
-    CompileTimer()
-    {
-#if MIOPEN_BUILD_DEV
-        timer.start();
-#endif
-    }
+    CompileTimer() { timer.start(); }
     void Log(const std::string& s1, const std::string& s2 = {})
     {
 #if MIOPEN_BUILD_DEV
@@ -70,6 +64,8 @@ public:
         (void)s2;
 #endif
     }
+    /// Also in release builds, for the compile time estimates of CompileScheduler.
+    float ElapsedMs() { return timer.elapsed_ms(); }
 };
 
 } // namespace miopen
@@ -0,0 +1,76 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_WARMUP_HPP_
+#define GUARD_MIOPEN_WARMUP_HPP_
+
+#include <miopen/export.h>
+#include <miopen/kernel_info.hpp>
+
+#include <cstddef>
+#include <istream>
+#include <vector>
+
+namespace miopen {
+
+struct Handle;
+struct Problem;
+
+struct WarmUpStats
+{
+    std::size_t problems = 0; ///< Problems passed to the warm-up.
+    std::size_t warmed   = 0; ///< Problems with all the selected solutions prepared.
+    std::size_t skipped  = 0; ///< Problems of unsupported kinds, e.g. fused ones.
+    float time_ms        = 0;
+
+    float GetProblemsPerSecond() const { return time_ms > 0 ? problems * 1000.0f / time_ms : 0; }
+};
+
+/// Prepares the handle for the first Find or immediate mode call for each of the convolution
+/// problems, so that it costs as much as the following ones. The solutions are selected as
+/// the call would select them: from the find-db record, or by the immediate mode fallback if
+/// there is no record. Their kernels are loaded or built, and their invokers are registered in
+/// the invoker cache of the handle, the fastest solution of each algorithm as the find 1.0
+/// result. Nothing is run on the device.
+///
+/// The solutions of independent problems are selected and their kernels are built in parallel.
+/// A problem that fails to warm up is logged and skipped.
+WarmUpStats WarmUp(Handle& handle, const std::vector<Problem>& problems);
+
+/// Reads the convolution problems of MIOpenDriver command lines, e.g. those logged with
+/// MIOPEN_ENABLE_LOGGING_CMD=1. Lines without a convolution command are skipped, and so are,
+/// with a warning, the commands which cannot be parsed.
+MIOPEN_EXPORT std::vector<Problem> ReadDriverCommands(std::istream& stream);
+
+/// The kernels of all the solvers applicable to the convolution problems, with the tuning from
+/// the perf-db or the default one, as they are used without a search. The duplicates are
+/// removed. Nothing is built or run, so the kernels of another device can be collected with a
+/// handle of the HIPNOGPU backend, see MIOPEN_DEVICE_ARCH and MIOPEN_DEVICE_CU.
+MIOPEN_EXPORT std::vector<solver::KernelInfo> CollectKernels(Handle& handle,
+                                                             const std::vector<Problem>& problems);
+
+} // namespace miopen
+
+#endif // GUARD_MIOPEN_WARMUP_HPP_
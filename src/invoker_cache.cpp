@@ -29,12 +29,37 @@
 
 namespace miopen {
 
+namespace {
+
+// The sizes are approximate, the state captured by the invokers is not known.
+std::ptrdiff_t GetStringSize(const std::string& str)
+{
+    return static_cast<std::ptrdiff_t>(sizeof(str) + str.size());
+}
+
+std::ptrdiff_t GetInvokerSize(const std::string& solver_id)
+{
+    return GetStringSize(solver_id) + static_cast<std::ptrdiff_t>(sizeof(Invoker));
+}
+
+// Solver ids are short enough to be stored in the string objects.
+std::ptrdiff_t GetFound1_0Size(const std::string& algorithm)
+{
+    return GetStringSize(algorithm) + static_cast<std::ptrdiff_t>(sizeof(std::string));
+}
+
+} // namespace
+
+InvokerCache::InvokerCache() : invokers(Value(ENV(MIOPEN_INVOKER_CACHE_LIMIT))) {}
+
+bool InvokerCache::IsBounded() { return Value(ENV(MIOPEN_INVOKER_CACHE_LIMIT)) != 0; }
+
 boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
 {
-    const auto item = invokers.find(key.first);
-    if(item == invokers.end())
+    const auto item = invokers.Find(key.first);
+    if(item == nullptr)
         return boost::none;
-    const auto& item_invokers = item->second.invokers;
+    const auto& item_invokers = item->invokers;
     const auto invoker        = item_invokers.find(key.second);
     if(invoker == item_invokers.end())
         return boost::none;
@@ -44,20 +69,20 @@ boost::optional<const Invoker&> InvokerCache::operator[](const Key& key) const
 boost::optional<const Invoker&> InvokerCache::GetFound1_0(const std::string& network_config,
                                                           const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    const auto item = invokers.Find(network_config);
+    if(item == nullptr)
     {
         MIOPEN_LOG_I2("No invokers found for " << network_config);
         return boost::none;
     }
-    if(item->second.found_1_0.empty())
+    if(item->found_1_0.empty())
     {
         MIOPEN_LOG_I2("Invokers found for " << network_config
                                             << " but there is no find 1.0 result.");
         return boost::none;
     }
-    const auto& item_invokers = item->second.invokers;
-    const auto& found_1_0_ids = item->second.found_1_0;
+    const auto& item_invokers = item->invokers;
+    const auto& found_1_0_ids = item->found_1_0;
     const auto found_1_0_id   = found_1_0_ids.find(algorithm);
     if(found_1_0_id == found_1_0_ids.end())
     {
@@ -78,41 +103,39 @@ boost::optional<const std::string&>
 InvokerCache::GetFound1_0SolverId(const std::string& network_config,
                                   const std::string& algorithm) const
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    const auto item = invokers.Find(network_config);
+    if(item != nullptr)
     {
-        MIOPEN_LOG_I2("No invokers found for " << network_config);
-        return boost::none;
+        const auto found_1_0_id = item->found_1_0.find(algorithm);
+        if(found_1_0_id != item->found_1_0.end())
+            return found_1_0_id->second;
     }
-    if(item->second.found_1_0.empty())
-    {
-        MIOPEN_LOG_I2("Invokers found for " << network_config
-                                            << " but there is no find 1.0 result.");
-        return boost::none;
-    }
-    const auto& found_1_0_ids = item->second.found_1_0;
-    const auto found_1_0_id   = found_1_0_ids.find(algorithm);
-    if(found_1_0_id == found_1_0_ids.end())
+
+    const auto evicted = evicted_found_1_0.find(network_config);
+    if(evicted != evicted_found_1_0.end())
     {
-        MIOPEN_LOG_I2("Invokers found for "
-                      << network_config << " but there is no one with an algorithm " << algorithm);
-        return boost::none;
+        const auto found_1_0_id = evicted->second.find(algorithm);
+        if(found_1_0_id != evicted->second.end())
+            return found_1_0_id->second;
     }
-    return found_1_0_id->second;
+
+    MIOPEN_LOG_I2("No find 1.0 result for " << network_config << " and algorithm " << algorithm);
+    return boost::none;
 }
 
 void InvokerCache::Register(const Key& key, const Invoker& invoker)
 {
-    auto it = invokers.find(key.first);
-    if(it != invokers.end())
-    {
-        it->second.invokers.insert({key.second, invoker});
-    }
-    else
-    {
-        auto& item = invokers.insert({key.first, Item{}}).first->second;
-        item.invokers.insert({key.second, invoker});
-    }
+    auto inserted = invokers.TryEmplace(
+        key.first, [&](const std::string& network_config, const Item& item) {
+            Evict(network_config, item);
+        });
+
+    if(inserted.second)
+        resident_bytes.Add(GetStringSize(key.first) + static_cast<std::ptrdiff_t>(sizeof(Item)));
+
+    if(inserted.first.invokers.insert({key.second, invoker}).second)
+        resident_bytes.Add(GetInvokerSize(key.second));
+
     MIOPEN_LOG_I2("Invoker registered for algorithm " << key.first << " and solver " << key.second);
 }
 
@@ -120,13 +143,13 @@ void InvokerCache::SetAsFound1_0(const std::string& network_config,
                                  const std::string& algorithm,
                                  const std::string& solver_id)
 {
-    const auto item = invokers.find(network_config);
-    if(item == invokers.end())
+    const auto item = invokers.Find(network_config);
+    if(item == nullptr)
         MIOPEN_THROW("No invoker was registered for " + network_config);
 
     {
         // Validating at find time
-        const auto& item_invokers = item->second.invokers;
+        const auto& item_invokers = item->invokers;
         const auto invoker        = item_invokers.find(solver_id);
         if(invoker == item_invokers.end())
         {
@@ -135,9 +158,39 @@ void InvokerCache::SetAsFound1_0(const std::string& network_config,
         }
     }
 
-    item->second.found_1_0[algorithm] = solver_id;
+    if(item->found_1_0.count(algorithm) == 0)
+        resident_bytes.Add(GetFound1_0Size(algorithm));
+    item->found_1_0[algorithm] = solver_id;
+
     MIOPEN_LOG_I2("Solver " << solver_id << " registered as find 1.0 best for " << algorithm
                             << " in " << network_config);
 }
 
+void InvokerCache::Evict(const std::string& network_config, const Item& item)
+{
+    MIOPEN_LOG_I2("Evicting invokers for " << network_config);
+
+    auto size = GetStringSize(network_config) + static_cast<std::ptrdiff_t>(sizeof(Item));
+    for(const auto& invoker : item.invokers)
+        size += GetInvokerSize(invoker.first);
+    for(const auto& found : item.found_1_0)
+        size += GetFound1_0Size(found.first);
+
+    resident_bytes.Add(-size);
+    DbStats::Get(DbStats::Kind::InvokerCache).AddEvictions();
+
+    if(item.found_1_0.empty())
+        return;
+
+    auto inserted = evicted_found_1_0.insert({network_config, {}});
+    if(inserted.second)
+        resident_bytes.Add(GetStringSize(network_config));
+    for(const auto& found : item.found_1_0)
+    {
+        if(inserted.first->second.count(found.first) == 0)
+            resident_bytes.Add(GetFound1_0Size(found.first));
+        inserted.first->second[found.first] = found.second;
+    }
+}
+
 } // namespace miopen
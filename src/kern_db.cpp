@@ -25,18 +25,23 @@
  *******************************************************************************/
 #include <miopen/kern_db.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <vector>
+
 namespace miopen {
-KernDb::KernDb(DbKinds db_kind, const std::string& filename_, bool is_system_)
-    : KernDb(db_kind, filename_, is_system_, compress, decompress)
+KernDb::KernDb(DbKinds db_kind_, const std::string& filename_, bool is_system_)
+    : KernDb(db_kind_, filename_, is_system_, compress, decompress)
 {
 }
 
-KernDb::KernDb(DbKinds db_kind,
+KernDb::KernDb(DbKinds db_kind_,
                const std::string& filename_,
                bool is_system_,
                std::function<std::string(std::string, bool*)> compress_fn_,
                std::function<std::string(std::string, unsigned int)> decompress_fn_)
-    : SQLiteBase(db_kind, filename_, is_system_),
+    : SQLiteBase(db_kind_, filename_, is_system_),
       compress_fn(compress_fn_),
       decompress_fn(decompress_fn_)
 {
@@ -64,7 +69,178 @@ KernDb::KernDb(DbKinds db_kind,
            << filename;
         MIOPEN_LOG_W(ss.str());
         dbInvalid = true;
+        return;
     }
+    if(!is_system)
+    {
+        try
+        {
+            // The user dbs of older versions do not have the column.
+            if(!CheckTableColumns(KernelConfig::table_name(), {"last_access"}))
+                sql.Exec("ALTER TABLE `" + KernelConfig::table_name() +
+                         "` ADD COLUMN `last_access` INT NOT NULL DEFAULT 0;");
+            track_access = true;
+        }
+        catch(const Exception& ex)
+        {
+            MIOPEN_LOG_W("Unable to track the kernel use in " << filename << ": " << ex.what());
+        }
+    }
+}
+
+std::int64_t KernDb::GetAccessTime()
+{
+    const auto now = std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::seconds>(now).count();
+}
+
+void KernDb::Touch(std::int64_t id, std::int64_t last_access)
+{
+    const auto now = GetAccessTime();
+    if(now - last_access < access_resolution)
+        return;
+
+    // Not worth waiting for the writes of the other threads.
+    const auto lock = std::unique_lock<std::mutex>{sql.GetWriteMutex(), std::try_to_lock};
+    if(!lock)
+        return;
+
+    try
+    {
+        auto stmt = sql.Prepare("UPDATE `" + KernelConfig::table_name() +
+                                    "` SET last_access = ? WHERE id = ?;",
+                                {},
+                                false);
+        stmt.BindInt64(1, now);
+        stmt.BindInt64(2, id);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_LOG_I2("Unable to update the kernel access time: " << sql.ErrorMessage());
+    }
+    catch(const Exception& ex)
+    {
+        // The lookup itself has succeeded.
+        MIOPEN_LOG_I2("Unable to update the kernel access time: " << ex.what());
+    }
+}
+
+KernelCacheUsage KernDb::GetUsage()
+{
+    if(filename.empty() || dbInvalid)
+        return {};
+
+    auto stmt = sql.Prepare("SELECT COUNT(*), IFNULL(SUM(LENGTH(kernel_blob)), 0) FROM `" +
+                                KernelConfig::table_name() + "`;",
+                            {},
+                            false);
+    if(stmt.Step(sql) != SQLITE_ROW)
+        MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+
+    auto usage    = KernelCacheUsage{};
+    usage.kernels = stmt.ColumnInt64(0);
+    usage.bytes   = stmt.ColumnInt64(1);
+    return usage;
+}
+
+KernelCacheUsage KernDb::Trim(std::size_t max_bytes, std::int64_t unused_since, bool compact)
+{
+    if(filename.empty() || dbInvalid || is_system)
+        return {};
+    if(!track_access)
+        return GetUsage();
+
+    const auto lock = LockWrites();
+    sql.Exec("BEGIN IMMEDIATE;");
+    auto usage = KernelCacheUsage{};
+
+    try
+    {
+        usage = GetUsage();
+
+        auto evicted = std::vector<std::int64_t>{};
+        {
+            auto stmt = sql.Prepare("SELECT id, LENGTH(kernel_blob), last_access FROM `" +
+                                        KernelConfig::table_name() +
+                                        "` ORDER BY last_access ASC, id ASC;",
+                                    {},
+                                    false);
+            while(stmt.Step(sql) == SQLITE_ROW)
+            {
+                const auto size = static_cast<std::size_t>(stmt.ColumnInt64(1));
+                if(usage.bytes <= max_bytes && stmt.ColumnInt64(2) >= unused_since)
+                    break;
+                evicted.push_back(stmt.ColumnInt64(0));
+                usage.bytes -= std::min(size, usage.bytes);
+                --usage.kernels;
+            }
+        }
+
+        for(const auto id : evicted)
+        {
+            auto stmt = sql.Prepare(
+                "DELETE FROM `" + KernelConfig::table_name() + "` WHERE id = ?;", {}, false);
+            stmt.BindInt64(1, id);
+            if(stmt.Step(sql) != SQLITE_DONE)
+                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+        }
+
+        sql.Exec("COMMIT;");
+        MIOPEN_LOG_I2("Removed " << evicted.size() << " kernels from " << filename);
+    }
+    catch(...)
+    {
+        sql.Exec("ROLLBACK;");
+        throw;
+    }
+
+    if(compact)
+        sql.Exec("VACUUM;");
+    return usage;
+}
+
+KernelCacheUsage KernDb::Merge(const std::string& other)
+{
+    if(filename.empty() || dbInvalid || is_system)
+        MIOPEN_THROW(miopenStatusInvalidValue, "Unable to write to the kernel db " + filename);
+
+    const auto lock = LockWrites();
+    {
+        auto stmt = sql.Prepare("ATTACH DATABASE ? AS `other`;", {other}, false);
+        if(stmt.Step(sql) != SQLITE_DONE)
+            MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+    }
+
+    try
+    {
+        // The kernels keep their compression, hash and size, so the blobs are copied as they are.
+        sql.Exec("INSERT OR REPLACE INTO `" + KernelConfig::table_name() +
+                 "` (kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size) "
+                 "SELECT kernel_name, kernel_args, kernel_blob, kernel_hash, uncompressed_size "
+                 "FROM `other`.`" +
+                 KernelConfig::table_name() + "`;");
+    }
+    catch(...)
+    {
+        sql.Exec("DETACH DATABASE `other`;");
+        throw;
+    }
+
+    sql.Exec("DETACH DATABASE `other`;");
+    MIOPEN_LOG_I2("Merged the kernels of " << other << " into " << filename);
+    return GetUsage();
+}
+
+void KernDb::PrepareForInstall()
+{
+    if(filename.empty() || dbInvalid || is_system)
+        MIOPEN_THROW(miopenStatusInvalidValue, "Unable to write to the kernel db " + filename);
+
+    const auto lock = LockWrites();
+    // A db in the WAL mode can't be read without its -wal and -shm files, which SQLite is unable
+    // to create in a read-only directory.
+    const auto res = sql.Exec("PRAGMA journal_mode=DELETE;");
+    if(res.empty() || res[0].at("journal_mode") != "delete")
+        MIOPEN_THROW(miopenStatusInternalError, "Unable to leave the WAL mode of " + filename);
+    sql.Exec("VACUUM;");
 }
 
 } // namespace miopen
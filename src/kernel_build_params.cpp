@@ -24,6 +24,7 @@
  *
  *******************************************************************************/
 
+#include <algorithm>
 #include <sstream>
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -63,6 +64,77 @@ static std::string GenerateDefines(const std::vector<KernelBuildParameter>& opti
     return JoinStrings(strs, " ");
 }
 
+/// Returns the length of the prefix of the define, or 0 if the token is not a define.
+static std::size_t GetDefinePrefixSize(const std::string& token)
+{
+    for(const auto prefix : {"-D", "-U", "-Wa,-defsym,"})
+    {
+        if(StartsWith(token, prefix))
+            return std::char_traits<char>::length(prefix);
+    }
+    return 0;
+}
+
+std::string KernelBuildParameters::Canonicalize(const std::string& options)
+{
+    if(options.find_first_of("\"'") != std::string::npos)
+    {
+        const auto first = options.find_first_not_of(" \t\n");
+        if(first == std::string::npos)
+            return {};
+        return options.substr(first, options.find_last_not_of(" \t\n") - first + 1);
+    }
+
+    struct Define
+    {
+        std::string name;
+        std::string token;
+    };
+
+    auto others  = std::vector<std::string>{};
+    auto defines = std::vector<Define>{};
+    auto stream  = std::istringstream{options};
+    auto token   = std::string{};
+
+    while(stream >> token)
+    {
+        // The name may be a separate argument, as in "-D NAME".
+        if(token == "-D" || token == "-U")
+        {
+            auto name = std::string{};
+            if(stream >> name)
+                token += name;
+        }
+
+        const auto prefix = GetDefinePrefixSize(token);
+        if(prefix == 0 || prefix == token.size())
+        {
+            others.push_back(token);
+            continue;
+        }
+
+        const auto end = token.find('=', prefix);
+        defines.push_back({token.substr(prefix, end - prefix), token});
+    }
+
+    // Redefinitions of the same name keep their order.
+    std::stable_sort(defines.begin(), defines.end(), [](const auto& left, const auto& right) {
+        return left.name < right.name;
+    });
+
+    auto canonical = std::string{};
+    canonical.reserve(options.size());
+    const auto append = [&](const std::string& item) {
+        if(!canonical.empty())
+            canonical += ' ';
+        canonical += item;
+    };
+    std::for_each(others.begin(), others.end(), append);
+    for(const auto& define : defines)
+        append(define.token);
+    return canonical;
+}
+
 std::string kbp::OpenCL::Generate(const std::vector<KernelBuildParameter>& options)
 {
     // Ensure only one space after the -cl-std.
@@ -41,54 +41,133 @@
 
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
+#include <miopen/kernel_build_params.hpp>
 #include <miopen/kernel_cache.hpp>
 #include <miopen/logger.hpp>
 #include <miopen/stringutils.hpp>
 
 #include <iostream>
 #include <iterator>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 
 MIOPEN_DECLARE_ENV_VAR_STR(MIOPEN_DEVICE_ARCH)
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_KERNEL_CACHE_LIMIT)
 
 namespace miopen {
 
-const std::vector<Kernel>& KernelCache::GetKernels(const std::string& algorithm,
-                                                   const std::string& network_config)
+namespace {
+
+std::ptrdiff_t GetKeySize(const KernelCache::Key& key)
+{
+    return static_cast<std::ptrdiff_t>(sizeof(key) + key.first.size() + key.second.size());
+}
+
+std::ptrdiff_t GetProgramSize(const Program& program)
 {
+#if MIOPEN_BACKEND_HIP
+    return static_cast<std::ptrdiff_t>(sizeof(program) + program.GetCodeObjectSize());
+#else
+    return static_cast<std::ptrdiff_t>(sizeof(program));
+#endif
+}
+
+std::ptrdiff_t GetKernelsSize(std::size_t count)
+{
+    return static_cast<std::ptrdiff_t>(count * sizeof(Kernel));
+}
+
+std::ptrdiff_t GetKernelsSize(const KernelCache::KernelsPtr& kernels)
+{
+    return kernels == nullptr ? 0 : GetKernelsSize(kernels->size());
+}
 
-    std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
+} // namespace
 
-    const auto it = kernel_map.find(key);
-    if(it != kernel_map.end())
+KernelCache::KernelsPtr KernelCache::GetKernels(const std::string& algorithm,
+                                                const std::string& network_config) const
+{
+    static const auto empty = std::make_shared<const std::vector<Kernel>>();
+
+    auto kernels = KernelsPtr{};
+    {
+        std::shared_lock<std::shared_timed_mutex> lock(mutex);
+        const auto entry = kernel_map.Find(SimpleHash{}(algorithm, network_config));
+        if(entry != nullptr && entry->Matches(algorithm, network_config))
+            kernels = entry->value;
+    }
+
+    if(kernels != nullptr)
     {
-        MIOPEN_LOG_I2(it->second.size()
-                      << " kernels for key: " << key.first << " \"" << key.second << '\"');
-        return it->second;
+        MIOPEN_LOG_I2(kernels->size()
+                      << " kernels for key: " << algorithm << " \"" << network_config << '\"');
+        return kernels;
     }
 
-    static const std::vector<Kernel> empty{};
-    MIOPEN_LOG_I2("0 kernels for key: " << key.first << " \"" << key.second << '\"');
+    MIOPEN_LOG_I2("0 kernels for key: " << algorithm << " \"" << network_config << '\"');
     return empty;
 }
 
+const Program* KernelCache::FindProgram(const std::string& name, const std::string& params) const
+{
+    const auto entry = program_map.Find(SimpleHash{}(name, params));
+    if(entry == nullptr || !entry->Matches(name, params))
+        return nullptr;
+    return &entry->value;
+}
+
 bool KernelCache::HasProgram(const std::string& name, const std::string& params) const
 {
-    const auto key = std::make_pair(name, params);
-    return program_map.count(key) > 0;
+    const auto canonical_params = KernelBuildParameters::Canonicalize(params);
+    std::shared_lock<std::shared_timed_mutex> lock(mutex);
+    return FindProgram(name, canonical_params) != nullptr;
 }
 
 void KernelCache::ClearProgram(const std::string& name, const std::string& params)
 {
-    if(HasProgram(name, params))
+    const auto canonical_params = KernelBuildParameters::Canonicalize(params);
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    const auto hash  = SimpleHash{}(name, canonical_params);
+    const auto entry = program_map.Find(hash);
+    if(entry != nullptr && entry->Matches(name, canonical_params))
     {
-        const auto key = std::make_pair(name, params);
-        program_map.erase(key);
+        resident_bytes.Add(-GetKeySize(entry->key) - GetProgramSize(entry->value));
+        program_map.Erase(hash);
     }
 }
 
 void KernelCache::AddProgram(Program prog, const std::string& program_name, std::string params)
 {
-    program_map[std::make_pair(program_name, params)] = prog;
+    auto key = std::make_pair(program_name, KernelBuildParameters::Canonicalize(params));
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    StoreProgram(key, prog);
+}
+
+void KernelCache::StoreProgram(const Key& key, const Program& program)
+{
+    auto inserted = program_map.TryEmplace(
+        SimpleHash{}(key.first, key.second),
+        [&](std::size_t, const Entry<Program>& evicted) {
+            MIOPEN_LOG_I2("Evicting program " << evicted.key.first);
+            resident_bytes.Add(-GetKeySize(evicted.key) - GetProgramSize(evicted.value));
+            DbStats::Get(DbStats::Kind::KernelCache).AddEvictions();
+        },
+        Entry<Program>{key, program});
+
+    auto& entry = inserted.first;
+    if(inserted.second)
+    {
+        resident_bytes.Add(GetKeySize(key) + GetProgramSize(program));
+    }
+    else
+    {
+        // The entry may have another key with the same hash, then it is replaced.
+        resident_bytes.Add(GetKeySize(key) - GetKeySize(entry.key) + GetProgramSize(program) -
+                           GetProgramSize(entry.value));
+        entry.key   = key;
+        entry.value = program;
+    }
 }
 
 Kernel KernelCache::AddKernel(const Handle& h,
@@ -102,21 +181,30 @@ Kernel KernelCache::AddKernel(const Handle& h,
                               std::size_t cache_index,
                               const std::string& kernel_src)
 {
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
     if(!network_config.empty() || !algorithm.empty()) // Don't log only _empty_ keys.
-        MIOPEN_LOG_I2("Key: " << key.first << " \"" << key.second << '\"');
+        MIOPEN_LOG_I2("Key: " << algorithm << " \"" << network_config << '\"');
 
-    Program program;
+    // The programs are keyed by the canonical options, and built with the given ones.
+    const auto canonical_params = KernelBuildParameters::Canonicalize(params);
 
-    auto program_it = program_map.find(std::make_pair(program_name, params));
-    if(program_it != program_map.end())
+    Program program;
+    auto cached = false;
     {
-        program = program_it->second;
+        std::shared_lock<std::shared_timed_mutex> lock(mutex);
+        const auto found = FindProgram(program_name, canonical_params);
+        if(found != nullptr)
+        {
+            program = *found;
+            cached  = true;
+        }
     }
-    else
+
+    // The program is built without the lock, so the lookups of other threads do not wait.
+    if(!cached)
     {
         program = h.LoadProgram(program_name, params, kernel_src);
-        program_map[std::make_pair(program_name, params)] = program;
+        std::unique_lock<std::shared_timed_mutex> lock(mutex);
+        StoreProgram(std::make_pair(program_name, canonical_params), program);
     }
 
     Kernel kernel{};
@@ -132,19 +220,47 @@ Kernel KernelCache::AddKernel(const Handle& h,
 
     if(!network_config.empty() && !algorithm.empty())
     {
-        this->AddKernel(key, kernel, cache_index);
+        this->AddKernel(std::make_pair(algorithm, network_config), kernel, cache_index);
     }
     return kernel;
 }
 
-void KernelCache::AddKernel(Key key, Kernel k, std::size_t cache_index)
+void KernelCache::AddKernel(const Key& key, Kernel k, std::size_t cache_index)
 {
-    auto&& v = kernel_map[key];
-    if(cache_index >= v.size())
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    auto inserted = kernel_map.TryEmplace(
+        SimpleHash{}(key.first, key.second),
+        [&](std::size_t, const Entry<KernelsPtr>& evicted) {
+            MIOPEN_LOG_I2("Evicting " << (evicted.value == nullptr ? 0 : evicted.value->size())
+                                      << " kernels for key: " << evicted.key.first << " \""
+                                      << evicted.key.second << '\"');
+            resident_bytes.Add(-GetKeySize(evicted.key) - GetKernelsSize(evicted.value));
+            DbStats::Get(DbStats::Kind::KernelCache).AddEvictions();
+        },
+        Entry<KernelsPtr>{key, nullptr});
+
+    auto& entry = inserted.first;
+    if(inserted.second)
+    {
+        resident_bytes.Add(GetKeySize(key));
+    }
+    else if(!entry.Matches(key.first, key.second))
+    {
+        // Another key with the same hash, its kernels are replaced.
+        resident_bytes.Add(GetKeySize(key) - GetKeySize(entry.key) - GetKernelsSize(entry.value));
+        entry.key   = key;
+        entry.value = nullptr;
+    }
+
+    // The set is copied, so the readers of the previous one are not affected.
+    auto kernels = entry.value == nullptr ? std::vector<Kernel>{} : *entry.value;
+    if(cache_index >= kernels.size())
     {
-        v.resize(cache_index + 1);
+        resident_bytes.Add(GetKernelsSize(cache_index + 1 - kernels.size()));
+        kernels.resize(cache_index + 1);
     }
-    v[cache_index] = k;
+    kernels[cache_index] = k;
+    entry.value          = std::make_shared<const std::vector<Kernel>>(std::move(kernels));
 }
 
 void KernelCache::ClearKernels(const std::string& algorithm, const std::string& network_config)
@@ -153,15 +269,21 @@ void KernelCache::ClearKernels(const std::string& algorithm, const std::string&
     {
         MIOPEN_THROW("Network config or algorithm empty.");
     }
-    const std::pair<std::string, std::string> key = std::make_pair(algorithm, network_config);
-    auto&& v                                      = this->kernel_map[key];
-    if(!v.empty())
-    {
-        MIOPEN_LOG_I2(v.size() << " kernels for key: " << key.first << " \"" << key.second << '\"');
-    }
-    v.clear();
+    std::unique_lock<std::shared_timed_mutex> lock(mutex);
+    const auto entry = this->kernel_map.Find(SimpleHash{}(algorithm, network_config));
+    if(entry == nullptr || !entry->Matches(algorithm, network_config) || entry->value == nullptr ||
+       entry->value->empty())
+        return;
+    MIOPEN_LOG_I2(entry->value->size()
+                  << " kernels for key: " << algorithm << " \"" << network_config << '\"');
+    resident_bytes.Add(-GetKernelsSize(entry->value));
+    entry->value = nullptr;
 }
 
-KernelCache::KernelCache() {}
+KernelCache::KernelCache()
+    : kernel_map(Value(ENV(MIOPEN_KERNEL_CACHE_LIMIT))),
+      program_map(Value(ENV(MIOPEN_KERNEL_CACHE_LIMIT)))
+{
+}
 
 } // namespace miopen
@@ -89,8 +89,8 @@ LockFile::LockFile(const char* path_, PassKey) : path(path_)
 
 LockFile& LockFile::Get(const char* path)
 {
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& mutex = *new std::mutex{};
     std::lock_guard<std::mutex> lock(mutex);
 
     { // To guarantee that construction won't be called if not required.
@@ -0,0 +1,75 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/mapped_file.hpp>
+#include <miopen/logger.hpp>
+
+#include <fstream>
+#include <sstream>
+
+namespace miopen {
+
+MappedFile::MappedFile(const fs::path& path)
+{
+    if(fs::file_size(path) == 0)
+        return;
+
+    namespace bi = boost::interprocess;
+    mapping      = bi::file_mapping{path.c_str(), bi::read_only};
+    region       = bi::mapped_region{mapping, bi::read_only};
+}
+
+bool MappedFile::AdviseWillNeed()
+{
+    if(region.get_size() == 0)
+        return true;
+    return region.advise(boost::interprocess::mapped_region::advice_willneed);
+}
+
+boost::optional<std::string_view>
+MapOrReadFile(const fs::path& path, MappedFile& mapping, std::string& buffer)
+{
+    try
+    {
+        mapping = MappedFile{path};
+        return mapping.View();
+    }
+    catch(const std::exception& ex)
+    {
+        MIOPEN_LOG_I2("Unable to map " << path << ": " << ex.what() << ", reading it instead");
+    }
+
+    auto file = std::ifstream{path, std::ios::binary};
+    if(!file)
+        return boost::none;
+
+    auto ss = std::ostringstream{};
+    ss << file.rdbuf();
+    buffer = ss.str();
+    return std::string_view{buffer};
+}
+
+} // namespace miopen
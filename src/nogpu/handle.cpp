@@ -28,7 +28,10 @@
 #include <miopen/config.h>
 #include <miopen/handle.hpp>
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_lease.hpp>
+#include <miopen/compile_scheduler.hpp>
 #include <miopen/target_properties.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/handle_lock.hpp>
 #include <miopen/invoker.hpp>
@@ -52,15 +55,19 @@
 #include <algorithm>
 #include <cassert>
 #include <chrono>
+#include <optional>
 #include <thread>
 #include <miopen/nogpu/handle_impl.hpp>
 
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DEVICE_CU)
+
 namespace miopen {
 
 Handle::Handle(miopenAcceleratorQueue_t /* stream */) : Handle::Handle() {}
 
 Handle::Handle() : impl(new HandleImpl())
 {
+    this->impl->num_cu = Value(ENV(MIOPEN_DEVICE_CU));
     this->impl->target_properties.Init(this);
     MIOPEN_LOG_NQI(*this);
 }
@@ -155,8 +162,8 @@ void Handle::ClearProgram(const std::string& program_name, const std::string& pa
     this->impl->cache.ClearProgram(program_name, params);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -174,6 +181,18 @@ Program Handle::LoadProgram(const std::string& program_name,
 
     auto hsaco = miopen::LoadBinary(
         this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+
+    // Let one of the processes sharing the cache build the object while the others wait for it
+    std::optional<CompileLease> lease;
+    if(hsaco.empty())
+    {
+        lease.emplace(this->GetTargetProperties(), program_name, params);
+        hsaco = lease->Wait([&]() {
+            return miopen::LoadBinary(
+                this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+        });
+    }
+
     auto pgmImpl     = std::make_shared<HIPOCProgramImpl>();
     pgmImpl->program = program_name;
     pgmImpl->target  = this->GetTargetProperties();
@@ -182,7 +201,10 @@ Program Handle::LoadProgram(const std::string& program_name,
     if(hsaco.empty())
     {
         // avoid the constructor since it implicitly calls the HIP API
+        CompileTimer ct;
         pgmImpl->BuildCodeObject(params, kernel_src);
+        ct.Log("Kernel", program_name);
+        RecordCompileTime(program_name, ct.ElapsedMs());
 // auto p = HIPOCProgram{program_name, params, this->GetTargetProperties(), kernel_src};
 
 // Save to cache
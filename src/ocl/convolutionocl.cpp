@@ -37,6 +37,7 @@
 #include <miopen/float_equal.hpp>
 #include <miopen/generic_search_controls.hpp>
 #include <miopen/invoker.hpp>
+#include <miopen/invoker_cache.hpp>
 #include <miopen/kernel.hpp>
 #include <miopen/solver.hpp>
 #include <miopen/tensor_ops.hpp>
@@ -51,8 +52,11 @@
 #include <miopen/conv/wrw_invoke_params.hpp>
 #include <miopen/conv/heuristics/ai_heuristics.hpp>
 
+#include <algorithm>
 #include <cassert>
+#include <cmath>
 #include <functional>
+#include <limits>
 #include <type_traits>
 
 #include <boost/range/adaptors.hpp>
@@ -175,6 +179,30 @@ Invoker LoadOrPrepareInvoker(const ExecutionContext& ctx,
     return PrepareInvoker(ctx, problem, config, solver_id);
 }
 
+/// Returns the invoker of the find 1.0 result for the algorithm. If the invoker cache is bounded,
+/// the invoker may have been evicted after the find. Then it is prepared again for the solver
+/// found, which the cache keeps, so neither the find nor the find-db is needed.
+static boost::optional<const Invoker&> GetFound1_0Invoker(Handle& handle,
+                                                         const conv::ProblemDescription& problem,
+                                                         const NetworkConfig& config,
+                                                         const AlgorithmName& algorithm)
+{
+    const auto invoker = handle.GetInvoker(config, boost::none, algorithm);
+    if(invoker || !InvokerCache::IsBounded())
+        return invoker;
+
+    const auto found_id = handle.GetFound1_0SolverId(config, algorithm);
+    if(!found_id)
+        return boost::none;
+
+    // The reference is invalidated when the invoker is registered.
+    const auto solver_id = solver::Id{*found_id};
+    MIOPEN_LOG_I("Restoring the invoker of " << solver_id.ToString() << " for "
+                                             << config.ToString());
+    PrepareInvoker(ExecutionContext{&handle}, problem, config, solver_id);
+    return handle.GetInvoker(config, boost::none, algorithm);
+}
+
 static void
 CompileSolution(solver::Id solver_id, ExecutionContext ctx, const conv::ProblemDescription& problem)
 {
@@ -523,7 +551,8 @@ void ConvolutionDescriptor::ConvolutionForward(Handle& handle,
         const auto problem =
             conv::ProblemDescription{xDesc, wDesc, yDesc, *this, conv::Direction::Forward};
         const auto network_config = problem.MakeNetworkConfig();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto& invoker =
+            GetFound1_0Invoker(handle, problem, network_config, algorithm_name);
 
         if(invoker)
         {
@@ -756,6 +785,19 @@ std::vector<miopenConvSolution_t> GetSolutions(const ExecutionContext& ctx,
     });
     interim.erase(to_erase_from, interim.end());
 
+    // The record of a similar problem says which solvers are fast, but its times and workspace
+    // sizes were measured for the other problem. The workspace is computed for this one, and the
+    // times are reported as estimates, keeping their order.
+    if(fdb_record.IsApproximate())
+    {
+        for(auto& entry : interim)
+        {
+            const auto solver_id = solver::Id{entry.solution_id};
+            entry.workspace_size = solver_id.GetSolver().GetWorkspaceSize(ctx, problem);
+            entry.time = -std::max(std::abs(entry.time), std::numeric_limits<float>::min());
+        }
+    }
+
     return interim;
 }
 
@@ -980,7 +1022,8 @@ void ConvolutionDescriptor::ConvolutionBackwardData(Handle& handle,
         const auto problem =
             conv::ProblemDescription{dyDesc, wDesc, dxDesc, *this, conv::Direction::BackwardData};
         const auto network_config = problem.MakeNetworkConfig();
-        const auto& invoker       = handle.GetInvoker(network_config, {}, algorithm_name);
+        const auto& invoker =
+            GetFound1_0Invoker(handle, problem, network_config, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution backward. Was find executed?");
@@ -1156,7 +1199,7 @@ static void ConvWrwCheckNumerics(const Handle& handle,
 }
 
 // BackwardWeightsAlgorithm()
-void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
+void ConvolutionDescriptor::ConvolutionBackwardWeights(Handle& handle,
                                                        const void* alpha,
                                                        const TensorDescriptor& dyDesc,
                                                        ConstData_t dy,
@@ -1186,7 +1229,8 @@ void ConvolutionDescriptor::ConvolutionBackwardWeights(const Handle& handle,
             static_cast<miopenConvAlgorithm_t>(algo), direction)};
         decltype(auto) problem = conv::ProblemDescription{dyDesc, dwDesc, xDesc, *this, direction};
         decltype(auto) network_config = problem.MakeNetworkConfig();
-        decltype(auto) invoker = handle.GetInvoker(network_config, boost::none, algorithm_name);
+        decltype(auto) invoker =
+            GetFound1_0Invoker(handle, problem, network_config, algorithm_name);
 
         if(!invoker)
             MIOPEN_THROW("No invoker was registered for convolution weights. Was find executed?");
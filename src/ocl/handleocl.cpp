@@ -27,6 +27,8 @@
 #include <miopen/handle.hpp>
 
 #include <miopen/binary_cache.hpp>
+#include <miopen/compile_lease.hpp>
+#include <miopen/compile_scheduler.hpp>
 #include <miopen/config.h>
 #include <miopen/env.hpp>
 #include <miopen/errors.hpp>
@@ -42,6 +44,7 @@
 #include <miopen/filesystem.hpp>
 #include <boost/filesystem/operations.hpp>
 
+#include <optional>
 #include <string>
 
 #ifndef _WIN32
@@ -360,8 +363,8 @@ void Handle::ClearKernels(const std::string& algorithm, const std::string& netwo
     this->impl->cache.ClearKernels(algorithm, network_config);
 }
 
-const std::vector<Kernel>& Handle::GetKernelsImpl(const std::string& algorithm,
-                                                  const std::string& network_config) const
+std::shared_ptr<const std::vector<Kernel>>
+Handle::GetKernelsImpl(const std::string& algorithm, const std::string& network_config) const
 {
     return this->impl->cache.GetKernels(algorithm, network_config);
 }
@@ -388,6 +391,18 @@ Program Handle::LoadProgram(const std::string& program_name,
 {
     auto hsaco = miopen::LoadBinary(
         this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+
+    // Let one of the processes sharing the cache build the program while the others wait for it
+    std::optional<CompileLease> lease;
+    if(hsaco.empty())
+    {
+        lease.emplace(this->GetTargetProperties(), program_name, params);
+        hsaco = lease->Wait([&]() {
+            return miopen::LoadBinary(
+                this->GetTargetProperties(), this->GetMaxComputeUnits(), program_name, params);
+        });
+    }
+
     if(hsaco.empty())
     {
         CompileTimer ct;
@@ -398,6 +413,7 @@ Program Handle::LoadProgram(const std::string& program_name,
                                      params,
                                      kernel_src);
         ct.Log("Kernel", program_name);
+        RecordCompileTime(program_name, ct.ElapsedMs());
 
 // Save to cache
 #if MIOPEN_ENABLE_SQLITE_KERN_CACHE
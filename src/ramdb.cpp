@@ -26,6 +26,9 @@
 
 #include <miopen/ramdb.hpp>
 
+#include <miopen/db_binary_format.hpp>
+#include <miopen/db_write_queue.hpp>
+#include <miopen/env.hpp>
 #include <miopen/errors.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/logger.hpp>
@@ -35,10 +38,15 @@
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <iterator>
 #include <limits>
 #include <map>
 #include <mutex>
+#include <shared_mutex>
 #include <sstream>
+#include <system_error>
+
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_DB_CACHE_LIMIT)
 
 namespace miopen {
 
@@ -82,13 +90,43 @@ static void UpdateDbModificationTime(const std::string& path)
             MIOPEN_THROW("Db lock has failed to lock."); \
     } while(false)
 
+static bool IsBinaryDb(std::istream& file)
+{
+    char magic[sizeof(binary_db::magic)] = {};
+    file.read(magic, sizeof(magic));
+    const auto is_binary =
+        binary_db::View::IsBinary({magic, static_cast<std::size_t>(file.gcount())});
+    file.clear();
+    file.seekg(0);
+    return is_binary;
+}
+
 static std::chrono::seconds GetLockTimeout() { return std::chrono::seconds{60}; }
 
+static ramdb_clock::rep GetNextValidationTime()
+{
+    const auto interval =
+        std::chrono::milliseconds(Value(ENV(MIOPEN_DEBUG_RAMDB_REVALIDATION_MS)));
+    return (ramdb_clock::now() + interval).time_since_epoch().count();
+}
+
+static std::size_t GetShardLimit(bool is_system, std::size_t shard_count)
+{
+    if(is_system || DisableUserDbFileIO)
+        return 0;
+    // Rounded up, so each shard holds at least one record.
+    const auto limit = Value(ENV(MIOPEN_DB_CACHE_LIMIT));
+    return (limit + shard_count - 1) / shard_count;
+}
+
 using exclusive_lock = std::unique_lock<LockFile>;
+using shared_lock    = std::shared_lock<LockFile>;
 
 RamDb::RamDb(DbKinds db_kind_, std::string path, bool is_system)
-    : PlainTextDb(db_kind_, path, is_system)
+    : PlainTextDb(db_kind_, path, is_system), shard_limit(GetShardLimit(is_system, shard_count))
 {
+    for(auto& shard : shards)
+        shard = std::make_shared<const Cache>();
 }
 
 RamDb& RamDb::GetCached(DbKinds db_kind_, const std::string& path, bool is_system)
@@ -119,12 +157,195 @@ RamDb& RamDb::GetCached(DbKinds db_kind_, const std::string& path, bool is_syste
         const auto prefetch_lock = exclusive_lock(instance->GetLockFile(), GetLockTimeout());
         MIOPEN_VALIDATE_LOCK(prefetch_lock);
         instance->Prefetch();
+        instance->next_validation = GetNextValidationTime();
     }
     return *instance;
 }
 
-boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
+std::size_t RamDb::GetShardIndex(const std::string& key)
+{
+    return std::hash<std::string>{}(key) % shard_count;
+}
+
+std::shared_ptr<const RamDb::Cache> RamDb::LoadShard(std::size_t idx) const
+{
+    return std::atomic_load(&shards[idx]);
+}
+
+bool RamDb::IsCacheEmpty() const
+{
+    for(auto i = std::size_t{0}; i < shard_count; ++i)
+    {
+        if(!LoadShard(i)->empty())
+            return false;
+    }
+    return true;
+}
+
+std::string RamDb::GetCacheContent(const DbRecord& record)
+{
+    auto ss = std::ostringstream{};
+    record.WriteIdsAndValues(ss);
+    auto content = ss.str();
+    // WriteIdsAndValues() ends the line, which the cached contents do not have.
+    if(!content.empty() && content.back() == '\n')
+        content.pop_back();
+    return content;
+}
+
+std::ptrdiff_t RamDb::GetCacheSize(const Cache& cache)
+{
+    auto size = std::size_t{0};
+    for(const auto& item : cache)
+        size += sizeof(item) + item.first.size() + item.second.content.size();
+    return static_cast<std::ptrdiff_t>(size);
+}
+
+void RamDb::StoreShardUnsafe(std::size_t idx, std::shared_ptr<const Cache> shard)
+{
+    const auto size = GetCacheSize(*shard);
+    DbStats::Get(db_kind).AddResidentBytes(size - shard_sizes[idx]);
+    shard_sizes[idx] = size;
+    std::atomic_store(&shards[idx], std::move(shard));
+    generation.fetch_add(1, std::memory_order_release);
+}
+
+void RamDb::EvictUnsafe(Cache& shard, const std::string* kept)
+{
+    // The binary db files can't be searched for the evicted records.
+    if(shard_limit == 0 || shard.size() <= shard_limit || binary_file)
+        return;
+
+    const auto old_size = shard.size();
+
+    // The first pass clears the marks of the records looked up since the previous eviction,
+    // so the second one may evict them too if there is nothing else to evict.
+    for(auto pass = 0; pass < 2 && shard.size() > shard_limit; ++pass)
+    {
+        for(auto it = shard.begin(); it != shard.end() && shard.size() > shard_limit;)
+        {
+            const auto is_kept = kept != nullptr && it->first == *kept;
+            if(is_kept || it->second.referenced.value.exchange(false, std::memory_order_relaxed))
+                ++it;
+            else
+                it = shard.erase(it);
+        }
+    }
+
+    MIOPEN_LOG_I2("Evicted " << old_size - shard.size() << " records from cache for file "
+                             << GetFileName());
+    evicted = true;
+    DbStats::Get(db_kind).AddEvictions(old_size - shard.size());
+}
+
+void RamDb::ApplyChange(Cache& cache, const DbChange& change)
+{
+    auto record     = change.record;
+    const auto& key = record.GetKey();
+
+    if(change.merge)
+    {
+        const auto it = cache.find(key);
+        auto old      = DbRecord{key};
+        if(it != cache.end() && old.ParseContents(it->second.content))
+            record.Merge(old);
+    }
+
+    if(record.GetSize() == 0)
+        cache.erase(key);
+    else
+        cache.insert_or_assign(key, CacheItem{-1, GetCacheContent(record)});
+}
+
+void RamDb::Publish(Cache&& cache)
+{
+    const std::lock_guard<std::mutex> lock{cache_mutex};
+
+    // The updates waiting for the write-behind queue are not in the file yet.
+    if(DbWriteQueue::IsEnabled())
+    {
+        DbWriteQueue::Get().ForEachPending(*this,
+                                           [&](auto&& change) { ApplyChange(cache, change); });
+    }
+
+    auto fresh = std::array<Cache, shard_count>{};
+    while(!cache.empty())
+    {
+        auto node = cache.extract(cache.begin());
+        fresh[GetShardIndex(node.key())].insert(std::move(node));
+    }
+
+    for(auto i = std::size_t{0}; i < shard_count; ++i)
+    {
+        EvictUnsafe(fresh[i], nullptr);
+        StoreShardUnsafe(i, std::make_shared<const Cache>(std::move(fresh[i])));
+    }
+}
+
+void RamDb::SetCacheItemUnsafe(const DbRecord& record)
+{
+    const auto& key = record.GetKey();
+
+    if(record.GetSize() == 0)
+    {
+        EraseCacheItemUnsafe(key);
+        return;
+    }
+
+    const auto idx = GetShardIndex(key);
+    auto copy      = std::make_shared<Cache>(*LoadShard(idx));
+    copy->insert_or_assign(key, CacheItem{-1, GetCacheContent(record)});
+    EvictUnsafe(*copy, &key);
+    StoreShardUnsafe(idx, std::move(copy));
+}
+
+void RamDb::EraseCacheItemUnsafe(const std::string& key)
+{
+    const auto idx   = GetShardIndex(key);
+    const auto shard = LoadShard(idx);
+    if(shard->find(key) == shard->end())
+        return;
+
+    auto copy = std::make_shared<Cache>(*shard);
+    copy->erase(key);
+    StoreShardUnsafe(idx, std::move(copy));
+}
+
+/// Applies the change to the cache if the cache is up to date, otherwise reloads the file.
+/// Either way the change is visible to the readers of the process when the write returns.
+template <class TFunc>
+void RamDb::RefreshCacheUnsafe(bool is_valid, TFunc&& apply)
 {
+#if MIOPEN_DB_CACHE_WRITE_THROUGH
+    if(is_valid)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{cache_mutex};
+            apply();
+        }
+        file_read_time = ramdb_clock::now();
+        return;
+    }
+#else
+    std::ignore = is_valid;
+    std::ignore = apply;
+#endif
+    Prefetch();
+}
+
+void RamDb::RevalidateIfDue()
+{
+    if(DisableUserDbFileIO)
+        return;
+
+    if(ramdb_clock::now().time_since_epoch().count() < next_validation.load())
+        return;
+
+    // Only one thread checks the file, others keep using the current snapshot meanwhile.
+    const std::unique_lock<std::mutex> guard{validation_mutex, std::try_to_lock};
+    if(!guard)
+        return;
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
@@ -134,7 +355,77 @@ boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
         Prefetch();
     }
 
-    return FindRecordUnsafe(problem);
+    next_validation = GetNextValidationTime();
+}
+
+boost::optional<DbRecord> RamDb::FindRecord(const std::string& problem)
+{
+    RevalidateIfDue();
+
+    auto record = FindCachedRecord(problem);
+    DbStats::Get(db_kind).AddBytesRead(record);
+    return record;
+}
+
+boost::optional<DbRecord> RamDb::FindCachedRecord(const std::string& key)
+{
+    auto record = FindRecordUnsafe(key);
+    if(!record && evicted)
+        record = LoadEvictedRecord(key);
+    return record;
+}
+
+boost::optional<DbRecord> RamDb::LoadEvictedRecord(const std::string& key)
+{
+    const auto lock = shared_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    const auto record = FindEvictedRecordUnsafe(key);
+    if(!record)
+        return boost::none;
+
+    const std::lock_guard<std::mutex> guard{cache_mutex};
+
+    // Another thread may have cached it or its newer version meanwhile.
+    if(const auto cached = FindRecordUnsafe(key))
+        return cached;
+
+    SetCacheItemUnsafe(*record);
+    return record;
+}
+
+boost::optional<DbRecord> RamDb::FindEvictedRecordUnsafe(const std::string& key)
+{
+    auto record = PlainTextDb::FindRecordUnsafe(key, nullptr);
+
+    // The updates waiting for the write-behind queue are not in the file yet.
+    if(DbWriteQueue::IsEnabled())
+    {
+        DbWriteQueue::Get().ForEachPending(*this, [&](auto&& change) {
+            if(change.record.GetKey() != key)
+                return;
+            auto updated = change.record;
+            if(change.merge && record)
+                updated.Merge(*record);
+            if(updated.GetSize() == 0)
+                record = boost::none;
+            else
+                record = std::move(updated);
+        });
+    }
+
+    return record;
+}
+
+void RamDb::ForEachKey(const std::function<void(std::string_view)>& f)
+{
+    RevalidateIfDue();
+
+    for(auto i = std::size_t{0}; i < shard_count; ++i)
+    {
+        for(const auto& item : *LoadShard(i))
+            f(item.first);
+    }
 }
 
 bool RamDb::StoreRecord(const DbRecord& record)
@@ -142,21 +433,27 @@ bool RamDb::StoreRecord(const DbRecord& record)
     const auto& key = record.GetKey();
     MIOPEN_LOG_I2("Trying to store record at key " << key << " in cache for file "
                                                    << GetFileName());
+
+    if(DbWriteQueue::IsEnabled())
+    {
+        auto changes = std::vector<DbChange>{{record, false}};
+        if(QueueChanges(changes))
+            return true;
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
+    const auto is_valid = ValidateUnsafe();
+
     if(!DisableUserDbFileIO)
     {
-        if(!StoreRecordUnsafe(record))
+        if(!ConvertToTextUnsafe() || !StoreRecordUnsafe(record))
             return false;
         UpdateDbModificationTime(GetFileName());
     }
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-    UpdateCacheEntryUnsafe(record);
-#else
-    Prefetch();
-#endif
+    RefreshCacheUnsafe(is_valid, [&]() { SetCacheItemUnsafe(record); });
     return true;
 }
 
@@ -165,52 +462,98 @@ bool RamDb::UpdateRecord(DbRecord& record)
     const auto& key = record.GetKey();
     MIOPEN_LOG_I2("Trying to update record at key " << key << " in cache for file "
                                                     << GetFileName());
+
+    if(DbWriteQueue::IsEnabled())
+    {
+        auto changes = std::vector<DbChange>{{record, true}};
+        if(QueueChanges(changes))
+        {
+            record = std::move(changes.front().record);
+            return true;
+        }
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
+    const auto is_valid = ValidateUnsafe();
+
     if(!DisableUserDbFileIO)
     {
-        if(!UpdateRecordUnsafe(record))
+        if(!ConvertToTextUnsafe() || !UpdateRecordUnsafe(record))
             return false;
         UpdateDbModificationTime(GetFileName());
     }
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-    UpdateCacheEntryUnsafe(record);
-#else
-    Prefetch();
-#endif
+    // UpdateRecordUnsafe() has merged the record with the one in the file.
+    RefreshCacheUnsafe(is_valid, [&]() { SetCacheItemUnsafe(record); });
     return true;
 }
 
-bool RamDb::RemoveRecord(const std::string& key)
+bool RamDb::CommitBatch(const std::vector<DbChange>& changes)
 {
-    MIOPEN_LOG_I2("Trying to remove record at key " << key << " from cache for file "
-                                                    << GetFileName());
+    MIOPEN_LOG_I2("Trying to commit a batch of " << changes.size() << " records to file "
+                                                 << GetFileName());
+
+    if(DbWriteQueue::IsEnabled())
+    {
+        auto queued = changes;
+        if(QueueChanges(queued))
+            return true;
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
     const auto is_valid = ValidateUnsafe();
-#endif
+
+    auto results = std::vector<DbRecord>{};
 
     if(!DisableUserDbFileIO)
     {
-        if(!RemoveRecordUnsafe(key))
+        if(!ConvertToTextUnsafe() || !CommitBatchUnsafe(changes, results))
             return false;
         UpdateDbModificationTime(GetFileName());
     }
+    else
+    {
+        for(const auto& change : changes)
+            results.push_back(change.record);
+    }
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-    if(is_valid)
+    RefreshCacheUnsafe(is_valid, [&]() {
+        for(const auto& record : results)
+            SetCacheItemUnsafe(record);
+    });
+    return true;
+}
+
+bool RamDb::RemoveRecord(const std::string& key)
+{
+    MIOPEN_LOG_I2("Trying to remove record at key " << key << " from cache for file "
+                                                    << GetFileName());
+
+    if(DbWriteQueue::IsEnabled())
     {
-        cache.erase(key);
-        file_read_time = ramdb_clock::now();
+        // An empty record removes the stored one.
+        auto changes = std::vector<DbChange>{{DbRecord{key}, false}};
+        if(QueueChanges(changes))
+            return true;
+    }
+
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    const auto is_valid = ValidateUnsafe();
+
+    if(!DisableUserDbFileIO)
+    {
+        if(!ConvertToTextUnsafe() || !RemoveRecordUnsafe(key))
+            return false;
+        UpdateDbModificationTime(GetFileName());
     }
-#else
-    Prefetch();
-#endif
 
+    RefreshCacheUnsafe(is_valid, [&]() { EraseCacheItemUnsafe(key); });
     return true;
 }
 
@@ -218,57 +561,145 @@ bool RamDb::Remove(const std::string& key, const std::string& id)
 {
     MIOPEN_LOG_I2("Trying to remove value at key " << key << " and id " << id
                                                    << " from cache for file " << GetFileName());
+
+    if(DbWriteQueue::IsEnabled())
+    {
+        auto& queue = DbWriteQueue::Get();
+        queue.WaitForSpace();
+
+        // The evicted record is read before the cache is locked, as the file lock has to be
+        // taken first.
+        auto stored = evicted ? FindCachedRecord(key) : boost::optional<DbRecord>{};
+
+        // Same as the merge in QueueChanges(), the record is read and queued under the lock,
+        // so a concurrent update of it is not lost.
+        const std::lock_guard<std::mutex> lock{cache_mutex};
+
+        auto record = FindRecordUnsafe(key);
+        if(!record)
+            record = std::move(stored);
+        if(!record || !record->EraseValues(id))
+            return false;
+
+        // The queue is stopped at the exit, then the change is written below.
+        if(queue.Push(*this, {{*record, false}}))
+        {
+            SetCacheItemUnsafe(*record);
+            return true;
+        }
+    }
+
     const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
     MIOPEN_VALIDATE_LOCK(lock);
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
     const auto is_valid = ValidateUnsafe();
-#endif
 
     auto record = FindRecordUnsafe(key);
+    if(!record && evicted)
+        record = FindEvictedRecordUnsafe(key);
 
     if(!record || !record->EraseValues(id))
         return false;
 
     if(!DisableUserDbFileIO)
     {
-        if(!StoreRecordUnsafe(*record))
+        if(!ConvertToTextUnsafe() || !StoreRecordUnsafe(*record))
             return false;
         UpdateDbModificationTime(GetFileName());
     }
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-    if(is_valid)
+    RefreshCacheUnsafe(is_valid, [&]() { SetCacheItemUnsafe(*record); });
+    return true;
+}
+
+bool RamDb::QueueChanges(std::vector<DbChange>& changes)
+{
+    auto& queue = DbWriteQueue::Get();
+    queue.WaitForSpace();
+
+    // The evicted records are read before the cache is locked, as the file lock has to be taken
+    // first.
+    auto stored = std::vector<boost::optional<DbRecord>>(changes.size());
+    if(evicted)
     {
-        if(record->GetSize() == 0)
+        for(auto i = std::size_t{0}; i < changes.size(); ++i)
         {
-            cache.erase(key);
+            if(changes[i].merge)
+                stored[i] = FindCachedRecord(changes[i].record.GetKey());
         }
-        else
+    }
+
+    const std::lock_guard<std::mutex> lock{cache_mutex};
+
+    // The changes are applied to the cache only once they are all queued, so a change is merged
+    // with the previous change of the same record in the batch, if there is one.
+    auto previous = std::map<std::string, std::size_t>{};
+
+    for(auto i = std::size_t{0}; i < changes.size(); ++i)
+    {
+        auto& change   = changes[i];
+        const auto key = change.record.GetKey();
+
+        if(change.merge)
         {
-            auto it = cache.find(key);
-            auto ss = std::ostringstream{};
-            record->WriteIdsAndValues(ss);
-            it->second.content = ss.str();
+            const auto it = previous.find(key);
+            auto cached   = it != previous.end() ? boost::make_optional(changes[it->second].record)
+                                                 : FindRecordUnsafe(key);
+            if(!cached)
+                cached = std::move(stored[i]);
+            if(cached)
+                change.record.Merge(*cached);
         }
 
-        file_read_time = ramdb_clock::now();
+        previous[key] = i;
     }
-#else
-    Prefetch();
-#endif
+
+    // The queue is stopped at the exit, the caller writes the changes itself.
+    if(!queue.Push(*this, changes))
+        return false;
+
+    for(const auto& change : changes)
+        SetCacheItemUnsafe(change.record);
+
+    return true;
+}
+
+bool RamDb::PersistChanges(const std::vector<DbChange>& changes)
+{
+    MIOPEN_LOG_I2("Writing " << changes.size() << " queued records to file " << GetFileName());
+    const auto lock = exclusive_lock(GetLockFile(), GetLockTimeout());
+    MIOPEN_VALIDATE_LOCK(lock);
+
+    const auto is_valid = ValidateUnsafe();
+
+    auto results = std::vector<DbRecord>{};
+    if(!ConvertToTextUnsafe() || !CommitBatchUnsafe(changes, results))
+        return false;
+    UpdateDbModificationTime(GetFileName());
+
+    // The cache already has the changes, unless another process has modified the file.
+    if(is_valid)
+        file_read_time = ramdb_clock::now();
+    else
+        Prefetch();
 
     return true;
 }
 
-boost::optional<miopen::DbRecord> RamDb::FindRecordUnsafe(const std::string& problem)
+boost::optional<miopen::DbRecord> RamDb::FindRecordUnsafe(const std::string& problem) const
 {
     MIOPEN_LOG_I2("Looking for key " << problem << " in cache for file " << GetFileName());
-    const auto it = cache.find(problem);
+    const auto shard = LoadShard(GetShardIndex(problem));
+    const auto it    = shard->find(problem);
 
-    if(it == cache.end())
+    if(it == shard->end())
         return boost::none;
 
+    // Avoids writing to the cache line of a hot record over and over.
+    auto& referenced = it->second.referenced.value;
+    if(!referenced.load(std::memory_order_relaxed))
+        referenced.store(true, std::memory_order_relaxed);
+
     auto record = DbRecord{problem};
 
     if(!record.ParseContents(it->second.content))
@@ -299,7 +730,7 @@ bool RamDb::ValidateUnsafe()
     if(DisableUserDbFileIO)
         return true;
     if(!fs::exists(GetFileName()))
-        return cache.empty();
+        return IsCacheEmpty();
     const auto file_mod_time     = GetDbModificationTime(GetFileName());
     const auto validation_result = file_mod_time < file_read_time;
     MIOPEN_LOG_I2("DB file is " << (validation_result ? "older" : "newer")
@@ -324,7 +755,18 @@ void RamDb::Prefetch()
             return;
         }
 
-        cache.clear();
+        auto cache = Cache{};
+
+        binary_file = IsBinaryDb(file);
+        if(binary_file)
+        {
+            PrefetchBinary(file, cache);
+            PrefetchJournal(cache);
+            Publish(std::move(cache));
+            file_read_time = ramdb_clock::now();
+            return;
+        }
+
         auto line   = std::string{};
         auto n_line = 0;
 
@@ -351,37 +793,131 @@ void RamDb::Prefetch()
             cache.emplace(key, CacheItem{n_line, contents});
         }
 
+        PrefetchJournal(cache);
+        Publish(std::move(cache));
         file_read_time = ramdb_clock::now();
     });
 }
 
-#if MIOPEN_DB_CACHE_WRITE_THROUGH
-void RamDb::UpdateCacheEntryUnsafe(const DbRecord& record)
+void RamDb::PrefetchJournal(Cache& cache)
 {
-    const auto is_valid = ValidateUnsafe();
+    const auto journal_path = GetJournalPath(GetFileName());
+    auto file               = std::ifstream{journal_path};
 
-    if(!DisableUserDbFileIO)
-        UpdateDbModificationTime(GetFileName());
+    if(!file)
+        return;
 
-    if(is_valid)
+    auto line   = std::string{};
+    auto n_line = 0;
+
+    while(std::getline(file, line))
     {
-        const auto& key = record.GetKey();
-        const auto it   = cache.find(key);
-        auto ss         = std::ostringstream{};
-        record.WriteIdsAndValues(ss);
+        ++n_line;
+
+        if(line.empty())
+            continue;
 
-        if(it != cache.end())
+        const auto key_size = line.find('=');
+        const bool is_key   = (key_size != std::string::npos && key_size != 0);
+
+        if(!is_key)
         {
-            auto& item   = it->second;
-            item.content = ss.str();
+            MIOPEN_LOG_E("Ill-formed record: key not found: " << journal_path << "#" << n_line);
+            continue;
         }
+
+        const auto key      = line.substr(0, key_size);
+        const auto contents = line.substr(key_size + 1);
+
+        // Later records override the earlier ones, and the empty ones mark removals.
+        if(contents.empty())
+            cache.erase(key);
         else
+            cache.insert_or_assign(key, CacheItem{n_line, contents});
+    }
+}
+
+void RamDb::PrefetchBinary(std::istream& file, Cache& cache)
+{
+    const auto data = std::string{std::istreambuf_iterator<char>{file}, {}};
+    auto error      = std::string{};
+    const auto view = binary_db::View::Open(data, error);
+
+    if(!view)
+    {
+        MIOPEN_LOG_E("Unable to load binary db " << GetFileName() << ": " << error);
+        return;
+    }
+
+    for(std::size_t i = 0; i < view->GetRecordCount(); ++i)
+    {
+        const auto record = view->GetRecord(i);
+        auto ss           = std::ostringstream{};
+        view->WriteIdsAndValues(record, ss);
+        cache.emplace(view->GetString(record.key), CacheItem{static_cast<int>(i + 1), ss.str()});
+    }
+}
+
+/// PlainTextDb appends records to the file, so a binary db is rewritten in the text format
+/// before the first modification. The text is written to a temp file which then replaces the
+/// db, so the db is never left truncated. Returns false if the db is still binary.
+bool RamDb::ConvertToTextUnsafe()
+{
+    if(!binary_file)
+        return true;
+
+    auto file = std::ifstream{GetFileName(), std::ios::binary};
+    // Another process may have converted it already.
+    if(!file || !IsBinaryDb(file))
+    {
+        binary_file = false;
+        return true;
+    }
+
+    const auto data = std::string{std::istreambuf_iterator<char>{file}, {}};
+    auto error      = std::string{};
+    const auto view = binary_db::View::Open(data, error);
+    file.close();
+
+    if(!view)
+    {
+        MIOPEN_LOG_E("Unable to convert binary db " << GetFileName() << ": " << error);
+        return false;
+    }
+
+    const auto temp_name = GetFileName() + ".temp";
+    {
+        auto out = std::ofstream{temp_name, std::ios::binary | std::ios::trunc};
+        for(std::size_t i = 0; out && i < view->GetRecordCount(); ++i)
         {
-            cache.emplace(key, CacheItem{-1, ss.str()});
+            view->WriteText(view->GetRecord(i), out);
+            out << '\n';
+        }
+        out.close();
+
+        if(!out)
+        {
+            MIOPEN_LOG_E("Unable to write the text db " << temp_name);
+            auto ec = std::error_code{};
+            fs::remove(temp_name, ec);
+            return false;
         }
-        file_read_time = ramdb_clock::now();
     }
+
+    auto ec = std::error_code{};
+    fs::rename(temp_name, GetFileName(), ec);
+    if(ec)
+    {
+        MIOPEN_LOG_E("Unable to replace " << GetFileName()
+                                          << " with the text db: " << ec.message());
+        fs::remove(temp_name, ec);
+        return false;
+    }
+
+    fs::permissions(GetFileName(), fs::perms::all, ec);
+    binary_file = false;
+    MIOPEN_LOG_I("Binary db converted to text before modification: " << GetFileName());
+    return true;
 }
-#endif
 
 } // namespace miopen
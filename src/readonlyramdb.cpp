@@ -33,10 +33,9 @@
 #include <miopen_data.hpp>
 #endif
 
-#include <fstream>
-#include <mutex>
-#include <sstream>
+#include <chrono>
 #include <map>
+#include <mutex>
 
 namespace miopen {
 
@@ -52,32 +51,69 @@ bool& rordb_embed_fs_override()
 ReadonlyRamDb&
 ReadonlyRamDb::GetCached(DbKinds db_kind_, const std::string& path, bool warn_if_unreadable)
 {
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static std::mutex mutex;
-    const std::lock_guard<std::mutex> lock{mutex};
+    ReadonlyRamDb* instance = nullptr;
 
-    // We don't have to store kind to properly index as different dbs would have different paths
-    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
-    static auto instances = std::map<std::string, ReadonlyRamDb*>{};
-    const auto it         = instances.find(path);
-
-    if(it != instances.end())
-        return *it->second;
-
-    // The ReadonlyRamDb objects allocated here by "new" shall be alive during
-    // the calling app lifetime. Size of each is very small, and there couldn't
-    // be many of them (max number is number of _different_ GPU board installed
-    // in the user's system, which is _one_ for now). Therefore the total
-    // footprint in heap is very small. That is why we can omit deletion of
-    // these objects thus avoiding bothering with MP/MT syncronization.
-    // These will be destroyed altogether with heap.
-    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
-    auto instance = new ReadonlyRamDb{db_kind_, path};
-    instances.emplace(path, instance);
-    instance->Prefetch(warn_if_unreadable);
+    {
+        // The registry is never destroyed because the background prefetch thread may still
+        // be using it while the statics are destroyed at exit.
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        static auto& mutex = *new std::mutex{};
+        const std::lock_guard<std::mutex> lock{mutex};
+
+        // We don't have to store kind to properly index as different dbs would have different
+        // paths
+        // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+        static auto& instances = *new std::map<std::string, ReadonlyRamDb*>{};
+        const auto it          = instances.find(path);
+
+        if(it != instances.end())
+        {
+            instance = it->second;
+        }
+        else
+        {
+            // The ReadonlyRamDb objects allocated here by "new" shall be alive during
+            // the calling app lifetime. Size of each is very small, and there couldn't
+            // be many of them (max number is number of _different_ GPU board installed
+            // in the user's system, which is _one_ for now). Therefore the total
+            // footprint in heap is very small. That is why we can omit deletion of
+            // these objects thus avoiding bothering with MP/MT syncronization.
+            // These will be destroyed altogether with heap.
+            // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+            instance = new ReadonlyRamDb{db_kind_, path};
+            instances.emplace(path, instance);
+        }
+    }
+
+    // Loading is done outside of the registry lock, so only the users of this very db
+    // wait for it.
+    instance->EnsurePrefetched(warn_if_unreadable);
     return *instance;
 }
 
+void ReadonlyRamDb::EnsurePrefetched(bool warn_if_unreadable)
+{
+    if(prefetched.load(std::memory_order_acquire))
+        return;
+
+    const auto start = std::chrono::steady_clock::now();
+    auto loaded_here = false;
+
+    std::call_once(prefetch_once, [&]() {
+        Prefetch(warn_if_unreadable);
+        prefetched.store(true, std::memory_order_release);
+        loaded_here = true;
+    });
+
+    if(!loaded_here)
+    {
+        const auto waited = std::chrono::steady_clock::now() - start;
+        MIOPEN_LOG_I("ReadonlyRamDb: waited "
+                     << std::chrono::duration<float, std::milli>(waited).count()
+                     << " ms for the prefetch of " << db_path);
+    }
+}
+
 template <class TFunc>
 static auto Measure(const std::string& funcName, TFunc&& func)
 {
@@ -91,47 +127,13 @@ static auto Measure(const std::string& funcName, TFunc&& func)
                                    << " ms");
 }
 
-void ReadonlyRamDb::ParseAndLoadDb(std::istream& input_stream, bool warn_if_unreadable)
-{
-    if(!input_stream)
-    {
-        const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB) ? LoggingLevel::Warning
-                                                                             : LoggingLevel::Info;
-        MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
-        return;
-    }
-
-    auto line   = std::string{};
-    auto n_line = 0;
-
-    while(std::getline(input_stream, line))
-    {
-        ++n_line;
-
-        if(line.empty())
-            continue;
-
-        const auto key_size = line.find('=');
-        const bool is_key   = (key_size != std::string::npos && key_size != 0);
-
-        if(!is_key)
-        {
-            MIOPEN_LOG_E("Ill-formed record: key not found: " << db_path << "#" << n_line);
-            continue;
-        }
-
-        const auto key      = line.substr(0, key_size);
-        const auto contents = line.substr(key_size + 1);
-
-        cache.emplace(key, CacheItem{n_line, contents});
-    }
-}
-
 void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
 {
     Measure("Prefetch", [this, warn_if_unreadable]() {
         if(db_path.empty())
             return;
+
+        auto text                 = boost::optional<std::string_view>{};
         constexpr bool isEmbedded = MIOPEN_EMBED_DB;
         // cppcheck-suppress knownConditionTrueFalse
         if(!debug::rordb_embed_fs_override() && isEmbedded)
@@ -147,15 +149,105 @@ void ReadonlyRamDb::Prefetch(bool warn_if_unreadable)
             const auto& p = it_p->second;
             ptrdiff_t sz  = p.second - p.first;
             MIOPEN_LOG_I2("Loading In Memory file: " << filepath);
-            auto input_stream = std::stringstream(std::string(p.first, sz));
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            // The embedded db is a part of the library image, so it is indexed in place.
+            text = std::string_view(p.first, sz);
 #endif
         }
         else
         {
-            auto input_stream = std::ifstream{db_path};
-            ParseAndLoadDb(input_stream, warn_if_unreadable);
+            if(LoadShared(text))
+                return;
+            if(!text)
+                text = MapOrReadFile(db_path, mapping, buffer);
+        }
+
+        if(!text)
+        {
+            const auto log_level = (warn_if_unreadable && !MIOPEN_DISABLE_SYSDB)
+                                       ? LoggingLevel::Warning
+                                       : LoggingLevel::Info;
+            MIOPEN_LOG(log_level, "File is unreadable: " << db_path);
+            return;
+        }
+
+        if(binary_db::View::IsBinary(*text))
+        {
+            auto error = std::string{};
+            binary     = binary_db::View::Open(*text, error);
+            if(binary)
+                MIOPEN_LOG_I2("Binary db " << db_path << ": " << binary->GetRecordCount()
+                                           << " records");
+            else
+                MIOPEN_LOG_E("Unable to load binary db " << db_path << ": " << error);
+            return;
         }
+
+        index = DbTextIndex{*text, db_path, DbTextIndex::Kind::SystemDb};
+
+        // The db is not bounded, its size is set by the installed file. Only the copy of the
+        // unmappable file and the index are reported, the mapping is shared with the page cache.
+        const auto resident = buffer.size() + index.GetEntries().size() * sizeof(CacheItem);
+        DbStats::Get(db_kind).AddResidentBytes(static_cast<std::ptrdiff_t>(resident));
+    });
+}
+
+bool ReadonlyRamDb::LoadShared(boost::optional<std::string_view>& text)
+{
+    if(!SharedDbImage::IsEnabled())
+        return false;
+
+    auto image = SharedDbImage::Open(db_path, [&]() {
+        text = MapOrReadFile(db_path, mapping, buffer);
+        return text;
     });
+
+    if(!image)
+        return false;
+
+    auto error = std::string{};
+    auto view  = binary_db::View::Open(image->View(), error);
+
+    if(!view)
+    {
+        MIOPEN_LOG_W("Ignoring shared db image " << image->GetName() << " of " << db_path << ": "
+                                                  << error);
+        return false;
+    }
+
+    MIOPEN_LOG_I2("Using shared db image " << image->GetName() << " of " << db_path << ": "
+                                           << view->GetRecordCount() << " records");
+    binary = view;
+    shared = std::move(image);
+    // The private copy of the text is not needed anymore.
+    mapping = MappedFile{};
+    buffer  = std::string{};
+    return true;
+}
+
+boost::optional<DbRecord> ReadonlyRamDb::FindBinaryRecord(const std::string& problem) const
+{
+    const auto item = binary->Find(problem);
+
+    if(!item)
+        return boost::none;
+
+    auto record = DbRecord{problem};
+    auto found  = false;
+
+    MIOPEN_LOG_I2("Key match: " << problem);
+    binary->ForEachItem(*item, [&](std::string_view id, std::string_view values) {
+        if(record.AddItem(std::string{id}, std::string{values}))
+            found = true;
+    });
+
+    if(!found)
+    {
+        MIOPEN_LOG_E("No valid items under the key: " << problem << " form file " << db_path);
+        return boost::none;
+    }
+
+    DbStats::Get(db_kind).AddBytesRead(record.GetTextSize());
+
+    return record;
 }
 } // namespace miopen
@@ -41,6 +41,7 @@
 #include <miopen/par_for.hpp>
 #include <miopen/stringutils.hpp>
 #include <miopen/any_solver.hpp>
+#include <miopen/compile_scheduler.hpp>
 #include <miopen/timer.hpp>
 
 #include <boost/range/adaptor/transformed.hpp>
@@ -79,7 +80,9 @@ std::vector<Program> PrecompileKernels(const Handle& h, const std::vector<Kernel
     return programs;
 }
 
-void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
+void PrecompileSolutions(const Handle& h,
+                         const std::vector<const ConvSolution*>& sols,
+                         CompileScheduler& scheduler)
 {
     // Find all kernels that need to be compiled from the solutions
     std::vector<KernelInfo> kernels;
@@ -95,15 +98,15 @@ void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>
         }
     }
 
-    // Precompile the kernels in parallel, but dont add them to the cache
-    std::vector<Program> programs = PrecompileKernels(h, kernels);
+    // The programs are added to the cache as they are built
+    scheduler.Start(kernels);
+}
 
-    // Add programs to the cache
-    for(std::size_t i = 0; i < programs.size(); i++)
-    {
-        const KernelInfo& k = kernels[i];
-        h.AddProgram(programs[i], k.kernel_file, k.comp_options);
-    }
+void PrecompileSolutions(const Handle& h, const std::vector<const ConvSolution*>& sols)
+{
+    CompileScheduler scheduler{h, GetTuningThreadsMax()};
+    PrecompileSolutions(h, sols, scheduler);
+    scheduler.WaitAll();
 }
 
 std::ostream& operator<<(std::ostream& os, const ConvSolution& s)
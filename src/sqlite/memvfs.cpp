@@ -169,6 +169,14 @@ static int memClose(sqlite3_file* pFile)
 static int memRead(sqlite3_file* pFile, void* zBuf, int iAmt, sqlite_int64 iOfst)
 {
     MemFile* p = (MemFile*)pFile;
+    if(iOfst + iAmt > p->sz)
+    {
+        /* The unread part must be zero-filled on a short read. */
+        memset(zBuf, 0, iAmt);
+        if(iOfst < p->sz)
+            memcpy(zBuf, p->aData + iOfst, p->sz - iOfst);
+        return SQLITE_IOERR_SHORT_READ;
+    }
     memcpy(zBuf, p->aData + iOfst, iAmt);
     return SQLITE_OK;
 }
@@ -288,11 +296,17 @@ static void memShmBarrier(sqlite3_file* pFile) { return; }
 /* Unmap a shared memory segment */
 static int memShmUnmap(sqlite3_file* pFile, int deleteFlag) { return SQLITE_OK; }
 
-/* Fetch a page of a memory-mapped file */
+/* Fetch a page of a memory-mapped file. The pages are served straight from
+** the buffer, so with PRAGMA mmap_size set the reads do not copy. A page
+** past the end of the buffer is read with xRead instead.
+*/
 static int memFetch(sqlite3_file* pFile, sqlite3_int64 iOfst, int iAmt, void** pp)
 {
     MemFile* p = (MemFile*)pFile;
-    *pp        = (void*)(p->aData + iOfst);
+    if(iOfst + iAmt > p->sz)
+        *pp = 0;
+    else
+        *pp = (void*)(p->aData + iOfst);
     return SQLITE_OK;
 }
 
@@ -538,7 +552,9 @@ __declspec(dllexport)
     SQLITE_EXTENSION_INIT2(pApi);
     mem_vfs.pAppData = sqlite3_vfs_find(0);
     mem_vfs.szOsFile = sizeof(MemFile);
-    rc               = sqlite3_vfs_register(&mem_vfs, 1);
+    /* Not the default VFS, as the file dbs are opened along with the memory ones.
+    ** The URIs select it with vfs=memvfs. */
+    rc = sqlite3_vfs_register(&mem_vfs, 0);
 #ifdef MEMVFS_TEST
     if(rc == SQLITE_OK)
     {
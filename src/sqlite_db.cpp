@@ -31,6 +31,7 @@
 #include <miopen/conv/problem_description.hpp>
 #include <miopen/exp_backoff.hpp>
 #include <miopen/filesystem.hpp>
+#include <miopen/mapped_file.hpp>
 
 #if MIOPEN_EMBED_DB
 #include <miopen_data.hpp>
@@ -49,12 +50,94 @@
 #include <mutex>
 #include <shared_mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 extern "C" {
 int miopen_sqlite3_memvfs_init(sqlite3* db, char** pzErrMsg, const sqlite3_api_routines* pApi);
 }
 namespace miopen {
 
+/// Registers the memvfs extension, which serves the db pages from a memory buffer.
+static void LoadMemVfs()
+{
+    static std::once_flag once;
+    std::call_once(once, []() {
+#if defined(__clang__) || defined(__llvm__)
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wcast-function-type-strict"
+#endif
+        sqlite3_auto_extension(reinterpret_cast<void (*)(void)>(miopen_sqlite3_memvfs_init));
+#if defined(__clang__) || defined(__llvm__)
+#pragma clang diagnostic pop
+#endif
+        // Open an in-memory database to use as a handle for loading the memvfs extension
+        sqlite3* ptr_tmp = nullptr;
+        if(sqlite3_open(":memory:", &ptr_tmp) != SQLITE_OK)
+        {
+            MIOPEN_THROW(miopenStatusInternalError,
+                         "open :memory: " + std::string(sqlite3_errmsg(ptr_tmp)));
+        }
+        sqlite3_enable_load_extension(ptr_tmp, 1);
+        sqlite3_close(ptr_tmp);
+    });
+}
+
+static std::string GetErrorMessage(sqlite3* db)
+{
+    std::string errMsg = "Internal error while accessing SQLite database: ";
+    return errMsg + sqlite3_errmsg(db);
+}
+
+using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
+
+static sqlite3_stmt_ptr PrepareStatement(sqlite3* db, const std::string& query)
+{
+    sqlite3_stmt* ptr = nullptr;
+    MIOPEN_LOG_I2(query);
+    auto rc = sqlite3_prepare_v2(db, query.c_str(), query.size(), &ptr, nullptr);
+    if(rc != SQLITE_OK)
+    {
+        std::string err_msg = "SQLite prepare error: ";
+        MIOPEN_THROW(miopenStatusInternalError, err_msg + GetErrorMessage(db));
+    }
+    return sqlite3_stmt_ptr{ptr};
+}
+
+/// Statements prepared on a connection, kept for reuse by their query text. A statement is
+/// taken out of the cache while it is used, so the threads sharing the connection never share
+/// a statement.
+class StatementCache
+{
+public:
+    sqlite3_stmt_ptr Take(sqlite3* db, const std::string& query)
+    {
+        {
+            const std::lock_guard<std::mutex> lock{mutex};
+            const auto it = statements.find(query);
+            if(it != statements.end())
+            {
+                auto stmt = std::move(it->second);
+                statements.erase(it);
+                return stmt;
+            }
+        }
+        return PrepareStatement(db, query);
+    }
+
+    void Return(const std::string& query, sqlite3_stmt_ptr stmt)
+    {
+        sqlite3_reset(stmt.get());
+        sqlite3_clear_bindings(stmt.get());
+        const std::lock_guard<std::mutex> lock{mutex};
+        statements.emplace(query, std::move(stmt));
+    }
+
+private:
+    std::mutex mutex;
+    std::unordered_multimap<std::string, sqlite3_stmt_ptr> statements;
+};
+
 class SQLite::impl
 {
     struct SQLiteCloser
@@ -71,27 +154,61 @@ class SQLite::impl
         }
     };
     using sqlite3_ptr = std::unique_ptr<sqlite3, SQLiteCloser>;
-#if MIOPEN_EMBED_DB
-    int CreateInMemDb(const fs::path& filepath, bool is_system)
+
+    // Declared before the connection, so it is unmapped after the connection is closed.
+    MappedFile mapping;
+
+    /// The system dbs and the readers are never written. The pages of the system dbs are read
+    /// through the memory mapping, by memvfs or by the default VFS, instead of being copied to
+    /// the page cache of the connection.
+    static void SetReadOnly(sqlite3* ptr, std::size_t size)
     {
-        sqlite3* ptr_tmp = nullptr;
-        int rc           = 0;
-#if defined(__clang__) || defined(__llvm__)
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wcast-function-type-strict"
-#endif
-        sqlite3_auto_extension(reinterpret_cast<void (*)(void)>(miopen_sqlite3_memvfs_init));
-#if defined(__clang__) || defined(__llvm__)
-#pragma clang diagnostic pop
-#endif
-        // Open an in-memory database to use as a handle for loading the memvfs extension
-        if(sqlite3_open(":memory:", &ptr_tmp) != SQLITE_OK)
+        const auto pragmas = "PRAGMA query_only=1; PRAGMA mmap_size=" + std::to_string(size) + ";";
+        if(sqlite3_exec(ptr, pragmas.c_str(), nullptr, nullptr, nullptr) != SQLITE_OK)
+            MIOPEN_LOG_W("Unable to set up the read-only access: " << sqlite3_errmsg(ptr));
+    }
+
+    /// Opens the system db from a read-only mapping of the file through memvfs.
+    int OpenMappedDb(const fs::path& filepath, sqlite3** ptr_tmp)
+    {
+        try
         {
-            MIOPEN_THROW(miopenStatusInternalError,
-                         "open :memory: " + std::string(sqlite3_errmsg(ptr_tmp)));
+            mapping = MappedFile{filepath};
         }
-        sqlite3_enable_load_extension(ptr_tmp, 1);
-        sqlite3_close(ptr_tmp);
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_I2("Unable to map " << filepath << ": " << ex.what());
+            return SQLITE_CANTOPEN;
+        }
+
+        LoadMemVfs();
+        const auto view = mapping.View();
+        char* memuri    = sqlite3_mprintf("file:%s?vfs=memvfs&immutable=1&ptr=0x%p&sz=%lld",
+                                          filepath.filename().string().c_str(),
+                                          static_cast<const void*>(view.data()),
+                                          static_cast<long long>(view.size()));
+        reader_path  = memuri;
+        reader_flags = SQLITE_OPEN_READONLY | SQLITE_OPEN_URI;
+        sqlite3_free(memuri);
+        const auto rc = sqlite3_open_v2(reader_path.c_str(), ptr_tmp, reader_flags, nullptr);
+
+        if(rc != SQLITE_OK)
+        {
+            MIOPEN_LOG_I2("Unable to open mapped " << filepath << ": " << sqlite3_errmsg(*ptr_tmp));
+            sqlite3_close(*ptr_tmp);
+            *ptr_tmp = nullptr;
+            mapping  = MappedFile{};
+        }
+        return rc;
+    }
+
+#if MIOPEN_EMBED_DB
+    int CreateInMemDb(const fs::path& filepath, bool is_system)
+    {
+        sqlite3* ptr_tmp  = nullptr;
+        int rc            = 0;
+        std::size_t db_sz = 0;
+        LoadMemVfs();
         if(is_system)
         {
 
@@ -103,8 +220,10 @@ class SQLite::impl
             }
             const auto& p    = it_p->second;
             ptrdiff_t ptr_sz = p.second - p.first;
-            char* memuri     = sqlite3_mprintf(
-                "file:ignoredFilename?ptr=0x%p&sz=%lld", p.first, static_cast<long long>(ptr_sz));
+            db_sz            = ptr_sz;
+            char* memuri     = sqlite3_mprintf("file:ignoredFilename?vfs=memvfs&ptr=0x%p&sz=%lld",
+                                               p.first,
+                                               static_cast<long long>(ptr_sz));
             if(sqlite3_open_v2(
                    memuri, &ptr_tmp, SQLITE_OPEN_READWRITE | SQLITE_OPEN_URI, nullptr) != SQLITE_OK)
             {
@@ -141,6 +260,8 @@ class SQLite::impl
             sqlite3_finalize(stmt);
         }
         ptrDb = sqlite3_ptr{ptr_tmp};
+        if(rc == 0 && is_system)
+            SetReadOnly(ptr_tmp, db_sz);
         return rc;
     }
 #endif
@@ -156,11 +277,17 @@ class SQLite::impl
                 rc = -1;
                 return rc;
             }
-            else
+            if(miopen::IsEnabled(ENV(MIOPEN_DEBUG_DISABLE_SQL_MMAP)) ||
+               OpenMappedDb(filepath, &ptr_tmp) != SQLITE_OK)
             {
-                rc = sqlite3_open_v2(
-                    filepath.string().c_str(), &ptr_tmp, SQLITE_OPEN_READONLY, nullptr);
+                reader_path  = filepath.string();
+                reader_flags = SQLITE_OPEN_READONLY;
+                rc           = sqlite3_open_v2(
+                    reader_path.c_str(), &ptr_tmp, reader_flags, nullptr);
             }
+            reader_mmap_size = fs::file_size(filepath);
+            if(rc == SQLITE_OK)
+                SetReadOnly(ptr_tmp, reader_mmap_size);
         }
         else
         {
@@ -168,11 +295,19 @@ class SQLite::impl
                                  &ptr_tmp,
                                  SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE,
                                  nullptr);
+            // The writes may be in progress, so the readers keep the default mmap_size.
+            reader_path  = filepath.string();
+            reader_flags = SQLITE_OPEN_READWRITE;
         }
         ptrDb = sqlite3_ptr{ptr_tmp};
         return rc;
     }
 
+    // The readers are opened the same way as the main connection. Empty if they can't be.
+    std::string reader_path;
+    int reader_flags             = 0;
+    std::size_t reader_mmap_size = 0;
+
 public:
     impl(const std::string& filename_, bool is_system)
     {
@@ -186,10 +321,69 @@ public:
         isValid = (rc == 0);
         if(isValid)
             sqlite3_busy_timeout(ptrDb.get(), MIOPEN_SQL_BUSY_TIMEOUT_MS);
+        else
+            reader_path.clear();
+    }
+
+    /// A read-only connection and the statements prepared on it.
+    struct Reader
+    {
+        sqlite3_ptr db;
+        // Finalized before the connection is closed.
+        StatementCache statements;
+    };
+
+    /// Returns an idle reader, opening a new one if there are less than MIOPEN_DB_SQLITE_READERS.
+    /// Returns nullptr if all of them are busy, so the main connection should be used.
+    Reader* AcquireReader()
+    {
+        const std::lock_guard<std::mutex> lock{readers_mutex};
+
+        if(!idle_readers.empty())
+        {
+            const auto reader = idle_readers.back();
+            idle_readers.pop_back();
+            return reader;
+        }
+
+        if(reader_path.empty() || readers.size() >= Value(ENV(MIOPEN_DB_SQLITE_READERS)))
+            return nullptr;
+
+        sqlite3* ptr_tmp = nullptr;
+        if(sqlite3_open_v2(reader_path.c_str(), &ptr_tmp, reader_flags, nullptr) != SQLITE_OK)
+        {
+            MIOPEN_LOG_W("Unable to open a reader of " << sqlite3_db_filename(ptrDb.get(), "main")
+                                                       << ": " << sqlite3_errmsg(ptr_tmp));
+            sqlite3_close(ptr_tmp);
+            reader_path.clear();
+            return nullptr;
+        }
+
+        auto reader = std::make_unique<Reader>();
+        reader->db  = sqlite3_ptr{ptr_tmp};
+        sqlite3_busy_timeout(ptr_tmp, MIOPEN_SQL_BUSY_TIMEOUT_MS);
+        SetReadOnly(ptr_tmp, reader_mmap_size);
+        readers.push_back(std::move(reader));
+        return readers.back().get();
+    }
+
+    void ReleaseReader(Reader* reader)
+    {
+        const std::lock_guard<std::mutex> lock{readers_mutex};
+        idle_readers.push_back(reader);
     }
 
     sqlite3_ptr ptrDb = nullptr;
     bool isValid;
+    // Declared after the connection, so the statements are finalized before it is closed.
+    StatementCache statements;
+
+    /// The writes through the main connection share its transaction state.
+    std::mutex write_mutex;
+
+    std::mutex readers_mutex;
+    std::vector<std::unique_ptr<Reader>> readers;
+    std::vector<Reader*> idle_readers;
 };
 
 static int find_callback(void* _res, int argc, char** argv, char** azColName)
@@ -275,48 +469,92 @@ int SQLite::Retry(std::function<int()> f) const
 }
 
 int SQLite::Changes() const { return sqlite3_changes(pImpl->ptrDb.get()); }
+std::mutex& SQLite::GetWriteMutex() const { return pImpl->write_mutex; }
 
-std::string SQLite::ErrorMessage() const
-{
-    std::string errMsg = "Internal error while accessing SQLite database: ";
-    return errMsg + sqlite3_errmsg(pImpl->ptrDb.get());
-}
+std::string SQLite::ErrorMessage() const { return GetErrorMessage(pImpl->ptrDb.get()); }
 bool SQLite::Valid() const { return pImpl->isValid; }
 
 class SQLite::Statement::impl
 {
-    using sqlite3_stmt_ptr = MIOPEN_MANAGE_PTR(sqlite3_stmt*, sqlite3_finalize);
-    sqlite3_stmt_ptr Prepare(const SQLite& sql, const std::string& query)
+    void Bind(const std::vector<std::string>& vals)
     {
-        sqlite3_stmt* ptr = nullptr;
-        MIOPEN_LOG_I2(query);
-        auto rc =
-            sqlite3_prepare_v2(sql.pImpl->ptrDb.get(), query.c_str(), query.size(), &ptr, nullptr);
-        if(rc != SQLITE_OK)
+        int cnt = 1;
+        for(auto& kinder : vals)
         {
-            std::string err_msg = "SQLite prepare error: ";
-            MIOPEN_THROW(miopenStatusInternalError, err_msg + sql.ErrorMessage());
+            auto rc = sqlite3_bind_text(
+                ptrStmt.get(), cnt++, kinder.data(), kinder.size(), SQLITE_TRANSIENT); // NOLINT
+            if(rc != SQLITE_OK)
+                MIOPEN_THROW(miopenStatusInternalError, ErrorMessage());
         }
-        return sqlite3_stmt_ptr{ptr};
+        MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
+    }
+
+    StatementCache& GetCache() const
+    {
+        return reader != nullptr ? reader->statements : db->statements;
+    }
+
+    /// Returns the statement to the cache it has been taken from.
+    void Release()
+    {
+        GetCache().Return(query, std::move(ptrStmt));
+        if(reader != nullptr)
+            db->ReleaseReader(reader);
     }
 
 public:
-    impl(const SQLite& sql, const std::string& query) { ptrStmt = Prepare(sql, query); }
+    impl(const SQLite& sql, const std::string& query)
+    {
+        ptrStmt = PrepareStatement(sql.pImpl->ptrDb.get(), query);
+    }
     impl(const SQLite& sql, const std::string& query, const std::vector<std::string>& vals)
     {
-        ptrStmt = Prepare(sql, query);
-        int cnt = 1;
-        for(auto& kinder : vals)
+        ptrStmt = PrepareStatement(sql.pImpl->ptrDb.get(), query);
+        Bind(vals);
+    }
+    impl(SQLite::impl& db_,
+         const std::string& query_,
+         const std::vector<std::string>& vals,
+         bool read_only)
+        : db(&db_), reader(read_only ? db_.AcquireReader() : nullptr), query(query_)
+    {
+        const auto connection = reader != nullptr ? reader->db.get() : db->ptrDb.get();
+        try
         {
-            auto rc = sqlite3_bind_text(
-                ptrStmt.get(), cnt++, kinder.data(), kinder.size(), SQLITE_TRANSIENT); // NOLINT
-            if(rc != SQLITE_OK)
-                MIOPEN_THROW(miopenStatusInternalError, sql.ErrorMessage());
+            ptrStmt = GetCache().Take(connection, query);
+            Bind(vals);
         }
-        MIOPEN_LOG_I2("[" << JoinStrings(vals, ",") << "]");
+        catch(...)
+        {
+            if(ptrStmt)
+                Release();
+            else if(reader != nullptr)
+                db->ReleaseReader(reader);
+            throw;
+        }
+    }
+
+    impl(const impl&) = delete;
+    impl& operator=(const impl&) = delete;
+
+    ~impl()
+    {
+        if(db != nullptr)
+            Release();
+    }
+
+    std::string ErrorMessage() const
+    {
+        return GetErrorMessage(sqlite3_db_handle(ptrStmt.get()));
     }
 
     sqlite3_stmt_ptr ptrStmt = nullptr;
+
+private:
+    // Set if the statement has been taken from a cache.
+    SQLite::impl* db             = nullptr;
+    SQLite::impl::Reader* reader = nullptr;
+    std::string query;
 };
 
 SQLite::SQLite(const std::string& filename_, bool is_system)
@@ -334,6 +572,7 @@ SQLite::Statement::Statement(const SQLite& sql,
     : pImpl{std::make_unique<impl>(sql, query, vals)}
 {
 }
+SQLite::Statement::Statement(std::unique_ptr<impl> pImpl_) : pImpl{std::move(pImpl_)} {}
 SQLite::Statement::~Statement() = default;
 SQLite::Statement::Statement() : pImpl{nullptr} {}
 SQLite::Statement::Statement(Statement&&) noexcept = default;
@@ -355,6 +594,15 @@ std::string SQLite::Statement::ColumnBlob(int idx)
     auto sz  = sqlite3_column_bytes(pImpl->ptrStmt.get(), idx);
     return std::string{reinterpret_cast<const char*>(ptr), static_cast<size_t>(sz)};
 }
+std::string SQLite::Statement::ErrorMessage() const { return pImpl->ErrorMessage(); }
+
+SQLite::Statement SQLite::Prepare(const std::string& query,
+                                  const std::vector<std::string>& vals,
+                                  bool read_only) const
+{
+    return Statement{std::make_unique<Statement::impl>(*pImpl, query, vals, read_only)};
+}
+
 int64_t SQLite::Statement::ColumnInt64(int idx)
 {
     return sqlite3_column_int64(pImpl->ptrStmt.get(), idx);
@@ -379,8 +627,8 @@ int SQLite::Statement::BindInt64(int idx, const int64_t num)
     return 0;
 }
 
-SQLitePerfDb::SQLitePerfDb(DbKinds db_kind, const std::string& filename_, bool is_system_)
-    : SQLiteBase(db_kind, filename_, is_system_)
+SQLitePerfDb::SQLitePerfDb(DbKinds db_kind_, const std::string& filename_, bool is_system_)
+    : SQLiteBase(db_kind_, filename_, is_system_)
 {
     if(DisableUserDbFileIO && !is_system)
         return;
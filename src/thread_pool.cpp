@@ -0,0 +1,253 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <miopen/thread_pool.hpp>
+
+#include <miopen/env.hpp>
+#include <miopen/logger.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <exception>
+
+MIOPEN_DECLARE_ENV_VAR_UINT64(MIOPEN_THREAD_POOL_SIZE)
+
+namespace miopen {
+
+namespace {
+
+/// The slots of the workers are allocated at once, so that they can be read without a lock.
+constexpr std::size_t max_workers = 256;
+
+/// Index of the worker running in this thread, or max_workers in other threads.
+thread_local std::size_t current_worker = max_workers;
+
+} // namespace
+
+/// A loop of ParallelFor(). The chunks are taken in order by the threads running it, each
+/// task of the loop lets one more thread join.
+struct ThreadPool::Loop
+{
+    std::size_t n;
+    std::size_t grain;
+    std::size_t chunks;
+    const std::function<void(std::size_t)>* f;
+    const CancellationToken* token;
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> done{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr error;
+    std::mutex mutex;
+    std::condition_variable finished;
+
+    Loop(std::size_t n_,
+         std::size_t grain_,
+         const std::function<void(std::size_t)>& f_,
+         const CancellationToken* token_)
+        : n(n_), grain(grain_), chunks((n_ + grain_ - 1) / grain_), f(&f_), token(token_)
+    {
+    }
+
+    /// Runs the chunks which are not taken yet. A task may be picked up after the loop is done,
+    /// then it finds no chunks and does not touch f.
+    void RunChunks()
+    {
+        for(auto chunk = next++; chunk < chunks; chunk = next++)
+        {
+            if(!failed && (token == nullptr || !token->IsCancelled()))
+            {
+                try
+                {
+                    const auto last = std::min(n, (chunk + 1) * grain);
+                    for(auto i = chunk * grain; i < last; ++i)
+                        (*f)(i);
+                }
+                catch(...)
+                {
+                    const std::lock_guard<std::mutex> lock{mutex};
+                    if(!error)
+                        error = std::current_exception();
+                    failed = true;
+                }
+            }
+
+            if(++done == chunks)
+            {
+                const std::lock_guard<std::mutex> lock{mutex};
+                finished.notify_all();
+            }
+        }
+    }
+
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock{mutex};
+        finished.wait(lock, [&]() { return done == chunks; });
+    }
+};
+
+ThreadPool& ThreadPool::Get()
+{
+    // The pool is not destroyed, so the loops run by the destructors of other statics still
+    // work, and its workers are joined by the exit handler.
+    // NOLINTNEXTLINE (cppcoreguidelines-owning-memory)
+    static auto& pool = *new ThreadPool{};
+
+    static std::once_flag exit_once;
+    std::call_once(exit_once, []() { std::atexit([]() { Get().Stop(); }); });
+
+    return pool;
+}
+
+ThreadPool::ThreadPool() : workers(max_workers)
+{
+    const auto size = Value(ENV(MIOPEN_THREAD_POOL_SIZE));
+    limit           = size == 0 ? max_workers : std::min<std::size_t>(size, max_workers);
+}
+
+std::size_t ThreadPool::GetWorkerCount() const { return worker_count; }
+
+void ThreadPool::ParallelFor(std::size_t n,
+                             std::size_t width,
+                             std::size_t grain,
+                             const std::function<void(std::size_t)>& f,
+                             const CancellationToken* token)
+{
+    if(n == 0)
+        return;
+
+    const auto loop    = std::make_shared<Loop>(n, std::max<std::size_t>(grain, 1), f, token);
+    const auto helpers = std::min(width, loop->chunks) - 1;
+    if(helpers > 0)
+    {
+        StartWorkers(helpers);
+        const auto tasks = std::min<std::size_t>(helpers, worker_count);
+        for(std::size_t i = 0; i < tasks; ++i)
+            Push(loop);
+    }
+
+    loop->RunChunks();
+    loop->Wait();
+
+    if(loop->error)
+        std::rethrow_exception(loop->error);
+}
+
+void ThreadPool::StartWorkers(std::size_t count)
+{
+    count = std::min(count, limit);
+    if(worker_count >= count)
+        return;
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    if(stopping)
+        return;
+    for(auto i = worker_count.load(); i < count; ++i)
+    {
+        // The worker is counted before it starts, so it sees itself when it looks for tasks.
+        workers[i]         = std::make_unique<Worker>();
+        worker_count       = i + 1;
+        workers[i]->thread = std::thread([this, i]() { Run(i); });
+    }
+    MIOPEN_LOG_I2("Thread pool workers: " << count);
+}
+
+void ThreadPool::Push(const Task& task)
+{
+    // The nested loops are pushed to the worker running them, to be taken first.
+    const auto self  = current_worker;
+    const auto count = worker_count.load();
+    auto& worker     = *workers[self < count ? self : next_worker++ % count];
+    {
+        const std::lock_guard<std::mutex> lock{worker.mutex};
+        worker.tasks.push_back(task);
+    }
+    ++queued;
+
+    const std::lock_guard<std::mutex> lock{mutex};
+    work.notify_one();
+}
+
+ThreadPool::Task ThreadPool::Pop(std::size_t self)
+{
+    const auto count = worker_count.load();
+    for(std::size_t i = 0; i < count; ++i)
+    {
+        auto& worker = *workers[(self + i) % count];
+        const std::lock_guard<std::mutex> lock{worker.mutex};
+        if(worker.tasks.empty())
+            continue;
+
+        // Own tasks are taken from the back, the latest first, and stolen from the front.
+        auto task = Task{};
+        if(i == 0)
+        {
+            task = std::move(worker.tasks.back());
+            worker.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(worker.tasks.front());
+            worker.tasks.pop_front();
+        }
+        --queued;
+        return task;
+    }
+    return {};
+}
+
+void ThreadPool::Run(std::size_t self)
+{
+    current_worker = self;
+    for(;;)
+    {
+        const auto task = Pop(self);
+        if(task)
+        {
+            task->RunChunks();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock{mutex};
+        work.wait(lock, [&]() { return queued > 0 || stopping; });
+        if(stopping && queued == 0)
+            return;
+    }
+}
+
+void ThreadPool::Stop()
+{
+    {
+        const std::lock_guard<std::mutex> lock{mutex};
+        stopping = true;
+    }
+    work.notify_all();
+
+    for(std::size_t i = 0; i < worker_count; ++i)
+        workers[i]->thread.join();
+}
+
+} // namespace miopen
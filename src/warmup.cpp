@@ -0,0 +1,335 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include <miopen/warmup.hpp>
+#include <miopen/any_solver.hpp>
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/conv_algo_name.hpp>
+#include <miopen/conv/solver_finders.hpp>
+#include <miopen/conv_solution.hpp>
+#include <miopen/convolution.hpp>
+#include <miopen/driver_arguments.hpp>
+#include <miopen/execution_context.hpp>
+#include <miopen/generic_search.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/kernel_build_params.hpp>
+#include <miopen/logger.hpp>
+#include <miopen/mlo_internal.hpp>
+#include <miopen/par_for.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/solver_id.hpp>
+#include <miopen/timer.hpp>
+
+#include <boost/optional.hpp>
+
+#include <exception>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace miopen {
+
+namespace {
+
+struct WarmUpItem
+{
+    boost::optional<conv::ProblemDescription> problem;
+    NetworkConfig network_config;
+    std::vector<solver::Id> solver_ids;
+    std::vector<solver::ConvSolution> solutions;
+    bool failed = false;
+};
+
+boost::optional<conv::ProblemDescription> AsConvolution(const Problem& problem)
+{
+    const auto conv_desc = boost::get<ConvolutionDescriptor>(&problem.GetOperatorDescriptor());
+    if(conv_desc == nullptr)
+        return boost::none;
+    return conv_desc->mode == miopenTranspose ? problem.MakeTransposed().AsConvolution()
+                                              : problem.AsConvolution();
+}
+
+/// Selects the solutions the first Find or immediate mode call would use and finds their
+/// kernels and invoker factories. Does not touch the caches of the handle.
+void Resolve(Handle& handle, WarmUpItem& item)
+{
+    auto ctx            = ExecutionContext{&handle};
+    const auto& problem = *item.problem;
+    problem.SetupFloats(ctx);
+    ctx.do_search              = false;
+    ctx.disable_search_enforce = true;
+
+    // Fast and hybrid Find use the best solution only, as immediate mode usually does. Normal
+    // Find needs the invokers of all the solutions in the find-db record.
+    const auto& conv_desc = problem.GetConv();
+    const auto& find_mode = conv_desc.findMode;
+    const auto all_count  = solver::GetSolversByPrimitive(solver::Primitive::Convolution).size();
+    const auto max_count =
+        find_mode.IsFast(ctx) || find_mode.IsHybrid(ctx) ? std::size_t{1} : all_count;
+    auto fallback  = false;
+    auto solutions = conv_desc.GetSolutions(ctx, problem, max_count, &fallback);
+    // Only the best of the fallback solutions is expected to be used.
+    if(fallback && solutions.size() > 1)
+        solutions.resize(1);
+
+    auto db = GetDb(ctx);
+    for(const auto& solution : solutions)
+    {
+        const auto solver_id = solver::Id{solution.solution_id};
+        auto conv_solution   = solver_id.GetSolver().FindSolution(ctx, problem, db, {});
+        if(!conv_solution.Succeeded() || !conv_solution.invoker_factory)
+        {
+            MIOPEN_LOG_W("Warm-up: " << solver_id.ToString() << " has no solution for "
+                                     << item.network_config.ToString());
+            item.failed = true;
+            continue;
+        }
+        item.solver_ids.push_back(solver_id);
+        item.solutions.push_back(std::move(conv_solution));
+    }
+
+    if(solutions.empty())
+    {
+        MIOPEN_LOG_W("Warm-up: no solutions for " << item.network_config.ToString());
+        item.failed = true;
+    }
+}
+
+/// The kernels of the solutions of all the applicable solvers, as in a Find without a search.
+std::vector<solver::KernelInfo> GetApplicableKernels(Handle& handle,
+                                                     const conv::ProblemDescription& problem)
+{
+    auto ctx = ExecutionContext{&handle};
+    problem.SetupFloats(ctx);
+    ctx.do_search              = false;
+    ctx.disable_search_enforce = true;
+
+    auto db      = GetDb(ctx);
+    auto kernels = std::vector<solver::KernelInfo>{};
+    for(const auto& solver_id : solver::GetSolversByPrimitive(solver::Primitive::Convolution))
+    {
+        if(conv::IsAlgorithmDisabled(solver_id.GetAlgo()))
+            continue;
+        const auto& s = solver_id.GetSolver();
+        if(s.IsEmpty() || !s.IsApplicable(ctx, problem))
+            continue;
+
+        try
+        {
+            const auto solution = s.FindSolution(ctx, problem, db, {});
+            if(!solution.Succeeded())
+                continue;
+            kernels.insert(kernels.end(),
+                           solution.construction_params.begin(),
+                           solution.construction_params.end());
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W(solver_id.ToString() << " failed for "
+                                              << problem.MakeNetworkConfig().ToString() << ": "
+                                              << ex.what());
+        }
+    }
+    return kernels;
+}
+
+/// Registers the invokers of the resolved solutions. The solutions are ordered from the fastest,
+/// so the first solution of each algorithm is set as its find 1.0 result.
+void Register(Handle& handle, WarmUpItem& item)
+{
+    auto algorithms = std::set<std::string>{};
+
+    for(std::size_t i = 0; i < item.solutions.size(); ++i)
+    {
+        const auto& solver_id = item.solver_ids[i];
+        const auto algo       = AlgorithmName{solver_id.GetAlgo(item.problem->GetDirection())};
+        const auto first      = algorithms.insert(algo.ToString()).second;
+        const auto found      = handle.GetInvoker(item.network_config, solver_id);
+        if(found && !first)
+            continue;
+
+        const auto& solution = item.solutions[i];
+        const auto invoker   = found ? *found
+                                     : handle.PrepareInvoker(*solution.invoker_factory,
+                                                           solution.construction_params);
+        handle.RegisterInvoker(invoker,
+                               item.network_config,
+                               solver_id.ToString(),
+                               first ? boost::make_optional(algo) : boost::none);
+    }
+}
+
+} // namespace
+
+WarmUpStats WarmUp(Handle& handle, const std::vector<Problem>& problems)
+{
+    auto timer = Timer{};
+    timer.start();
+
+    auto stats     = WarmUpStats{};
+    stats.problems = problems.size();
+
+    auto items = std::vector<WarmUpItem>(problems.size());
+    for(std::size_t i = 0; i < problems.size(); ++i)
+    {
+        try
+        {
+            items[i].problem = AsConvolution(problems[i]);
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Warm-up: problem #" << i << " is skipped: " << ex.what());
+        }
+
+        if(!items[i].problem)
+        {
+            ++stats.skipped;
+            continue;
+        }
+        items[i].network_config = items[i].problem->MakeNetworkConfig();
+    }
+
+    // clang-format off
+    par_for_strided(items.size(),
+                    max_threads{solver::GetTuningThreadsMax()},
+                    [&](auto i) {
+                        auto& item = items[i];
+                        if(!item.problem)
+                            return;
+                        try
+                        {
+                            Resolve(handle, item);
+                        }
+                        catch(const std::exception& ex)
+                        {
+                            MIOPEN_LOG_W("Warm-up: " << item.network_config.ToString()
+                                                     << " failed: " << ex.what());
+                            item.failed = true;
+                        }
+                    });
+    // clang-format on
+
+    auto solutions = std::vector<const solver::ConvSolution*>{};
+    for(const auto& item : items)
+    {
+        for(const auto& solution : item.solutions)
+            solutions.push_back(&solution);
+    }
+    solver::PrecompileSolutions(handle, solutions);
+
+    for(auto& item : items)
+    {
+        if(!item.problem)
+            continue;
+
+        try
+        {
+            Register(handle, item);
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Warm-up: " << item.network_config.ToString() << " failed: " << ex.what());
+            item.failed = true;
+        }
+
+        if(!item.failed)
+            ++stats.warmed;
+    }
+
+    stats.time_ms = timer.elapsed_ms();
+    MIOPEN_LOG_I("Warm-up: " << stats.warmed << " of " << stats.problems << " problems in "
+                             << stats.time_ms << " ms, " << stats.GetProblemsPerSecond()
+                             << " problems/s");
+    return stats;
+}
+
+std::vector<Problem> ReadDriverCommands(std::istream& stream)
+{
+    auto problems = std::vector<Problem>{};
+    auto line     = std::string{};
+    auto n_line   = 0;
+    while(std::getline(stream, line))
+    {
+        ++n_line;
+        try
+        {
+            for(auto& problem : debug::ParseConvDriverArgs(line))
+                problems.push_back(std::move(problem));
+        }
+        catch(const std::exception& ex)
+        {
+            MIOPEN_LOG_W("Skipping the driver command #" << n_line << " (" << line
+                                                         << "): " << ex.what());
+        }
+    }
+    return problems;
+}
+
+std::vector<solver::KernelInfo> CollectKernels(Handle& handle, const std::vector<Problem>& problems)
+{
+    auto timer = Timer{};
+    timer.start();
+
+    auto per_problem = std::vector<std::vector<solver::KernelInfo>>(problems.size());
+
+    // clang-format off
+    par_for_strided(problems.size(),
+                    max_threads{solver::GetTuningThreadsMax()},
+                    [&](auto i) {
+                        try
+                        {
+                            const auto problem = AsConvolution(problems[i]);
+                            if(problem)
+                                per_problem[i] = GetApplicableKernels(handle, *problem);
+                            else
+                                MIOPEN_LOG_W("Problem #" << i << " is not a convolution");
+                        }
+                        catch(const std::exception& ex)
+                        {
+                            MIOPEN_LOG_W("Problem #" << i << " is skipped: " << ex.what());
+                        }
+                    });
+    // clang-format on
+
+    auto kernels = std::vector<solver::KernelInfo>{};
+    auto keys    = std::set<std::string>{};
+    for(auto& problem_kernels : per_problem)
+    {
+        for(auto& kernel : problem_kernels)
+        {
+            // A program is built once for all its kernels.
+            const auto options = KernelBuildParameters::Canonicalize(kernel.comp_options);
+            if(keys.insert(kernel.kernel_file + '\n' + options).second)
+                kernels.push_back(std::move(kernel));
+        }
+    }
+
+    MIOPEN_LOG_I(kernels.size() << " kernels of " << problems.size() << " problems collected in "
+                                << timer.elapsed_ms() << " ms");
+    return kernels;
+}
+
+} // namespace miopen
@@ -0,0 +1,216 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+
+#include "test.hpp"
+#include "driver.hpp"
+
+#include <miopen/compile_lease.hpp>
+#include <miopen/filesystem.hpp>
+#include <miopen/lock_file.hpp>
+#include <miopen/process.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace miopen {
+namespace tests {
+
+static fs::path& exe_path()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static fs::path exe_path;
+    return exe_path;
+}
+
+constexpr const char* child_id_arg   = "mp-test-child";
+constexpr const char* child_path_arg = "mp-test-child-path";
+constexpr int workers_count          = 8;
+
+/// Stands in for the compiler and the kernel cache: the "binary" is a file in the work
+/// directory, and each compilation is counted as a line of another file.
+struct FakeCompiler
+{
+    fs::path dir;
+
+    fs::path BinaryPath() const { return dir / "kernel.o"; }
+    fs::path CountPath() const { return dir / "compiles.txt"; }
+    fs::path LeasePath() const { return dir / "kernel.lock"; }
+
+    std::string Load() const
+    {
+        auto file = std::ifstream{BinaryPath()};
+        return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+    }
+
+    void Compile(const std::string& worker) const
+    {
+        std::ofstream{CountPath(), std::ios::app} << worker << std::endl;
+        // Long enough for all the workers to miss the binary at first.
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        const auto tmp_path = dir / ("kernel.o." + worker);
+        std::ofstream{tmp_path} << "binary";
+        fs::rename(tmp_path, BinaryPath());
+    }
+
+    std::size_t GetCompilesCount() const
+    {
+        auto file  = std::ifstream{CountPath()};
+        auto count = std::size_t{0};
+        for(std::string line; std::getline(file, line);)
+            ++count;
+        return count;
+    }
+
+    /// What Handle::LoadProgram does for a kernel.
+    bool LoadOrCompile(const std::string& worker) const
+    {
+        auto binary = Load();
+        if(!binary.empty())
+            return true;
+
+        auto lease = CompileLease{LeasePath(), std::chrono::seconds(30)};
+        binary     = lease.Wait([&]() { return Load(); });
+        if(binary.empty())
+            Compile(worker);
+        return Load() == "binary";
+    }
+};
+
+struct CompileLeaseMultiThreadedTest
+{
+    void Run() const
+    {
+        std::cout << "Testing the compile lease for threads..." << std::endl;
+
+        const auto dir      = TmpDir{"compile_lease"};
+        const auto compiler = FakeCompiler{dir.path};
+        std::atomic<int> loaded{0};
+
+        std::vector<std::thread> threads;
+        for(auto i = 0; i < workers_count; ++i)
+        {
+            threads.emplace_back([&, i]() {
+                if(compiler.LoadOrCompile("thread" + std::to_string(i)))
+                    ++loaded;
+            });
+        }
+        for(auto& thread : threads)
+            thread.join();
+
+        EXPECT_EQUAL(loaded.load(), workers_count);
+        EXPECT_EQUAL(compiler.GetCompilesCount(), 1);
+        EXPECT(!fs::exists(compiler.LeasePath()));
+    }
+};
+
+struct CompileLeaseMultiProcessTest
+{
+    void Run() const
+    {
+        std::cout << "Testing the compile lease for processes..." << std::endl;
+
+        const auto dir      = TmpDir{"compile_lease"};
+        const auto compiler = FakeCompiler{dir.path};
+        std::vector<ProcessAsync> children{};
+
+        {
+            // The workers start together, when the lock is released.
+            const auto lock_path = LockFilePath(dir.path);
+            auto& file_lock      = LockFile::Get(lock_path.c_str());
+            std::shared_lock<LockFile> lock(file_lock);
+
+            for(auto i = 0; i < workers_count; ++i)
+            {
+                // clang-format off
+                const auto args = std::string{"--"} + child_id_arg + " " + std::to_string(i) +
+                                  " --" + child_path_arg + " " + dir.path.string();
+                // clang-format on
+                children.emplace_back(exe_path(), args);
+            }
+        }
+
+        for(auto&& child : children)
+            EXPECT_EQUAL(child.Wait(), 0);
+
+        EXPECT_EQUAL(compiler.GetCompilesCount(), 1);
+        EXPECT(!fs::exists(compiler.LeasePath()));
+    }
+
+    static void WorkItem(int id, const fs::path& dir)
+    {
+        {
+            const auto lock_path = LockFilePath(dir);
+            auto& file_lock      = LockFile::Get(lock_path.c_str());
+            std::lock_guard<LockFile> lock(file_lock);
+        }
+
+        const auto compiler = FakeCompiler{dir};
+        EXPECT(compiler.LoadOrCompile("process" + std::to_string(id)));
+    }
+};
+
+struct CompileLeaseDriver : test_driver
+{
+    CompileLeaseDriver()
+    {
+        add(child_id, child_id_arg);
+        add(child_path, child_path_arg);
+    }
+
+    void run() const
+    {
+        if(child_id >= 0)
+        {
+            CompileLeaseMultiProcessTest::WorkItem(child_id, child_path);
+            return;
+        }
+
+        CompileLeaseMultiThreadedTest{}.Run();
+        CompileLeaseMultiProcessTest{}.Run();
+    }
+
+private:
+    int child_id = -1;
+    std::string child_path;
+};
+
+} // namespace tests
+} // namespace miopen
+
+int main(int argc, const char* argv[])
+{
+    miopen::tests::exe_path() = argv[0];
+    test_drive<miopen::tests::CompileLeaseDriver>(argc, argv);
+}
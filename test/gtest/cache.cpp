@@ -27,12 +27,19 @@
 #include <miopen/binary_cache.hpp>
 #include <miopen/kern_db.hpp>
 #include <miopen/temp_file.hpp>
+#include <miopen/tmp_dir.hpp>
 
 #include "test.hpp"
 #include "random.hpp"
 
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <thread>
+#include <vector>
+
 #if MIOPEN_ENABLE_SQLITE
 std::string random_string(size_t length)
 {
@@ -134,7 +141,165 @@ TEST(TestCache, check_kern_db)
         EXPECT_TRUE(err_db.RemoveRecordUnsafe(cfg0));
     }
 }
+
+TEST(TestCache, check_kern_db_readers)
+{
+    miopen::UpdateEnvVar(ENV(MIOPEN_DB_SQLITE_READERS), uint64_t{2});
+
+    std::vector<miopen::KernelConfig> cfgs(8);
+    for(auto i = std::size_t{0}; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        // The values are bound, so they may contain quotes.
+        cfgs[i].kernel_args = "-DNAME='" + random_string(64) + "'";
+        cfgs[i].kernel_blob = random_string(1024);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb db(miopen::DbKinds::KernelDb, std::string(temp_file), false);
+    for(const auto& cfg : cfgs)
+        EXPECT_TRUE(db.StoreRecordUnsafe(cfg));
+
+    std::atomic<int> mismatches{0};
+    std::vector<std::thread> threads;
+    for(auto t = 0; t < 4; ++t)
+    {
+        threads.emplace_back([&]() {
+            // The statements and the readers are reused by the following lookups.
+            for(auto i = 0; i < 100; ++i)
+            {
+                const auto& cfg    = cfgs[i % cfgs.size()];
+                const auto readout = db.FindRecord(cfg);
+                if(!readout || *readout != cfg.kernel_blob)
+                    ++mismatches;
+            }
+        });
+    }
+    for(auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(mismatches, 0);
+    miopen::Unset(ENV(MIOPEN_DB_SQLITE_READERS));
+}
+
+TEST(TestCache, check_kern_db_trim)
+{
+    std::vector<miopen::KernelConfig> cfgs(8);
+    for(auto i = std::size_t{0}; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = random_string(64);
+        cfgs[i].kernel_blob = random_string(1024);
+    }
+
+    miopen::TempFile temp_file("tmp-kerndb");
+    miopen::KernDb db(miopen::DbKinds::KernelDb, std::string(temp_file), false);
+    for(const auto& cfg : cfgs)
+        EXPECT_TRUE(db.StoreRecordUnsafe(cfg));
+
+    const auto usage = db.GetUsage();
+    EXPECT_EQ(usage.kernels, cfgs.size());
+
+    // A lookup of a kernel not used for long updates its access time.
+    db.sql.Exec("UPDATE kern_db SET last_access = 1;");
+    EXPECT_TRUE(db.FindRecordUnsafe(cfgs[3]));
+
+    const auto trimmed = db.Trim(usage.bytes / 2, 0, true);
+    EXPECT_LT(trimmed.kernels, cfgs.size());
+    EXPECT_LE(trimmed.bytes, usage.bytes / 2);
+    EXPECT_EQ(trimmed.kernels, db.GetUsage().kernels);
+    EXPECT_TRUE(db.FindRecordUnsafe(cfgs[3]));
+    EXPECT_FALSE(db.FindRecordUnsafe(cfgs[0]));
+
+    const auto aged = db.Trim(usage.bytes, 2, false);
+    EXPECT_EQ(aged.kernels, std::size_t{1});
+    EXPECT_TRUE(db.FindRecordUnsafe(cfgs[3]));
+}
+
+#if MIOPEN_ENABLE_SQLITE_KERN_CACHE
+TEST(TestCache, check_kern_db_merge)
+{
+    std::vector<miopen::KernelConfig> cfgs(6);
+    for(auto i = std::size_t{0}; i < cfgs.size(); ++i)
+    {
+        cfgs[i].kernel_name = "kernel" + std::to_string(i);
+        cfgs[i].kernel_args = random_string(64);
+        cfgs[i].kernel_blob = random_string(1024);
+    }
+
+    miopen::TempFile src_file("tmp-kerndb");
+    miopen::TempFile dst_file("tmp-kerndb");
+    {
+        miopen::KernDb src(miopen::DbKinds::KernelDb, std::string(src_file), false);
+        for(auto i = std::size_t{2}; i < cfgs.size(); ++i)
+            EXPECT_TRUE(src.StoreRecordUnsafe(cfgs[i]));
+    }
+
+    // The kernels in both are replaced by those of the source.
+    miopen::KernDb dst(miopen::DbKinds::KernelDb, std::string(dst_file), false);
+    for(auto i = std::size_t{0}; i < 4; ++i)
+    {
+        auto stale        = cfgs[i];
+        stale.kernel_blob = random_string(512);
+        EXPECT_TRUE(dst.StoreRecordUnsafe(stale));
+    }
+
+    const auto merged = miopen::MergeKernelDb(src_file.Path(), dst_file.Path());
+    EXPECT_EQ(merged.kernels, cfgs.size());
+    for(auto i = std::size_t{2}; i < cfgs.size(); ++i)
+        EXPECT_EQ(dst.FindRecordUnsafe(cfgs[i]).value_or(""), cfgs[i].kernel_blob);
+    EXPECT_TRUE(dst.FindRecordUnsafe(cfgs[0]));
+}
+
+TEST(TestCache, check_kern_db_merge_system)
+{
+    miopen::TempFile src_file("tmp-kerndb");
+    {
+        miopen::KernDb src(miopen::DbKinds::KernelDb, std::string(src_file), false);
+        EXPECT_TRUE(src.StoreRecordUnsafe(miopen::KernelConfig{"kernel", "", random_string(64)}));
+    }
+
+    // The system kernel dbs are installed to read-only directories, so they can't be left in
+    // the WAL mode.
+    const auto dir  = miopen::TmpDir{"kerndb"};
+    const auto path = dir.path / "gfx906_60.kdb";
+    EXPECT_EQ(miopen::MergeKernelDb(src_file.Path(), path).kernels, 1);
+    EXPECT_FALSE(miopen::fs::exists(path.string() + "-wal"));
+
+    const auto sql  = miopen::SQLite{path.string(), true};
+    const auto mode = sql.Exec("PRAGMA journal_mode;");
+    ASSERT_EQ(mode.size(), 1);
+    EXPECT_EQ(mode[0].at("journal_mode"), "delete");
+}
 #endif
+#endif
+
+TEST(TestCache, check_cache_dir_trim)
+{
+    const auto dir = miopen::TmpDir{"kernel-cache"};
+    const auto now = miopen::fs::file_time_type::clock::now();
+    for(auto i = 0; i < 4; ++i)
+    {
+        const auto path = dir.path / std::to_string(i) / "kernel.o";
+        miopen::fs::create_directories(path.parent_path());
+        std::ofstream{path} << std::string(1000, 'k');
+        miopen::fs::last_write_time(path, now - std::chrono::hours{24 * (10 - i)});
+    }
+    std::ofstream{dir.path / "gfx90a68.ukdb"} << "not a kernel";
+
+    const auto usage = miopen::GetKernelCacheUsage(dir.path);
+    EXPECT_EQ(usage.kernels, std::size_t{4});
+    EXPECT_EQ(usage.bytes, std::size_t{4000});
+
+    const auto trimmed = miopen::TrimKernelCache(dir.path, 2500);
+    EXPECT_EQ(trimmed.kernels, std::size_t{2});
+    EXPECT_FALSE(miopen::fs::exists(dir.path / "0"));
+    EXPECT_TRUE(miopen::fs::exists(dir.path / "3" / "kernel.o"));
+
+    const auto days_ago = std::chrono::system_clock::now() - std::chrono::hours{24 * 5};
+    const auto aged     = miopen::TrimKernelCache(dir.path, 2500, days_ago);
+    EXPECT_EQ(aged.kernels, std::size_t{0});
+}
 
 TEST(TestCache, check_cache_file)
 {
@@ -0,0 +1,116 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/clock_map.hpp>
+
+#include <string>
+#include <vector>
+
+namespace {
+
+using TestMap = miopen::ClockMap<std::string, int>;
+
+struct EvictionLog
+{
+    std::vector<std::string> keys;
+
+    auto Callback()
+    {
+        return [this](const std::string& key, int&) { keys.push_back(key); };
+    }
+};
+
+} // namespace
+
+TEST(ClockMap, EvictsUnreferencedEntries)
+{
+    auto map = TestMap{3};
+    auto log = EvictionLog{};
+
+    map.TryEmplace("a", log.Callback(), 1);
+    map.TryEmplace("b", log.Callback(), 2);
+    map.TryEmplace("c", log.Callback(), 3);
+    EXPECT_TRUE(log.keys.empty());
+
+    // All the entries are referenced on insertion, so the hand clears them and comes back.
+    map.TryEmplace("d", log.Callback(), 4);
+    ASSERT_EQ(log.keys, std::vector<std::string>{"a"});
+
+    // The lookup gives "b" a second chance.
+    ASSERT_NE(map.Find("b"), nullptr);
+    map.TryEmplace("e", log.Callback(), 5);
+    ASSERT_EQ(log.keys, (std::vector<std::string>{"a", "c"}));
+
+    EXPECT_EQ(map.Size(), 3);
+    EXPECT_EQ(*map.Find("b"), 2);
+    EXPECT_EQ(*map.Find("d"), 4);
+    EXPECT_EQ(*map.Find("e"), 5);
+    EXPECT_EQ(map.Find("a"), nullptr);
+}
+
+TEST(ClockMap, ExistingEntryIsNotReplaced)
+{
+    auto map = TestMap{1};
+    auto log = EvictionLog{};
+
+    EXPECT_TRUE(map.TryEmplace("a", log.Callback(), 1).second);
+    const auto result = map.TryEmplace("a", log.Callback(), 2);
+    EXPECT_FALSE(result.second);
+    EXPECT_EQ(result.first, 1);
+    EXPECT_TRUE(log.keys.empty());
+}
+
+TEST(ClockMap, ZeroCapacityIsUnbounded)
+{
+    auto map = TestMap{};
+    auto log = EvictionLog{};
+
+    for(auto i = 0; i < 100; ++i)
+        map.TryEmplace(std::to_string(i), log.Callback(), i);
+
+    EXPECT_EQ(map.Size(), 100);
+    EXPECT_TRUE(log.keys.empty());
+}
+
+TEST(ClockMap, EraseAndMove)
+{
+    auto map = TestMap{2};
+    auto log = EvictionLog{};
+
+    map.TryEmplace("a", log.Callback(), 1);
+    map.TryEmplace("b", log.Callback(), 2);
+    EXPECT_TRUE(map.Erase("a"));
+    EXPECT_FALSE(map.Erase("a"));
+
+    auto moved = std::move(map);
+    EXPECT_EQ(moved.Size(), 1);
+    moved.TryEmplace("c", log.Callback(), 3);
+    EXPECT_TRUE(log.keys.empty());
+    moved.TryEmplace("d", log.Callback(), 4);
+    EXPECT_EQ(log.keys.size(), 1);
+    EXPECT_EQ(moved.Size(), 2);
+}
@@ -0,0 +1,130 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/compile_scheduler.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using miopen::solver::CompileScheduler;
+using miopen::solver::KernelInfo;
+
+KernelInfo MakeKernel(const std::string& file, const std::string& options = "")
+{
+    auto kernel         = KernelInfo{};
+    kernel.kernel_file  = file;
+    kernel.comp_options = options;
+    kernel.kernel_name  = "kernel";
+    return kernel;
+}
+
+struct BuildLog
+{
+    std::mutex mutex;
+    std::vector<std::string> files;
+
+    CompileScheduler::Build Build(std::chrono::milliseconds delay = {})
+    {
+        return [this, delay](const KernelInfo& kernel) {
+            std::this_thread::sleep_for(delay);
+            const std::lock_guard<std::mutex> lock{mutex};
+            files.push_back(kernel.kernel_file);
+        };
+    }
+};
+
+} // namespace
+
+TEST(CompileScheduler, BuildsEachProgramOnce)
+{
+    auto log       = BuildLog{};
+    auto scheduler = CompileScheduler{"gfx_dedup", 4, log.Build()};
+
+    const auto a = MakeKernel("dedup_a.s");
+    const auto b = MakeKernel("dedup_b.s");
+    scheduler.Start({a, b, a});
+    scheduler.Start({b, MakeKernel("dedup_b.s", "-DX")});
+    scheduler.WaitAll();
+
+    EXPECT_EQ(log.files.size(), 3);
+}
+
+TEST(CompileScheduler, WaitsForAnotherScheduler)
+{
+    auto log    = BuildLog{};
+    auto first  = CompileScheduler{"gfx_shared", 1, log.Build(std::chrono::milliseconds{100})};
+    auto second = CompileScheduler{"gfx_shared", 1, log.Build()};
+
+    const auto kernel = MakeKernel("shared.s");
+    first.Start({kernel});
+    second.Start({kernel});
+
+    // The second one builds after the first is done, expected to load the program.
+    second.Wait({kernel});
+    ASSERT_EQ(log.files.size(), 2);
+    first.WaitAll();
+    EXPECT_EQ(log.files.size(), 2);
+}
+
+TEST(CompileScheduler, StartsLongestFirst)
+{
+    miopen::RecordCompileTime("order_short.s", 10);
+    miopen::RecordCompileTime("order_long.s", 10000);
+
+    auto log       = BuildLog{};
+    auto scheduler = CompileScheduler{"gfx_order", 1, log.Build()};
+    scheduler.Start({MakeKernel("order_short.s"),
+                     MakeKernel("order_unknown.cl"),
+                     MakeKernel("order_long.s")});
+    scheduler.WaitAll();
+
+    EXPECT_EQ(log.files,
+              (std::vector<std::string>{"order_long.s", "order_unknown.cl", "order_short.s"}));
+}
+
+TEST(CompileScheduler, RethrowsBuildErrors)
+{
+    auto scheduler = CompileScheduler{"gfx_error", 2, [](const KernelInfo& kernel) {
+                                          if(kernel.kernel_file == "error_bad.s")
+                                              throw std::runtime_error("build failed");
+                                      }};
+
+    const auto good = MakeKernel("error_good.s");
+    const auto bad  = MakeKernel("error_bad.s");
+    scheduler.Start({good, bad});
+
+    EXPECT_NO_THROW(scheduler.Wait({good}));
+    EXPECT_THROW(scheduler.Wait({bad}), std::runtime_error);
+    EXPECT_THROW(scheduler.WaitAll(), std::runtime_error);
+}
@@ -0,0 +1,104 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/db_merge.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <cmath>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+using miopen::binary_db::SourceRecord;
+using miopen::db_merge::Conflict;
+using miopen::db_merge::Merger;
+
+SourceRecord Parse(const std::string& line)
+{
+    auto record = SourceRecord{};
+    EXPECT_TRUE(miopen::binary_db::ParseTextRecord(line, record));
+    return record;
+}
+
+std::string ToText(const std::vector<SourceRecord>& records)
+{
+    auto ss = std::ostringstream{};
+    miopen::db_merge::WriteText(records, ss);
+    return ss.str();
+}
+
+} // namespace
+
+TEST(DbMerge, PerfDbKeepsFirstItems)
+{
+    auto merger = Merger{Conflict::KeepFirst};
+    merger.Add(Parse("key_b=s1:1,2;s2:3,4"));
+    merger.Add(Parse("key_a=s1:5"));
+    merger.Add(Parse("key_b=s2:6;s3:7"));
+
+    EXPECT_EQ(ToText(merger.Release()), "key_a=s1:5\nkey_b=s1:1,2;s2:3,4;s3:7\n");
+
+    const auto& stats = merger.GetStats();
+    EXPECT_EQ(stats.records, 3);
+    EXPECT_EQ(stats.items, 5);
+    EXPECT_EQ(stats.replaced, 0);
+    EXPECT_EQ(stats.ignored, 1);
+    EXPECT_EQ(stats.dropped, 0);
+}
+
+TEST(DbMerge, FindDbKeepsFastestItems)
+{
+    auto merger = Merger{Conflict::KeepFastest};
+    merger.Add(Parse("key=s1:0.5,0,a1;s2:0.3,64,a2;s3:bad"));
+    merger.Add(Parse("key=s1:0.25,128,a1;s2:0.4,0,a2;s3:0.1,0,a3"));
+
+    EXPECT_EQ(ToText(merger.Release()), "key=s1:0.25,128,a1;s2:0.3,64,a2;s3:0.1,0,a3\n");
+    EXPECT_EQ(merger.GetStats().replaced, 2);
+    EXPECT_EQ(merger.GetStats().ignored, 1);
+}
+
+TEST(DbMerge, DropsUnknownIds)
+{
+    auto merger = Merger{Conflict::KeepFirst,
+                         [](const std::string& id) { return miopen::solver::Id{id}.IsValid(); }};
+    merger.Add(Parse("key_a=ConvOclDirectFwd:1;RemovedSolver:2"));
+    merger.Add(Parse("key_b=RemovedSolver:3"));
+
+    EXPECT_EQ(ToText(merger.Release()), "key_a=ConvOclDirectFwd:1\n");
+    EXPECT_EQ(merger.GetStats().dropped, 2);
+}
+
+TEST(DbMerge, ReadsFindDbTime)
+{
+    EXPECT_EQ(miopen::db_merge::GetFindDbTime("0.125,0,miopenConvolutionFwdAlgoDirect"), 0.125f);
+    EXPECT_EQ(miopen::db_merge::GetFindDbTime("2"), 2.0f);
+    EXPECT_TRUE(std::isinf(miopen::db_merge::GetFindDbTime("")));
+    EXPECT_TRUE(std::isinf(miopen::db_merge::GetFindDbTime("x,0,a")));
+    EXPECT_TRUE(std::isinf(miopen::db_merge::GetFindDbTime("-1,0,a")));
+}
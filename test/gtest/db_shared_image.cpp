@@ -0,0 +1,262 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/db_binary_format.hpp>
+#include <miopen/db_shared_image.hpp>
+#include <miopen/temp_file.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#ifdef __linux__
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace {
+
+std::string ReadText(const miopen::TempFile& file)
+{
+    auto in = std::ifstream{file.Path()};
+    auto ss = std::ostringstream{};
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+std::string GetValues(const miopen::binary_db::View& view, const std::string& key)
+{
+    const auto record = view.Find(key);
+    if(!record)
+        return {};
+    auto ss = std::ostringstream{};
+    view.WriteIdsAndValues(*record, ss);
+    return ss.str();
+}
+
+} // namespace
+
+TEST(DbSharedImage, BuildAndAttach)
+{
+    const auto file = miopen::TempFile{"miopen.tests.db_shared_image"};
+    {
+        auto out = std::ofstream{file.Path()};
+        out << "key1=Solver1:1,2;Solver2:3\n"
+            << "key0=Solver1:4\n"
+            << "\n"
+            << "key1=Solver1:5\n";
+    }
+
+    auto text       = std::string{};
+    auto load_count = 0;
+    const auto load = [&]() -> boost::optional<std::string_view> {
+        ++load_count;
+        text = ReadText(file);
+        return std::string_view{text};
+    };
+
+    const auto built = miopen::SharedDbImage::Open(file.Path(), load);
+    ASSERT_NE(built, nullptr);
+    EXPECT_EQ(load_count, 1);
+
+    const auto attached = miopen::SharedDbImage::Open(file.Path(), load);
+    ASSERT_NE(attached, nullptr);
+    EXPECT_EQ(load_count, 1);
+    EXPECT_EQ(built->GetName(), attached->GetName());
+
+    auto error      = std::string{};
+    const auto view = miopen::binary_db::View::Open(attached->View(), error);
+    ASSERT_TRUE(view) << error;
+    EXPECT_EQ(view->GetRecordCount(), 2);
+    EXPECT_EQ(GetValues(*view, "key0"), "Solver1:4");
+    EXPECT_EQ(GetValues(*view, "key1"), "Solver1:1,2;Solver2:3");
+
+    // A changed file gets a new image.
+    {
+        auto out = std::ofstream{file.Path(), std::ios::app};
+        out << "key2=Solver1:6\n";
+    }
+    const auto changed = miopen::SharedDbImage::Open(file.Path(), load);
+    ASSERT_NE(changed, nullptr);
+    EXPECT_EQ(load_count, 2);
+    EXPECT_NE(changed->GetName(), built->GetName());
+    changed->Unlink();
+}
+
+TEST(DbSharedImage, BinaryDbIsNotCopied)
+{
+    const auto file = miopen::TempFile{"miopen.tests.db_shared_image.bin"};
+    {
+        auto records = std::vector<miopen::binary_db::SourceRecord>{{"key", {{"Solver", "1"}}}};
+        auto out     = std::ofstream{file.Path(), std::ios::binary};
+        miopen::binary_db::Write(std::move(records), out);
+    }
+
+    auto text       = std::string{};
+    const auto load = [&]() -> boost::optional<std::string_view> {
+        text = ReadText(file);
+        return std::string_view{text};
+    };
+
+    EXPECT_EQ(miopen::SharedDbImage::Open(file.Path(), load), nullptr);
+}
+
+TEST(DbSharedImage, OrphanIsRebuilt)
+{
+    const auto file = miopen::TempFile{"miopen.tests.db_shared_image.orphan"};
+    {
+        auto out = std::ofstream{file.Path()};
+        out << "key0=Solver1:1\n";
+    }
+
+    auto text       = std::string{};
+    auto load_count = 0;
+    const auto load = [&]() -> boost::optional<std::string_view> {
+        ++load_count;
+        text = ReadText(file);
+        return std::string_view{text};
+    };
+
+    auto name = std::string{};
+    {
+        const auto built = miopen::SharedDbImage::Open(file.Path(), load);
+        ASSERT_NE(built, nullptr);
+        name = built->GetName();
+        built->Unlink();
+    }
+
+    // The segment of a process which has died right after creating it.
+    const auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    EXPECT_EQ(miopen::SharedDbImage::Open(file.Path(), load), nullptr);
+    EXPECT_EQ(load_count, 1);
+
+    const auto rebuilt = miopen::SharedDbImage::Open(file.Path(), load);
+    ASSERT_NE(rebuilt, nullptr);
+    EXPECT_EQ(load_count, 2);
+    rebuilt->Unlink();
+}
+
+TEST(DbSharedImage, OwnerIsCheckedByLock)
+{
+    const auto file = miopen::TempFile{"miopen.tests.db_shared_image.owner"};
+    {
+        auto out = std::ofstream{file.Path()};
+        out << "key0=Solver1:1\n";
+    }
+
+    auto text       = std::string{};
+    auto load_count = 0;
+    const auto load = [&]() -> boost::optional<std::string_view> {
+        ++load_count;
+        text = ReadText(file);
+        return std::string_view{text};
+    };
+
+    auto name = std::string{};
+    {
+        const auto built = miopen::SharedDbImage::Open(file.Path(), load);
+        ASSERT_NE(built, nullptr);
+        name = built->GetName();
+        built->Unlink();
+    }
+
+    // The incomplete segment of a process which has died, while its PID is reused by a live
+    // process: magic, Building state, owner PID and image size.
+    struct
+    {
+        char magic[8]       = {'M', 'I', 'O', 'P', 'E', 'N', 'S', 'H'};
+        std::uint32_t state = 0;
+        std::uint32_t pid   = static_cast<std::uint32_t>(getpid());
+        std::uint64_t size  = 0;
+    } header;
+    const auto fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    ASSERT_GE(fd, 0);
+    EXPECT_EQ(write(fd, &header, sizeof(header)), static_cast<ssize_t>(sizeof(header)));
+    close(fd);
+
+    // It is removed without waiting for the owner.
+    const auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(miopen::SharedDbImage::Open(file.Path(), load), nullptr);
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::seconds{5});
+    EXPECT_EQ(load_count, 1);
+
+    const auto rebuilt = miopen::SharedDbImage::Open(file.Path(), load);
+    ASSERT_NE(rebuilt, nullptr);
+    EXPECT_EQ(load_count, 2);
+    rebuilt->Unlink();
+}
+
+TEST(DbSharedImage, OtherFormatsAreKept)
+{
+    const auto file = miopen::TempFile{"miopen.tests.db_shared_image.formats"};
+    {
+        auto out = std::ofstream{file.Path()};
+        out << "key0=Solver1:1\n";
+    }
+
+    auto text       = std::string{};
+    const auto load = [&]() -> boost::optional<std::string_view> {
+        text = ReadText(file);
+        return std::string_view{text};
+    };
+
+    auto name = std::string{};
+    {
+        const auto built = miopen::SharedDbImage::Open(file.Path(), load);
+        ASSERT_NE(built, nullptr);
+        name = built->GetName();
+        built->Unlink();
+    }
+
+    // The segment of the same db file made by a MIOpen version using another format.
+    const auto version = "-v" + std::to_string(miopen::binary_db::version) + "-";
+    const auto other   = std::string{name}.replace(
+        name.find(version),
+        version.size(),
+        "-v" + std::to_string(miopen::binary_db::version + 1) + "-");
+    const auto fd = shm_open(other.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    const auto rebuilt = miopen::SharedDbImage::Open(file.Path(), load);
+    ASSERT_NE(rebuilt, nullptr);
+    rebuilt->Unlink();
+
+    const auto kept = shm_open(other.c_str(), O_RDONLY, 0);
+    EXPECT_GE(kept, 0);
+    if(kept >= 0)
+        close(kept);
+    shm_unlink(other.c_str());
+}
+
+#endif
@@ -0,0 +1,157 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/db.hpp>
+#include <miopen/db_stats.hpp>
+#include <miopen/miopen.h>
+#include <miopen/temp_file.hpp>
+#include <miopen/tmp_dir.hpp>
+
+#include <nlohmann/json.hpp>
+
+#include <cstdint>
+#include <numeric>
+#include <string>
+
+namespace {
+
+struct TestValues
+{
+    int value = 0;
+
+    void Serialize(std::ostream& stream) const { stream << value; }
+
+    bool Deserialize(const std::string& str)
+    {
+        value = std::stoi(str);
+        return true;
+    }
+};
+
+} // namespace
+
+TEST(DbStats, CountsLookupsAndStores)
+{
+    const auto file = miopen::TempFile{"miopen.tests.db_stats"};
+    auto& stats     = miopen::DbStats::Get(miopen::DbKinds::PerfDb);
+    const auto old  = stats.GetSnapshot();
+
+    auto db        = miopen::DbTimer<miopen::PlainTextDb>{miopen::DbKinds::PerfDb, file.Path()};
+    auto values    = TestValues{};
+    const auto key = std::string{"key"};
+
+    EXPECT_FALSE(db.Load(key, "id", values));
+    db.Update(key, "id", TestValues{42});
+    EXPECT_TRUE(db.Load(key, "id", values));
+    EXPECT_EQ(values.value, 42);
+    EXPECT_TRUE(db.FindRecord(key));
+
+    const auto now = stats.GetSnapshot();
+    EXPECT_EQ(now.lookups - old.lookups, 3);
+    EXPECT_EQ(now.hits - old.hits, 2);
+    EXPECT_EQ(now.misses - old.misses, 1);
+    EXPECT_EQ(now.stores - old.stores, 1);
+    EXPECT_EQ(now.bytes_read - old.bytes_read, 2 * std::string{"key=id:42"}.size());
+
+    const auto histogram = [](const miopen::DbStats::Snapshot& snapshot) {
+        return std::accumulate(
+            snapshot.lookup_latency.begin(), snapshot.lookup_latency.end(), std::uint64_t{0});
+    };
+    EXPECT_EQ(histogram(now) - histogram(old), 3);
+}
+
+TEST(DbStats, FailedStoresAreNotCounted)
+{
+    // The db is a directory, so it cannot be written.
+    const auto dir = miopen::TmpDir{"db_stats"};
+    auto& stats    = miopen::DbStats::Get(miopen::DbKinds::PerfDb);
+    const auto old = stats.GetSnapshot();
+
+    auto db = miopen::DbTimer<miopen::PlainTextDb>{miopen::DbKinds::PerfDb, dir.path.string()};
+    EXPECT_FALSE(db.Update(std::string{"key"}, "id", TestValues{42}));
+    EXPECT_EQ(stats.GetSnapshot().stores, old.stores);
+}
+
+TEST(DbStats, PublicApi)
+{
+    ASSERT_EQ(miopenResetDbStats(), miopenStatusSuccess);
+
+    auto stats = miopenDbStats_t{};
+    ASSERT_EQ(miopenGetDbStats(miopenDbKindPerfDb, &stats), miopenStatusSuccess);
+    EXPECT_EQ(stats.lookups, 0);
+    EXPECT_EQ(stats.stores, 0);
+
+    const auto file = miopen::TempFile{"miopen.tests.db_stats"};
+    auto db         = miopen::DbTimer<miopen::PlainTextDb>{miopen::DbKinds::PerfDb, file.Path()};
+    auto values     = TestValues{};
+    const auto key  = std::string{"key"};
+    db.Update(key, "id", TestValues{42});
+    EXPECT_TRUE(db.Load(key, "id", values));
+
+    ASSERT_EQ(miopenGetDbStats(miopenDbKindPerfDb, &stats), miopenStatusSuccess);
+    EXPECT_EQ(stats.lookups, 1);
+    EXPECT_EQ(stats.hits, 1);
+    EXPECT_EQ(stats.misses, 0);
+    EXPECT_EQ(stats.stores, 1);
+    EXPECT_EQ(stats.bytesRead, std::string{"key=id:42"}.size());
+
+    EXPECT_EQ(miopenGetDbStats(static_cast<miopenDbKind_t>(42), &stats), miopenStatusBadParm);
+    EXPECT_EQ(miopenGetDbStats(miopenDbKindPerfDb, nullptr), miopenStatusBadParm);
+}
+
+TEST(DbStats, Json)
+{
+    const auto json = nlohmann::json::parse(miopen::DbStats::ToJson());
+
+    for(const auto& kind :
+        {"FindDb", "PerfDb", "KernelDb", "AnyRamDb", "InvokerCache", "KernelCache"})
+    {
+        ASSERT_TRUE(json.contains(kind)) << kind;
+        const auto& stats = json[kind];
+        EXPECT_EQ(stats["lookups"].get<std::uint64_t>(),
+                  stats["hits"].get<std::uint64_t>() + stats["misses"].get<std::uint64_t>());
+        EXPECT_TRUE(stats["lookup_latency"].is_array());
+        EXPECT_TRUE(stats["evictions"].is_number_unsigned());
+        EXPECT_TRUE(stats["resident_bytes"].is_number_integer());
+    }
+}
+
+TEST(DbStats, ResidentBytes)
+{
+    auto& stats    = miopen::DbStats::Get(miopen::DbStats::Kind::AnyRamDb);
+    const auto old = stats.GetSnapshot().resident_bytes;
+
+    {
+        auto resident = miopen::DbResidentBytes{miopen::DbStats::Kind::AnyRamDb};
+        resident.Add(100);
+        resident.Add(-40);
+        EXPECT_EQ(resident.Get(), 60);
+        EXPECT_EQ(stats.GetSnapshot().resident_bytes - old, 60);
+    }
+
+    EXPECT_EQ(stats.GetSnapshot().resident_bytes, old);
+}
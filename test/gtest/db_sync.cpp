@@ -595,16 +595,17 @@ TEST(DBSync, DISABLED_DynamicFDBSync)
     const auto& find_db =
         miopen::ReadonlyRamDb::GetCached(miopen::DbKinds::FindDb, fdb_file_path.string(), true);
     // assert that find_db.cache is not empty, since that indicates the file was not readable
-    ASSERT_TRUE(!find_db.GetCacheMap().empty()) << "Find DB does not have any entries";
+    ASSERT_TRUE(!find_db.GetCacheItems().empty()) << "Find DB does not have any entries";
 
     auto _ctx = miopen::ExecutionContext{};
     _ctx.SetStream(&handle);
 
-    // Convert the map to a vector
-    std::vector<std::pair<std::string, miopen::ReadonlyRamDb::CacheItem>> fdb_data;
-    const auto& find_db_map = find_db.GetCacheMap();
-    fdb_data.resize(find_db_map.size());
-    std::copy(find_db_map.begin(), find_db_map.end(), fdb_data.begin());
+    // Copy the keys out of the db
+    std::vector<FDBLine> fdb_data;
+    const auto& find_db_items = find_db.GetCacheItems();
+    fdb_data.reserve(find_db_items.size());
+    for(const auto& item : find_db_items)
+        fdb_data.emplace_back(std::string{item.key}, item);
     std::atomic<size_t> counter = 0;
     const int total_threads = std::min(static_cast<int>(std::thread::hardware_concurrency()), 32);
     std::vector<std::thread> agents;
@@ -654,7 +655,7 @@ void CheckFDBEntry(size_t thread_index,
 
         std::vector<miopen::FDBVal> fdb_vals;
         std::unordered_map<std::string, std::string> pdb_vals;
-        miopen::ParseFDBbVal(kinder.second.content, fdb_vals);
+        miopen::ParseFDBbVal(std::string{kinder.second.contents}, fdb_vals);
         std::string pdb_select_query;
         miopen::GetPerfDbVals(pdb_file_path, problem, pdb_vals, pdb_select_query);
         // This is an opportunity to link up fdb and pdb entries
@@ -818,15 +819,16 @@ void StaticFDBSync(const std::string& arch, const size_t num_cu)
     const auto& find_db =
         miopen::ReadonlyRamDb::GetCached(miopen::DbKinds::FindDb, fdb_file_path.string(), true);
     // assert that find_db.cache is not empty, since that indicates the file was not readable
-    ASSERT_TRUE(!find_db.GetCacheMap().empty()) << "Find DB does not have any entries";
+    ASSERT_TRUE(!find_db.GetCacheItems().empty()) << "Find DB does not have any entries";
     auto _ctx = miopen::ExecutionContext{};
     _ctx.SetStream(&handle);
 
-    // Convert the map to a vector
-    std::vector<std::pair<std::string, miopen::ReadonlyRamDb::CacheItem>> fdb_data;
-    const auto& find_db_map = find_db.GetCacheMap();
-    fdb_data.resize(find_db_map.size());
-    std::copy(find_db_map.begin(), find_db_map.end(), fdb_data.begin());
+    // Copy the keys out of the db
+    std::vector<FDBLine> fdb_data;
+    const auto& find_db_items = find_db.GetCacheItems();
+    fdb_data.reserve(find_db_items.size());
+    for(const auto& item : find_db_items)
+        fdb_data.emplace_back(std::string{item.key}, item);
     std::atomic<size_t> counter = 0;
     const int total_threads =
         std::min(std::thread::hardware_concurrency(), static_cast<unsigned int>(32));
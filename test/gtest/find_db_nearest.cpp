@@ -0,0 +1,107 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/find_db_nearest.hpp>
+
+namespace {
+
+constexpr auto Batch           = miopen::FindDbNearestMode::Batch;
+constexpr auto BatchAndSpatial = miopen::FindDbNearestMode::BatchAndSpatial;
+
+std::string Key2d(int n, int h, int w)
+{
+    const auto out_h = std::to_string(h - 2);
+    const auto out_w = std::to_string(w - 2);
+    return "64-" + std::to_string(h) + "-" + std::to_string(w) + "-3x3-128-" + out_h + "-" + out_w +
+           "-" + std::to_string(n) + "-0x0-1x1-1x1-0-NCHW-FP32-F";
+}
+
+} // namespace
+
+TEST(FindDbNearest, ParseKeys)
+{
+    const auto shape = miopen::FindDbKeyShape::Parse(Key2d(16, 28, 30), Batch);
+    ASSERT_TRUE(shape);
+    EXPECT_EQ(shape->batch, 16);
+    EXPECT_EQ(shape->spatial, 1);
+    EXPECT_EQ(shape->masked, "64-28-30-3x3-128-26-28-*-0x0-1x1-1x1-0-NCHW-FP32-F");
+
+    const auto spatial = miopen::FindDbKeyShape::Parse(Key2d(16, 28, 30), BatchAndSpatial);
+    ASSERT_TRUE(spatial);
+    EXPECT_EQ(spatial->spatial, 28 * 30);
+    EXPECT_EQ(spatial->masked, "64-*-*-3x3-128-*-*-*-0x0-1x1-1x1-0-NCHW-FP32-F");
+
+    const auto key_3d   = "64-8-28-30-3x3x3-128-6-26-28-4-0x0x0-1x1x1-1x1x1-0-NCDHW-FP32-W_g2";
+    const auto shape_3d = miopen::FindDbKeyShape::Parse(key_3d, BatchAndSpatial);
+    ASSERT_TRUE(shape_3d);
+    EXPECT_EQ(shape_3d->batch, 4);
+    EXPECT_EQ(shape_3d->spatial, 8 * 28 * 30);
+    EXPECT_EQ(shape_3d->masked, "64-*-*-*-3x3x3-128-*-*-*-*-0x0x0-1x1x1-1x1x1-0-NCDHW-FP32-W_g2");
+
+    EXPECT_FALSE(
+        miopen::FindDbKeyShape::Parse(Key2d(16, 28, 30), miopen::FindDbNearestMode::Disabled));
+    EXPECT_FALSE(miopen::FindDbKeyShape::Parse("64-28-28-3x3-128-26-26", Batch));
+    EXPECT_FALSE(miopen::FindDbKeyShape::Parse("64-28-28-3x3-128-26-26-N-0x0-1x1-1x1-0", Batch));
+    EXPECT_FALSE(miopen::FindDbKeyShape::Parse("ConvOclDirectFwd", Batch));
+}
+
+TEST(FindDbNearest, FindsClosestBatch)
+{
+    auto index = miopen::FindDbNeighbours{Batch};
+    for(const auto n : {1, 8, 32, 128})
+        index.Add(Key2d(n, 28, 28));
+    index.Add(Key2d(16, 56, 56));
+
+    const auto find = [&](int n, int h) {
+        const auto shape = miopen::FindDbKeyShape::Parse(Key2d(n, h, h), Batch);
+        const auto match = index.FindNearest(*shape);
+        return match ? match->key : std::string{};
+    };
+
+    EXPECT_EQ(find(1, 28), Key2d(1, 28, 28));
+    EXPECT_EQ(find(6, 28), Key2d(8, 28, 28));
+    EXPECT_EQ(find(16, 28), Key2d(32, 28, 28)); // The larger one on a tie.
+    EXPECT_EQ(find(1000, 28), Key2d(128, 28, 28));
+    EXPECT_EQ(find(2, 56), Key2d(16, 56, 56));
+    EXPECT_EQ(find(16, 14), "");
+}
+
+TEST(FindDbNearest, FindsClosestSpatialSize)
+{
+    auto index = miopen::FindDbNeighbours{BatchAndSpatial};
+    index.Add(Key2d(8, 28, 28));
+    index.Add(Key2d(8, 224, 224));
+
+    const auto find = [&](int n, int h) {
+        const auto shape = miopen::FindDbKeyShape::Parse(Key2d(n, h, h), BatchAndSpatial);
+        const auto match = index.FindNearest(*shape);
+        return match ? match->key : std::string{};
+    };
+
+    EXPECT_EQ(find(8, 32), Key2d(8, 28, 28));
+    EXPECT_EQ(find(4, 200), Key2d(8, 224, 224));
+}
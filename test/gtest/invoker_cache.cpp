@@ -0,0 +1,246 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/env.hpp>
+#include <miopen/find_db.hpp>
+#include <miopen/invoker_cache.hpp>
+#include <miopen/miopen.h>
+
+#include "platform.hpp"
+#include "../workspace.hpp"
+
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace {
+
+/// Bounds the invoker caches of the handles created while it exists.
+struct InvokerCacheLimitLock
+{
+    explicit InvokerCacheLimitLock(uint64_t limit)
+        : old_limit(miopen::Value(ENV(MIOPEN_INVOKER_CACHE_LIMIT)))
+    {
+        miopen::UpdateEnvVar(ENV(MIOPEN_INVOKER_CACHE_LIMIT), limit);
+    }
+
+    ~InvokerCacheLimitLock() { miopen::UpdateEnvVar(ENV(MIOPEN_INVOKER_CACHE_LIMIT), old_limit); }
+
+    InvokerCacheLimitLock(const InvokerCacheLimitLock&) = delete;
+    InvokerCacheLimitLock& operator=(const InvokerCacheLimitLock&) = delete;
+
+private:
+    uint64_t old_limit;
+};
+
+struct FindDbDisabledLock
+{
+    FindDbDisabledLock() : was_disabled(miopen::IsEnabled(ENV(MIOPEN_DEBUG_DISABLE_FIND_DB)))
+    {
+        miopen::UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_FIND_DB), true);
+    }
+
+    ~FindDbDisabledLock() { miopen::UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_FIND_DB), was_disabled); }
+
+    FindDbDisabledLock(const FindDbDisabledLock&) = delete;
+    FindDbDisabledLock& operator=(const FindDbDisabledLock&) = delete;
+
+private:
+    bool was_disabled;
+};
+
+void NoOp(const miopen::Handle&, const miopen::AnyInvokeParams&) {}
+
+/// A forward convolution with NCHW float tensors and the buffers to run it.
+class Convolution
+{
+public:
+    Convolution(miopenHandle_t handle_, int channels_)
+        : handle(handle_),
+          channels(channels_),
+          device(handle_),
+          in(device.Malloc(GetInSize() * sizeof(float))),
+          wei(device.Malloc(GetWeiSize() * sizeof(float))),
+          out(device.Malloc(GetInSize() * sizeof(float)))
+    {
+        const auto in_dims  = std::array<int, 4>{1, channels, 8, 8};
+        const auto wei_dims = std::array<int, 4>{channels, channels, 1, 1};
+
+        EXPECT_EQ(miopenCreateTensorDescriptor(&in_desc), miopenStatusSuccess);
+        EXPECT_EQ(miopenSetTensorDescriptor(in_desc, miopenFloat, 4, in_dims.data(), nullptr),
+                  miopenStatusSuccess);
+        EXPECT_EQ(miopenCreateTensorDescriptor(&wei_desc), miopenStatusSuccess);
+        EXPECT_EQ(miopenSetTensorDescriptor(wei_desc, miopenFloat, 4, wei_dims.data(), nullptr),
+                  miopenStatusSuccess);
+        EXPECT_EQ(miopenCreateTensorDescriptor(&out_desc), miopenStatusSuccess);
+        EXPECT_EQ(miopenSetTensorDescriptor(out_desc, miopenFloat, 4, in_dims.data(), nullptr),
+                  miopenStatusSuccess);
+        EXPECT_EQ(miopenCreateConvolutionDescriptor(&conv_desc), miopenStatusSuccess);
+        EXPECT_EQ(miopenInitConvolutionDescriptor(conv_desc, miopenConvolution, 0, 0, 1, 1, 1, 1),
+                  miopenStatusSuccess);
+
+        auto ws_size = std::size_t{0};
+        EXPECT_EQ(miopenConvolutionForwardGetWorkSpaceSize(
+                      handle, wei_desc, in_desc, conv_desc, out_desc, &ws_size),
+                  miopenStatusSuccess);
+        workspace.resize(ws_size);
+
+        const auto in_data  = std::vector<float>(GetInSize(), 1.f);
+        const auto wei_data = std::vector<float>(GetWeiSize(), 1.f);
+        EXPECT_TRUE(in.CopyToDevice(in_data.data(), in_data.size() * sizeof(float)));
+        EXPECT_TRUE(wei.CopyToDevice(wei_data.data(), wei_data.size() * sizeof(float)));
+    }
+
+    ~Convolution()
+    {
+        miopenDestroyConvolutionDescriptor(conv_desc);
+        miopenDestroyTensorDescriptor(out_desc);
+        miopenDestroyTensorDescriptor(wei_desc);
+        miopenDestroyTensorDescriptor(in_desc);
+    }
+
+    Convolution(const Convolution&) = delete;
+    Convolution& operator=(const Convolution&) = delete;
+
+    miopenConvFwdAlgorithm_t Find()
+    {
+        auto perf  = miopenConvAlgoPerf_t{};
+        auto count = 0;
+        EXPECT_EQ(miopenFindConvolutionForwardAlgorithm(handle,
+                                                        in_desc,
+                                                        in.Data(),
+                                                        wei_desc,
+                                                        wei.Data(),
+                                                        conv_desc,
+                                                        out_desc,
+                                                        out.Data(),
+                                                        1,
+                                                        &count,
+                                                        &perf,
+                                                        workspace.ptr(),
+                                                        workspace.size(),
+                                                        false),
+                  miopenStatusSuccess);
+        EXPECT_EQ(count, 1);
+        return perf.fwd_algo;
+    }
+
+    miopenStatus_t Run(miopenConvFwdAlgorithm_t algo)
+    {
+        const auto alpha = 1.f;
+        const auto beta  = 0.f;
+        const auto ret   = miopenConvolutionForward(handle,
+                                                  &alpha,
+                                                  in_desc,
+                                                  in.Data(),
+                                                  wei_desc,
+                                                  wei.Data(),
+                                                  conv_desc,
+                                                  algo,
+                                                  &beta,
+                                                  out_desc,
+                                                  out.Data(),
+                                                  workspace.ptr(),
+                                                  workspace.size());
+        EXPECT_TRUE(device.Synchronize());
+        return ret;
+    }
+
+private:
+    miopenHandle_t handle;
+    int channels;
+    Device device;
+    DevMem in;
+    DevMem wei;
+    DevMem out;
+    Workspace workspace{};
+    miopenTensorDescriptor_t in_desc        = nullptr;
+    miopenTensorDescriptor_t wei_desc       = nullptr;
+    miopenTensorDescriptor_t out_desc       = nullptr;
+    miopenConvolutionDescriptor_t conv_desc = nullptr;
+
+    std::size_t GetInSize() const { return static_cast<std::size_t>(channels) * 8 * 8; }
+    std::size_t GetWeiSize() const { return static_cast<std::size_t>(channels) * channels; }
+};
+
+} // namespace
+
+TEST(InvokerCache, KeepsFound1_0OfEvictedConfigs)
+{
+    const auto limit = InvokerCacheLimitLock{1};
+    auto cache       = miopen::InvokerCache{};
+
+    cache.Register({"config1", "solver1"}, NoOp);
+    cache.SetAsFound1_0("config1", "algorithm", "solver1");
+    cache.Register({"config2", "solver2"}, NoOp);
+    cache.Register({"config3", "solver3"}, NoOp);
+
+    EXPECT_FALSE(cache[std::make_pair("config1", "solver1")]);
+    EXPECT_FALSE(cache.GetFound1_0("config1", "algorithm"));
+    const auto solver_id = cache.GetFound1_0SolverId("config1", "algorithm");
+    ASSERT_TRUE(solver_id);
+    EXPECT_EQ(*solver_id, "solver1");
+    EXPECT_FALSE(cache.GetFound1_0SolverId("config1", "other"));
+    EXPECT_FALSE(cache.GetFound1_0SolverId("config2", "algorithm"));
+
+    // The restored invoker is found again, and so is the result of a later find.
+    cache.Register({"config1", "solver1"}, NoOp);
+    cache.SetAsFound1_0("config1", "algorithm", "solver1");
+    EXPECT_TRUE(cache.GetFound1_0("config1", "algorithm"));
+}
+
+TEST(InvokerCache, Found1_0InvokerIsRestoredWithoutFindDb)
+{
+    const auto limit   = InvokerCacheLimitLock{1};
+    const auto find_db = FindDbDisabledLock{};
+
+    auto handle = miopenHandle_t{};
+    ASSERT_EQ(miopenCreate(&handle), miopenStatusSuccess);
+
+    {
+        auto first  = Convolution{handle, 8};
+        auto second = Convolution{handle, 16};
+
+        auto old_stats = miopenDbStats_t{};
+        ASSERT_EQ(miopenGetDbStats(miopenDbKindInvokerCache, &old_stats), miopenStatusSuccess);
+
+        const auto first_algo = first.Find();
+        // Evicts the invokers of the first convolution.
+        const auto second_algo = second.Find();
+
+        auto stats = miopenDbStats_t{};
+        ASSERT_EQ(miopenGetDbStats(miopenDbKindInvokerCache, &stats), miopenStatusSuccess);
+        EXPECT_GT(stats.evictions, old_stats.evictions);
+
+        EXPECT_EQ(first.Run(first_algo), miopenStatusSuccess);
+        EXPECT_EQ(second.Run(second_algo), miopenStatusSuccess);
+    }
+
+    EXPECT_EQ(miopenDestroy(handle), miopenStatusSuccess);
+}
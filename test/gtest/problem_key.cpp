@@ -0,0 +1,137 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/db_record.hpp>
+#include <miopen/env.hpp>
+#include <miopen/problem_key.hpp>
+
+#include <sstream>
+#include <string>
+
+MIOPEN_DECLARE_ENV_VAR_BOOL(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE)
+
+namespace {
+
+miopen::conv::ProblemDescription MakeProblem(int pad, miopen::conv::Direction direction)
+{
+    const auto in   = miopen::TensorDescriptor{miopenHalf, {16, 64, 28, 28}};
+    const auto wei  = miopen::TensorDescriptor{miopenHalf, {128, 64, 3, 3}};
+    const auto out  = miopen::TensorDescriptor{miopenHalf, {16, 128, 26 + 2 * pad, 26 + 2 * pad}};
+    const auto conv = miopen::ConvolutionDescriptor{{pad, pad}, {1, 1}, {1, 1}};
+    return {direction == miopen::conv::Direction::Forward ? in : out,
+            wei,
+            direction == miopen::conv::Direction::Forward ? out : in,
+            conv,
+            direction};
+}
+
+struct Texts
+{
+    std::string network_config;
+    std::string find_db_key;
+    std::string perf_db_key;
+
+    explicit Texts(const miopen::conv::ProblemDescription& problem)
+        : network_config(problem.MakeNetworkConfig().ToString()),
+          find_db_key(miopen::DbRecord{miopen::DbKinds::FindDb, problem}.GetKey()),
+          perf_db_key(miopen::DbRecord{miopen::DbKinds::PerfDb, problem}.GetKey())
+    {
+    }
+
+    friend bool operator==(const Texts& left, const Texts& right)
+    {
+        return left.network_config == right.network_config &&
+               left.find_db_key == right.find_db_key && left.perf_db_key == right.perf_db_key;
+    }
+};
+
+} // namespace
+
+TEST(ProblemKey, Equality)
+{
+    const auto make = [](std::uint64_t value, std::string_view layout) {
+        return miopen::ProblemKey{1}.Add(value).Add(layout);
+    };
+
+    EXPECT_EQ(make(2, "NCHW"), make(2, "NCHW"));
+    EXPECT_EQ(make(2, "NCHW").GetHash(), make(2, "NCHW").GetHash());
+    EXPECT_NE(make(2, "NCHW"), make(3, "NCHW"));
+    EXPECT_NE(make(2, "NCHW").GetHash(), make(3, "NCHW").GetHash());
+    EXPECT_NE(make(2, "NCHW"), make(2, "NHWC"));
+    EXPECT_NE(make(2, "NCHW"), make(2, "NCHWNCHW"));
+    EXPECT_NE(miopen::ProblemKey{1}.Add(2), miopen::ProblemKey{2}.Add(2));
+}
+
+TEST(ProblemKey, TextCacheBuildsOnce)
+{
+    auto& cache = miopen::ProblemTextCache::Get(miopen::ProblemTextCache::Form::NetworkConfig);
+    auto builds = 0;
+    const auto build = [&]() {
+        ++builds;
+        return std::string{"text"};
+    };
+    const auto key = miopen::ProblemKey{0}.Add(1);
+
+    EXPECT_EQ(cache.GetOrBuild(key, build), "text");
+    EXPECT_EQ(cache.GetOrBuild(key, build), "text");
+    EXPECT_EQ(builds, 1);
+
+    miopen::UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE), true);
+    EXPECT_EQ(cache.GetOrBuild(key, build), "text");
+    EXPECT_EQ(builds, 2);
+    miopen::UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE), false);
+}
+
+TEST(ProblemKey, ConvTextsMatchUncached)
+{
+    for(const auto pad : {0, 1})
+    {
+        for(const auto direction :
+            {miopen::conv::Direction::Forward, miopen::conv::Direction::BackwardData})
+        {
+            const auto problem = MakeProblem(pad, direction);
+
+            miopen::UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE), true);
+            const auto uncached = Texts{problem};
+            miopen::UpdateEnvVar(ENV(MIOPEN_DEBUG_DISABLE_PROBLEM_TEXT_CACHE), false);
+
+            // The first call fills the cache, the second one uses it.
+            EXPECT_TRUE(Texts{problem} == uncached);
+            EXPECT_TRUE(Texts{problem} == uncached);
+
+            auto serialized = std::ostringstream{};
+            problem.Serialize(serialized);
+            EXPECT_EQ(serialized.str(), uncached.find_db_key);
+        }
+    }
+
+    EXPECT_NE(MakeProblem(0, miopen::conv::Direction::Forward).MakeKey(),
+              MakeProblem(1, miopen::conv::Direction::Forward).MakeKey());
+    EXPECT_NE(MakeProblem(0, miopen::conv::Direction::Forward).MakeKey(),
+              MakeProblem(0, miopen::conv::Direction::BackwardData).MakeKey());
+}
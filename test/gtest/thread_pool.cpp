@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/par_for.hpp>
+#include <miopen/thread_pool.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(ThreadPool, CallsEachIndexOnce)
+{
+    constexpr std::size_t n = 10007;
+    auto calls              = std::vector<std::atomic<int>>(n);
+
+    miopen::par_for(n, [&](std::size_t i) { ++calls[i]; });
+
+    EXPECT_TRUE(std::all_of(calls.begin(), calls.end(), [](auto& c) { return c == 1; }));
+}
+
+TEST(ThreadPool, ReusesWorkers)
+{
+    auto sum = std::atomic<std::size_t>{0};
+    miopen::par_for(1000, miopen::max_threads{4}, [&](std::size_t i) { sum += i; });
+    const auto workers = miopen::ThreadPool::Get().GetWorkerCount();
+
+    for(auto repeat = 0; repeat < 100; ++repeat)
+        miopen::par_for(1000, miopen::max_threads{4}, [&](std::size_t i) { sum += i; });
+
+    EXPECT_EQ(sum, 101 * 999 * 1000 / 2);
+    EXPECT_EQ(miopen::ThreadPool::Get().GetWorkerCount(), workers);
+}
+
+TEST(ThreadPool, LimitsConcurrency)
+{
+    auto running     = std::atomic<int>{0};
+    auto max_running = std::atomic<int>{0};
+
+    miopen::par_for_strided(64, miopen::max_threads{2}, [&](std::size_t) {
+        const auto now = ++running;
+        auto max       = max_running.load();
+        while(now > max && !max_running.compare_exchange_weak(max, now)) {}
+        std::this_thread::sleep_for(std::chrono::microseconds{100});
+        --running;
+    });
+
+    EXPECT_LE(max_running, 2);
+}
+
+TEST(ThreadPool, RunsNestedLoops)
+{
+    constexpr std::size_t n = 64;
+    auto calls              = std::vector<std::atomic<int>>(n * n);
+
+    miopen::par_for(n, miopen::min_grain{1}, [&](std::size_t i) {
+        miopen::par_for(n, miopen::min_grain{1}, [&](std::size_t j) { ++calls[i * n + j]; });
+    });
+
+    EXPECT_TRUE(std::all_of(calls.begin(), calls.end(), [](auto& c) { return c == 1; }));
+}
+
+TEST(ThreadPool, RethrowsAndSkipsTheRest)
+{
+    constexpr std::size_t n = 1000;
+    auto calls              = std::atomic<std::size_t>{0};
+
+    const auto loop = [&]() {
+        miopen::ThreadPool::Get().ParallelFor(n, 4, 1, [&](std::size_t i) {
+            ++calls;
+            if(i == 0)
+                throw std::runtime_error("failure");
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        });
+    };
+
+    EXPECT_THROW(loop(), std::runtime_error);
+    EXPECT_LT(calls, n);
+}
+
+TEST(ThreadPool, StopsOnCancellation)
+{
+    constexpr std::size_t n = 1000;
+    auto calls              = std::atomic<std::size_t>{0};
+    auto token              = miopen::CancellationToken{};
+
+    miopen::ThreadPool::Get().ParallelFor(
+        n,
+        4,
+        1,
+        [&](std::size_t i) {
+            ++calls;
+            if(i == 0)
+                token.Cancel();
+            std::this_thread::sleep_for(std::chrono::microseconds{100});
+        },
+        &token);
+
+    EXPECT_LT(calls, n);
+}
@@ -0,0 +1,126 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#include <gtest/gtest.h>
+
+#include <miopen/conv/problem_description.hpp>
+#include <miopen/driver_arguments.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/warmup.hpp>
+
+#include "get_handle.hpp"
+
+#include <sstream>
+#include <string>
+
+namespace {
+
+std::string ToDriverArgs(const miopen::Problem& problem)
+{
+    const auto& conv = boost::get<miopen::ConvolutionDescriptor>(problem.GetOperatorDescriptor());
+    return miopen::debug::ConvArgsForMIOpenDriver(
+        problem.GetTensorDescriptor(miopenTensorConvolutionX, {}),
+        problem.GetTensorDescriptor(miopenTensorConvolutionW, {}),
+        conv,
+        problem.GetTensorDescriptor(miopenTensorConvolutionY, {}),
+        problem.GetDirection(),
+        std::nullopt);
+}
+
+} // namespace
+
+TEST(WarmUp, ParsesDriverArgs)
+{
+    const std::string commands[] = {
+        "conv -n 16 -c 64 -H 28 -W 30 -k 128 -y 3 -x 3 -p 1 -q 0 -u 2 -v 1 -l 1 -j 2 -m conv "
+        "-g 1 -F 1 -t 1",
+        "convfp16 -n 4 -c 32 -H 14 -W 14 -k 32 -y 1 -x 1 -p 0 -q 0 -u 1 -v 1 -l 1 -j 1 "
+        "--in_layout NHWC --fil_layout NHWC --out_layout NHWC -m conv -g 4 -F 2 -t 1",
+        "convbfp16 -n 2 -c 8 --in_d 4 -H 10 -W 12 -k 16 --fil_d 3 -y 3 -x 3 --pad_d 1 -p 1 -q 1 "
+        "--conv_stride_d 1 -u 1 -v 1 --dilation_d 1 -l 1 -j 1 --spatial_dim 3 -m trans -g 1 -F 4 "
+        "-t 1",
+    };
+
+    for(const auto& command : commands)
+    {
+        const auto problems = miopen::debug::ParseConvDriverArgs(command);
+        ASSERT_EQ(problems.size(), 1) << command;
+        EXPECT_EQ(ToDriverArgs(problems.front()), command);
+    }
+}
+
+TEST(WarmUp, ReadsDriverCommands)
+{
+    auto commands = std::istringstream{
+        "MIOpen(HIP): Command [LogCmdConvolution] ./bin/MIOpenDriver conv -n 1 -c 3 -H 8 -W 8 "
+        "-k 4 -y 3 -x 3 -F 0\n"
+        "MIOpen(HIP): Command [LogCmdBNorm] ./bin/MIOpenDriver bnorm -n 1 -c 3 -H 8 -W 8\n"
+        "\n"
+        "./bin/MIOpenDriver conv -n one -c 3 -H 8 -W 8 -k 4 -y 3 -x 3 -F 1\n"
+        "./bin/MIOpenDriver conv -n 1 -c 3 -H 8 -W 8 -k 4 -y 3 -x 3 --spatial_dim 4\n"
+        "./bin/MIOpenDriver conv -n 1 -c 3 -H 8 -W 8 -k 4 -y 3 -x 3 -F 5\n"};
+
+    const auto problems = miopen::ReadDriverCommands(commands);
+    ASSERT_EQ(problems.size(), 5);
+    EXPECT_EQ(problems[0].GetDirection(), miopenProblemDirectionForward);
+    EXPECT_EQ(problems[1].GetDirection(), miopenProblemDirectionBackward);
+    EXPECT_EQ(problems[2].GetDirection(), miopenProblemDirectionBackwardWeights);
+    EXPECT_EQ(problems[3].GetDirection(), miopenProblemDirectionForward);
+    EXPECT_EQ(problems[4].GetDirection(), miopenProblemDirectionBackwardWeights);
+}
+
+TEST(WarmUp, PreparesInvokers)
+{
+    auto&& handle = get_handle();
+    const auto problems =
+        miopen::debug::ParseConvDriverArgs("conv -n 2 -c 16 -H 14 -W 14 -k 16 -y 1 -x 1 -F 1");
+    ASSERT_EQ(problems.size(), 1);
+
+    const auto stats = miopen::WarmUp(handle, problems);
+    EXPECT_EQ(stats.problems, 1);
+    EXPECT_EQ(stats.warmed, 1);
+
+    const auto problem  = problems.front().AsConvolution();
+    auto ctx            = miopen::ExecutionContext{&handle};
+    const auto solution = problem.GetConv().GetSolutions(ctx, problem, 1, nullptr);
+    ASSERT_FALSE(solution.empty());
+    EXPECT_TRUE(handle.GetInvoker(problem.MakeNetworkConfig(),
+                                  miopen::solver::Id{solution.front().solution_id}));
+}
+
+TEST(WarmUp, CollectsKernels)
+{
+    auto&& handle = get_handle();
+    auto problems =
+        miopen::debug::ParseConvDriverArgs("conv -n 2 -c 16 -H 14 -W 14 -k 16 -y 3 -x 3 -F 1");
+    ASSERT_EQ(problems.size(), 1);
+
+    const auto kernels = miopen::CollectKernels(handle, problems);
+    EXPECT_FALSE(kernels.empty());
+
+    // The kernels of the same problem are not collected twice.
+    problems.push_back(problems.front());
+    EXPECT_EQ(miopen::CollectKernels(handle, problems).size(), kernels.size());
+}
@@ -51,6 +51,27 @@ struct KBPTestDriver : test_driver
             "-Wa,-defsym,DefineWithValue=0 -TrivialOption -OptionWithValue 0 -Wa,-defsym,Shifted "
             "-Wa,-defsym,DefineDefine "
             "-Wa,-defsym,DefineDefineWithValue=1");
+
+        // The order of the defines and the whitespace do not matter.
+        const auto canonical = KernelBuildParameters::Canonicalize(
+            "  -mcpu=gfx90a -DB=1  -DA -OptionWithValue 0 -D C=2 -mcpu=gfx90a");
+        EXPECT_EQUAL(canonical, "-mcpu=gfx90a -OptionWithValue 0 -mcpu=gfx90a -DA -DB=1 -DC=2");
+        EXPECT_EQUAL(KernelBuildParameters::Canonicalize(
+                         "-mcpu=gfx90a -DA -DC=2 -OptionWithValue 0 -DB=1 -mcpu=gfx90a"),
+                     canonical);
+        EXPECT_EQUAL(KernelBuildParameters::Canonicalize(canonical), canonical);
+
+        // The redefinitions keep their order, since the last one is in effect.
+        EXPECT_EQUAL(KernelBuildParameters::Canonicalize("-DB=1 -DA=1 -UA -DA=2"),
+                     "-DA=1 -UA -DA=2 -DB=1");
+        EXPECT_EQUAL(KernelBuildParameters::Canonicalize(
+                         "-Wa,-defsym,Y=1 -Wa,-defsym,X=0 -mcumode"),
+                     "-mcumode -Wa,-defsym,X=0 -Wa,-defsym,Y=1");
+
+        // The quoted values are not split.
+        EXPECT_EQUAL(KernelBuildParameters::Canonicalize(" -DB=\"b  c\" -DA "),
+                     "-DB=\"b  c\" -DA");
+        EXPECT_EQUAL(KernelBuildParameters::Canonicalize(""), "");
     }
 };
 } // namespace tests
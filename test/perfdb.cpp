@@ -30,6 +30,7 @@
 #include <miopen/filesystem.hpp>
 #include <miopen/db.hpp>
 #include <miopen/db_record.hpp>
+#include <miopen/db_write_queue.hpp>
 #include <miopen/lock_file.hpp>
 #include <miopen/process.hpp>
 #include <miopen/ramdb.hpp>
@@ -39,6 +40,9 @@
 #include <boost/optional.hpp>
 
 #include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
@@ -90,6 +94,76 @@ static bool& full_set()
     return full_set;
 }
 
+/// Journal size limit of the user db journal mode, zero if the mode is disabled.
+static uint64_t& journal_limit()
+{
+    // NOLINTNEXTLINE (cppcoreguidelines-avoid-non-const-global-variables)
+    static uint64_t journal_limit = 0;
+    return journal_limit;
+}
+
+struct UserDbJournalLock
+{
+    UserDbJournalLock(uint64_t limit) : cached(journal_limit()) { Enable(limit); }
+    ~UserDbJournalLock() { Enable(cached); }
+
+    static void Enable(uint64_t limit)
+    {
+        journal_limit() = limit;
+
+        if(limit == 0)
+        {
+            Unset(ENV(MIOPEN_DEBUG_USER_DB_JOURNAL));
+            return;
+        }
+
+        UpdateEnvVar(ENV(MIOPEN_DEBUG_USER_DB_JOURNAL), true);
+        UpdateEnvVar(ENV(MIOPEN_DEBUG_USER_DB_JOURNAL_LIMIT), limit);
+    }
+
+private:
+    uint64_t cached;
+};
+
+struct UserDbWriteBehindLock
+{
+    UserDbWriteBehindLock(uint64_t limit)
+        : cached(IsEnabled(ENV(MIOPEN_DB_WRITE_BEHIND))),
+          cached_limit(Value(ENV(MIOPEN_DB_WRITE_BEHIND_LIMIT)))
+    {
+        UpdateEnvVar(ENV(MIOPEN_DB_WRITE_BEHIND), true);
+        UpdateEnvVar(ENV(MIOPEN_DB_WRITE_BEHIND_LIMIT), limit);
+    }
+
+    ~UserDbWriteBehindLock()
+    {
+        // The following tests expect the files to be written synchronously.
+        DbWriteQueue::Get().Flush();
+
+        if(!cached)
+            Unset(ENV(MIOPEN_DB_WRITE_BEHIND));
+        UpdateEnvVar(ENV(MIOPEN_DB_WRITE_BEHIND_LIMIT), cached_limit);
+    }
+
+private:
+    bool cached;
+    uint64_t cached_limit;
+};
+
+struct RamDbRevalidationLock
+{
+    RamDbRevalidationLock(uint64_t interval_ms)
+        : cached(Value(ENV(MIOPEN_DEBUG_RAMDB_REVALIDATION_MS)))
+    {
+        UpdateEnvVar(ENV(MIOPEN_DEBUG_RAMDB_REVALIDATION_MS), interval_ms);
+    }
+
+    ~RamDbRevalidationLock() { UpdateEnvVar(ENV(MIOPEN_DEBUG_RAMDB_REVALIDATION_MS), cached); }
+
+private:
+    uint64_t cached;
+};
+
 struct ArgsHelper
 {
     static constexpr const char* logs_path_arg = "thread-logs-root";
@@ -97,6 +171,7 @@ struct ArgsHelper
     static constexpr const char* id_arg        = "mp-test-child";
     static constexpr const char* path_arg      = "mp-test-child-path";
     static constexpr const char* db_class_arg  = "mp-test-child-db-path";
+    static constexpr const char* journal_arg   = "mp-test-child-journal-limit";
 
     struct db_class
     {
@@ -586,6 +661,68 @@ public:
     }
 };
 
+template <class TDb>
+class DbBatchTest : public DbTest
+{
+public:
+    DbBatchTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          "Testing " << ArgsHelper::db_class::Get<TDb>() << " batch writes...");
+
+        const TestData stored_key(9, 10);
+        const TestData new_key(11, 12);
+
+        TDb db(DbKinds::PerfDb, temp_file);
+        EXPECT(db.Update(key(), id0(), value2()));
+        EXPECT(db.Update(stored_key, id0(), value0()));
+
+        {
+            auto batch = db.BeginBatch();
+
+            EXPECT(batch.Update(key(), id0(), value0()));
+            EXPECT(batch.Update(key(), id1(), value1()));
+            EXPECT(batch.Update(new_key, id0(), value0()));
+
+            DbRecord replacement(DbKinds::PerfDb, stored_key);
+            EXPECT(replacement.SetValues(id2(), value2()));
+            EXPECT(batch.StoreRecord(replacement));
+            EXPECT_EQUAL(batch.Size(), 4);
+
+            // Nothing is written before the commit.
+            TestData read(TestData::NoInit{});
+            EXPECT(db.Load(key(), id0(), read));
+            EXPECT_EQUAL(read, value2());
+            EXPECT(!db.FindRecord(new_key));
+
+            EXPECT(batch.Commit());
+            EXPECT_EQUAL(batch.Size(), 0);
+        }
+
+        ValidateSingleEntry(key(), common_data(), db);
+
+        {
+            TestData read(TestData::NoInit{});
+            EXPECT(!db.Load(stored_key, id0(), read));
+            EXPECT(db.Load(stored_key, id2(), read));
+            EXPECT_EQUAL(read, value2());
+        }
+
+        {
+            // Uncommitted changes are committed on destruction.
+            auto batch = db.BeginBatch();
+            EXPECT(batch.Update(new_key, id1(), value1()));
+        }
+
+        TDb other_db(DbKinds::PerfDb, temp_file);
+        ValidateSingleEntry(key(), common_data(), other_db);
+        ValidateSingleEntry(new_key, common_data(), other_db);
+    }
+};
+
 template <class TDb>
 class DbParallelTest : public DbTest
 {
@@ -1001,6 +1138,9 @@ public:
                 if(full_set())
                     args += " --all";
 
+                if(journal_limit() != 0)
+                    args += std::string{" --"} + ArgsHelper::journal_arg + " " + std::to_string(journal_limit());
+
                 children.emplace_back(exe_path(), args);
             }
             // clang-format on
@@ -1243,6 +1383,30 @@ public:
     }
 };
 
+class DbMultiFileEmptyRecordTest : public DbMultiFileTest
+{
+public:
+    DbMultiFileEmptyRecordTest(TempFile& temp_file_) : DbMultiFileTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(
+            LoggingLevel::Default, "Test", "Running multifile read test for empty records...");
+
+        // The system db keeps the first record with a key even if it has no contents.
+        std::ofstream(temp_file) << key().x << 'x' << key().y << "=\n"
+                                 << key().x << 'x' << key().y << '=' << id0() << ':'
+                                 << value0().x << 'x' << value0().y << std::endl;
+
+        const auto& sys_db = ReadonlyRamDb::GetCached(DbKinds::PerfDb, temp_file, true);
+        EXPECT_EQUAL(sys_db.GetCacheItems().size(), 1);
+        EXPECT(sys_db.GetCacheItems().front().contents.empty());
+
+        MultiFileDb<ReadonlyRamDb, RamDb, true> db(DbKinds::PerfDb, temp_file, user_db_path);
+        EXPECT(!db.FindRecord(key()));
+    }
+};
+
 class DbMultiFileOperationsTest : public DbMultiFileTest
 {
 public:
@@ -1427,6 +1591,380 @@ public:
     }
 };
 
+class DbJournalTest : public DbTest
+{
+public:
+    DbJournalTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Testing user db journal...");
+
+        const std::string db_path = temp_file;
+        const auto journal_path   = PlainTextDb::GetJournalPath(db_path);
+        auto rnd                  = Random{journal_seed};
+        auto expected             = std::vector<boost::optional<TestData>>(keys_count);
+
+        {
+            PlainTextDb db(DbKinds::PerfDb, temp_file);
+
+            for(auto i = 0u; i < keys_count; ++i)
+            {
+                expected[i] = TestData{rnd};
+                EXPECT(db.Update(std::to_string(i), id0(), *expected[i]));
+            }
+        }
+
+        const auto db_size = fs::file_size(db_path);
+
+        {
+            const UserDbJournalLock journal{std::numeric_limits<uint64_t>::max()};
+            PlainTextDb db(DbKinds::PerfDb, temp_file);
+
+            for(auto i = 0u; i < updates_count; ++i)
+            {
+                const auto n = rnd.Next() % keys_count;
+                expected[n]  = TestData{rnd};
+                EXPECT(db.Update(std::to_string(n), id0(), *expected[n]));
+
+                // The journal index is extended by each append.
+                if(i % validation_period == 0)
+                    Validate(db, expected);
+            }
+
+            EXPECT(db.RemoveRecord(std::to_string(0)));
+            expected[0] = boost::none;
+
+            // Nothing has been rewritten, yet all the changes are visible.
+            EXPECT_EQUAL(fs::file_size(db_path), db_size);
+            Validate(db, expected);
+            Validate(GetDbInstance<RamDb>(DbKinds::PerfDb, db_path, false), expected);
+
+            const auto journal_size = fs::file_size(journal_path);
+            MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                              "Test",
+                              "Bytes written by " << updates_count << " updates: " << journal_size
+                                                  << " to the journal vs ~"
+                                                  << updates_count * db_size
+                                                  << " by in-place updates");
+            EXPECT(journal_size < updates_count * db_size);
+        }
+
+        {
+            // A write in normal mode compacts the journal first.
+            PlainTextDb db(DbKinds::PerfDb, temp_file);
+            EXPECT(db.Update(std::to_string(1), id0(), *expected[1]));
+            EXPECT(!fs::exists(journal_path));
+            Validate(db, expected);
+        }
+
+        {
+            // The limit is relative to the db size then.
+            const UserDbJournalLock journal{1};
+            PlainTextDb db(DbKinds::PerfDb, temp_file);
+
+            for(auto i = 0u; i < updates_count; ++i)
+            {
+                const auto n = rnd.Next() % keys_count;
+                expected[n]  = TestData{rnd};
+                EXPECT(db.Update(std::to_string(n), id0(), *expected[n]));
+                EXPECT(!fs::exists(journal_path) ||
+                       fs::file_size(journal_path) <= fs::file_size(db_path));
+            }
+
+            Validate(db, expected);
+        }
+    }
+
+private:
+    static constexpr unsigned int keys_count        = 64;
+    static constexpr unsigned int updates_count     = 256;
+    static constexpr unsigned int validation_period = 16;
+    static constexpr unsigned int journal_seed      = 9781;
+
+    template <class TDb>
+    static void Validate(TDb& db, const std::vector<boost::optional<TestData>>& expected)
+    {
+        for(auto i = 0u; i < expected.size(); ++i)
+        {
+            TestData read(TestData::NoInit{});
+            const auto found = db.Load(std::to_string(i), id0(), read);
+
+            EXPECT_EQUAL(found, static_cast<bool>(expected[i]));
+            if(found && expected[i])
+                EXPECT_EQUAL(read, *expected[i]);
+        }
+    }
+};
+
+class DbRacyWriteTest : public DbTest
+{
+public:
+    DbRacyWriteTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default,
+                          "Test",
+                          "Testing db file index for writes keeping the file time...");
+
+        const std::string db_path = temp_file;
+        const auto written        = std::array<std::pair<const std::string, TestData>, 1>{{
+            {id0(), value0()},
+        }};
+        const auto rewritten      = std::array<std::pair<const std::string, TestData>, 1>{{
+            {id0(), value2()},
+        }};
+
+        RawWrite(db_path, key(), written);
+        PlainTextDb db{DbKinds::PerfDb, db_path};
+        ValidateSingleEntry(key(), written, db);
+
+        // Another process replaces the file with the same amount of data within the timestamp
+        // granularity.
+        const auto write_time = fs::last_write_time(db_path);
+        const auto temp_path  = db_path + ".temp";
+        RawWrite(temp_path, key(), rewritten);
+        fs::rename(temp_path, db_path);
+        fs::last_write_time(db_path, write_time);
+        ValidateSingleEntry(key(), rewritten, db);
+    }
+};
+
+class DbWriteBehindTest : public DbTest
+{
+public:
+    DbWriteBehindTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Testing user db write-behind...");
+
+        const std::string db_path = temp_file;
+
+        // Every lookup checks the file for the changes of other processes.
+        const RamDbRevalidationLock revalidation{0};
+        const UserDbWriteBehindLock write_behind{queue_limit};
+        auto& db = RamDb::GetCached(DbKinds::PerfDb, db_path, false);
+
+        auto expected = std::vector<TestData>{};
+        for(auto i = 0u; i < updates_count; ++i)
+        {
+            const auto id    = std::to_string(i % ids_count);
+            const auto value = TestData{static_cast<int>(i), static_cast<int>(i)};
+            EXPECT(db.Update(key(), id, value));
+
+            if(expected.size() < ids_count)
+                expected.push_back(value);
+            else
+                expected[i % ids_count] = value;
+
+            // The update is visible before it is written, and it is merged with the pending
+            // update of the record: one record is being written and one waits at most.
+            TestData read(TestData::NoInit{});
+            EXPECT(db.Load(key(), id, read));
+            EXPECT_EQUAL(read, value);
+            EXPECT(CountPending(db) <= 2);
+        }
+
+        // The flush returns once the file has the updates.
+        EXPECT_EQUAL(miopenFlushUserDb(), miopenStatusSuccess);
+        EXPECT_EQUAL(CountPending(db), 0);
+        ValidateFile(db_path, expected);
+
+        // An update waiting in the queue survives the reload of the cache from the file modified
+        // by another process.
+        EXPECT(db.Update(key(), id0(), value0()));
+        expected[0] = value0();
+        {
+            PlainTextDb other(DbKinds::PerfDb, db_path);
+            EXPECT(other.Update(value1(), id0(), value2()));
+        }
+        // Done by the RamDb of the other process.
+        std::ofstream{RamDb::GetTimeFilePath(db_path)}
+            << ramdb_clock::now().time_since_epoch().count();
+
+        TestData read(TestData::NoInit{});
+        EXPECT(db.Load(value1(), id0(), read));
+        EXPECT_EQUAL(read, value2());
+        EXPECT(db.Load(key(), id0(), read));
+        EXPECT_EQUAL(read, value0());
+
+        EXPECT_EQUAL(miopenFlushUserDb(), miopenStatusSuccess);
+        ValidateFile(db_path, expected);
+
+        // A writer waits while the queue is full, so the queue and the batch being written do
+        // not grow past the limit.
+        for(auto i = 0u; i < updates_count; ++i)
+        {
+            const auto problem = TestData{static_cast<int>(i), -1};
+            EXPECT(db.Update(problem, id0(), value0()));
+            EXPECT(CountPending(db) <= 2 * queue_limit);
+        }
+
+        EXPECT_EQUAL(miopenFlushUserDb(), miopenStatusSuccess);
+        PlainTextDb file_db(DbKinds::PerfDb, db_path);
+        for(auto i = 0u; i < updates_count; ++i)
+        {
+            EXPECT(file_db.Load(TestData{static_cast<int>(i), -1}, id0(), read));
+            EXPECT_EQUAL(read, value0());
+        }
+
+        // A removal is merged with the pending update of the record.
+        EXPECT(db.Update(key(), id1(), value1()));
+        EXPECT(db.Remove(key(), id0()));
+        EXPECT(!db.Load(key(), id0(), read));
+        EXPECT(db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+
+        EXPECT_EQUAL(miopenFlushUserDb(), miopenStatusSuccess);
+        EXPECT(!file_db.Load(key(), id0(), read));
+        EXPECT(file_db.Load(key(), id1(), read));
+        EXPECT_EQUAL(read, value1());
+    }
+
+private:
+    static constexpr unsigned int ids_count     = 4;
+    static constexpr unsigned int updates_count = 64;
+    static constexpr uint64_t queue_limit       = 2;
+
+    static std::size_t CountPending(const RamDb& db)
+    {
+        auto count = std::size_t{0};
+        DbWriteQueue::Get().ForEachPending(db, [&](const DbChange&) { ++count; });
+        return count;
+    }
+
+    static void ValidateFile(const std::string& db_path, const std::vector<TestData>& expected)
+    {
+        PlainTextDb file_db(DbKinds::PerfDb, db_path);
+
+        for(auto i = 0u; i < expected.size(); ++i)
+        {
+            TestData read(TestData::NoInit{});
+            EXPECT(file_db.Load(key(), std::to_string(i), read));
+            EXPECT_EQUAL(read, expected[i]);
+        }
+    }
+};
+
+class DbSnapshotTest : public DbTest
+{
+public:
+    DbSnapshotTest(TempFile& temp_file_) : DbTest(temp_file_) {}
+
+    void Run() const
+    {
+        MIOPEN_LOG_CUSTOM(LoggingLevel::Default, "Test", "Testing RamDb snapshots...");
+
+        const std::string db_path = temp_file;
+        const RamDbRevalidationLock revalidation_lock{revalidation.count()};
+        auto& db = RamDb::GetCached(DbKinds::PerfDb, db_path, false);
+
+        ConcurrentAccess(db);
+
+        // The file is checked by the first lookup after the interval, and then not until the
+        // interval passes again.
+        const auto common_key = std::to_string(0);
+        TestData read(TestData::NoInit{});
+        std::this_thread::sleep_for(revalidation);
+        const auto validation_time = std::chrono::steady_clock::now();
+        EXPECT(!db.Load(common_key, id0(), read));
+
+        DBMultiThreadedTestWork::Initialize();
+        // clang-format off
+        const auto args = std::string{"--"} + ArgsHelper::write_arg +
+                          " --" + ArgsHelper::id_arg + " 0" +
+                          " --" + ArgsHelper::path_arg + " " + db_path +
+                          " --" + ArgsHelper::db_class_arg + " " + ArgsHelper::db_class::ramdb;
+        // clang-format on
+        EXPECT_EQUAL(Process{exe_path()}(args), 0);
+
+        // The changes of another process are not seen until the next check, and are seen after it.
+        if(std::chrono::steady_clock::now() - validation_time < revalidation)
+            EXPECT(!db.Load(common_key, id0(), read));
+
+        std::this_thread::sleep_for(revalidation);
+        DBMultiThreadedTestWork::ValidateCommonPart([&]() -> RamDb& { return db; });
+    }
+
+private:
+    static constexpr unsigned int writers_count   = 4;
+    static constexpr unsigned int readers_count   = 4;
+    static constexpr unsigned int keys_per_writer = 8;
+    static constexpr unsigned int versions_count  = 16;
+    static constexpr auto revalidation            = std::chrono::milliseconds{1000};
+
+    /// Each writer stores the versions of its own records, with the version in every value, so a
+    /// record mixing two versions or going back to an older one is seen by the readers.
+    static void ConcurrentAccess(RamDb& db)
+    {
+        auto writers_done = std::atomic<bool>{false};
+        auto writers      = std::vector<std::thread>{};
+
+        for(auto w = 0u; w < writers_count; ++w)
+        {
+            writers.emplace_back([&db, w]() {
+                for(auto version = 1u; version <= versions_count; ++version)
+                {
+                    for(auto k = w * keys_per_writer; k < (w + 1) * keys_per_writer; ++k)
+                    {
+                        const auto value = TestData{static_cast<int>(version), static_cast<int>(k)};
+                        DbRecord record(DbKinds::PerfDb, TestData{static_cast<int>(k), 0});
+                        record.SetValues(id0(), value);
+                        record.SetValues(id1(), value);
+                        EXPECT(db.StoreRecord(record));
+                    }
+                }
+            });
+        }
+
+        auto readers = std::vector<std::thread>{};
+        for(auto r = 0u; r < readers_count; ++r)
+        {
+            readers.emplace_back([&db, &writers_done]() {
+                auto seen = std::vector<int>(writers_count * keys_per_writer, 0);
+
+                while(!writers_done)
+                {
+                    for(auto k = 0u; k < seen.size(); ++k)
+                    {
+                        const auto record = db.FindRecord(TestData{static_cast<int>(k), 0});
+                        if(!record)
+                        {
+                            EXPECT_EQUAL(seen[k], 0);
+                            continue;
+                        }
+
+                        TestData value0(TestData::NoInit{});
+                        TestData value1(TestData::NoInit{});
+                        EXPECT(record->GetValues(id0(), value0));
+                        EXPECT(record->GetValues(id1(), value1));
+                        EXPECT_EQUAL(value0, value1);
+                        EXPECT_EQUAL(value0.y, static_cast<int>(k));
+                        EXPECT(value0.x >= seen[k]);
+                        seen[k] = value0.x;
+                    }
+                }
+            });
+        }
+
+        for(auto& writer : writers)
+            writer.join();
+        writers_done = true;
+        for(auto& reader : readers)
+            reader.join();
+
+        // No update is lost.
+        for(auto k = 0u; k < writers_count * keys_per_writer; ++k)
+        {
+            TestData read(TestData::NoInit{});
+            EXPECT(db.Load(TestData{static_cast<int>(k), 0}, id0(), read));
+            EXPECT_EQUAL(read.x, static_cast<int>(versions_count));
+        }
+    }
+};
+
 struct PerfDbDriver : test_driver
 {
     PerfDbDriver()
@@ -1437,6 +1975,7 @@ struct PerfDbDriver : test_driver
         add(mt_child_id, ArgsHelper::id_arg);
         add(mt_child_db_path, ArgsHelper::path_arg);
         add(mt_child_db_class, ArgsHelper::db_class_arg);
+        add(mt_child_journal_limit, ArgsHelper::journal_arg);
     }
 
     void run() const
@@ -1459,6 +1998,8 @@ struct PerfDbDriver : test_driver
 
         if(mt_child_id >= 0)
         {
+            UserDbJournalLock::Enable(mt_child_journal_limit);
+
             if(mt_child_db_class == ArgsHelper::db_class::db)
             {
                 DbMultiProcessTest<PlainTextDb>::WorkItem(
@@ -1476,6 +2017,25 @@ struct PerfDbDriver : test_driver
         DbTests<RamDb>(temp_file);
         DbTests<PlainTextDb>(temp_file);
         MultiFileDbTests(temp_file);
+
+        if(!DisableUserDbFileIO)
+        {
+            TempFile journal_temp_file{"miopen.tests.perfdb.journal"};
+
+            DbJournalTest{journal_temp_file}.Run();
+            DbRacyWriteTest{temp_file}.Run();
+
+            TempFile write_behind_temp_file{"miopen.tests.perfdb.write_behind"};
+            DbWriteBehindTest{write_behind_temp_file}.Run();
+
+            TempFile snapshot_temp_file{"miopen.tests.perfdb.snapshot"};
+            DbSnapshotTest{snapshot_temp_file}.Run();
+
+            // A small limit makes the concurrent writers compact the journal often.
+            const UserDbJournalLock journal{4 * 1024};
+            DbTests<RamDb>(journal_temp_file);
+            DbTests<PlainTextDb>(journal_temp_file);
+        }
     }
 
 private:
@@ -1485,6 +2045,7 @@ private:
     int mt_child_id = -1;
     std::string mt_child_db_path;
     std::string mt_child_db_class;
+    uint64_t mt_child_journal_limit = 0;
 
     template <class TDb>
     void DbTests(TempFile& temp_file) const
@@ -1496,6 +2057,7 @@ private:
         DbReadTest<TDb>{temp_file}.Run();
         DbWriteTest<TDb>{temp_file}.Run();
         DbOperationsTest<TDb>{temp_file}.Run();
+        DbBatchTest<TDb>{temp_file}.Run();
         DbParallelTest<TDb>{temp_file}.Run();
 
         DbMultiThreadedReadTest<TDb>{temp_file}.Run();
@@ -1512,6 +2074,7 @@ private:
             DbMultiFileReadTest<false>{temp_file}.Run();
             DbMultiFileWriteTest{temp_file}.Run();
         }
+        DbMultiFileEmptyRecordTest{temp_file}.Run();
         DbMultiFileOperationsTest{temp_file}.Run();
         DbMultiFileMultiThreadedReadTest{temp_file}.Run();
         DbMultiFileMultiThreadedTest{temp_file}.Run();
@@ -40,11 +40,13 @@
 #include <boost/thread.hpp>
 
 #include <array>
+#include <chrono>
 #include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <mutex>
 #include <random>
+#include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
@@ -477,6 +479,68 @@ public:
     }
 };
 
+class DbBatchTest : public DbTest
+{
+public:
+    void Run() const
+    {
+        std::cout << "Testing db batch..." << std::endl;
+
+        ProblemData p;
+        SQLitePerfDb db(DbKinds::PerfDb, std::string(temp_file), false);
+
+        {
+            auto batch = db.BeginBatch();
+            EXPECT(batch.Update(p, id0(), value2()));
+            EXPECT(batch.Update(p, id1(), value1()));
+            EXPECT(batch.Update(p, id0(), value0()));
+            EXPECT_EQUAL(batch.Size(), 3);
+
+            // Nothing is written before the commit.
+            SolverData read;
+            EXPECT(!db.Load(p, id0(), read));
+
+            EXPECT(batch.Commit());
+            EXPECT_EQUAL(batch.Size(), 0);
+        }
+
+        ValidateSingleEntry(p, common_data(), SQLitePerfDb(DbKinds::PerfDb, temp_file, false));
+
+        {
+            auto batch = db.BeginBatch();
+            EXPECT(batch.Update(p, id0(), value2()));
+        }
+
+        SolverData read;
+        EXPECT(db.Load(p, id0(), read));
+        EXPECT_EQUAL(read, value2());
+
+        // A write made through the same connection while a batch is open waits for it, so it is
+        // not rolled back with the batch.
+        const ProblemData q(1);
+        auto writer = std::thread{};
+        auto failed = false;
+
+        try
+        {
+            db.CommitBatch({[&](SQLitePerfDb&) -> bool {
+                writer = std::thread{[&]() { db.Update(q, id1(), value1()); }};
+                std::this_thread::sleep_for(std::chrono::milliseconds{100});
+                throw std::runtime_error{"rolled back"};
+            }});
+        }
+        catch(const std::runtime_error&)
+        {
+            failed = true;
+        }
+
+        writer.join();
+        EXPECT(failed);
+        EXPECT(db.Load(q, id1(), read));
+        EXPECT_EQUAL(read, value1());
+    }
+};
+
 class DbParallelTest : public DbTest
 {
 public:
@@ -1290,6 +1354,7 @@ struct PerfDbDriver : test_driver
         }
         DbFindTest().Run();
         DbOperationsTest().Run();
+        DbBatchTest().Run();
         DbParallelTest().Run();
         DbMultiThreadedTest().Run();
         DbMultiThreadedReadTest().Run();
@@ -0,0 +1,46 @@
+#include "read_db.hpp"
+
+#include <miopen/db_binary_format.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+
+int main(int argn, char** args)
+{
+    if(argn < 2 || argn > 3)
+    {
+        std::cerr << "Usage:" << std::endl;
+        std::cerr << args[0] << " input_path [output_path]" << std::endl;
+        std::cerr << "input_path - path to the input file, expected to be a text or binary "
+                     "perf-db or find-db, or a sqlite3 perf-db."
+                  << std::endl;
+        std::cerr << "output_path - optional path to the output file. Existing file would be "
+                     "replaced. Defaults to the input_path with .bin appended to the end"
+                  << std::endl;
+        return 1;
+    }
+
+    const std::string in_filename  = args[1];
+    const std::string out_filename = argn > 2 ? args[2] : (in_filename + ".bin");
+
+    try
+    {
+        auto records = ReadDb(in_filename);
+        auto out     = std::ofstream{out_filename, std::ios::binary | std::ios::trunc};
+        miopen::binary_db::Write(std::move(records), out);
+        if(!out)
+        {
+            std::cerr << "Unable to write " << out_filename << std::endl;
+            return 1;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
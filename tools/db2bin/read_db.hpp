@@ -0,0 +1,133 @@
+/*******************************************************************************
+ *
+ * MIT License
+ *
+ * Copyright (c) 2024 Advanced Micro Devices, Inc.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ *******************************************************************************/
+#ifndef GUARD_MIOPEN_TOOLS_READ_DB_HPP_
+#define GUARD_MIOPEN_TOOLS_READ_DB_HPP_
+
+#include "sqlite_perf_db.hpp"
+
+#include <miopen/db_binary_format.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+inline bool IsSQLiteDb(const std::string& filename)
+{
+    constexpr const char sqlite_magic[] = "SQLite format 3";
+    char header[sizeof(sqlite_magic)]   = {};
+    auto file                           = std::ifstream{filename, std::ios::binary};
+    file.read(header, sizeof(header));
+    return file && std::memcmp(header, sqlite_magic, sizeof(sqlite_magic)) == 0;
+}
+
+inline std::vector<miopen::binary_db::SourceRecord> ReadTextDb(const std::string& filename,
+                                                               std::istream& file)
+{
+    auto records = std::vector<miopen::binary_db::SourceRecord>{};
+    auto line    = std::string{};
+    auto n_line  = 0;
+
+    while(std::getline(file, line))
+    {
+        ++n_line;
+        if(line.empty())
+            continue;
+
+        auto record = miopen::binary_db::SourceRecord{};
+        if(!miopen::binary_db::ParseTextRecord(line, record))
+        {
+            std::cerr << "Ill-formed record: key not found: " << filename << "#" << n_line
+                      << std::endl;
+            continue;
+        }
+        records.push_back(std::move(record));
+    }
+
+    return records;
+}
+
+inline std::vector<miopen::binary_db::SourceRecord> ReadBinaryDb(const std::string& filename,
+                                                                 const std::string& data)
+{
+    auto error      = std::string{};
+    const auto view = miopen::binary_db::View::Open(data, error);
+    if(!view)
+        throw std::runtime_error(filename + ": " + error);
+
+    auto records = std::vector<miopen::binary_db::SourceRecord>{};
+    records.reserve(view->GetRecordCount());
+
+    for(std::size_t i = 0; i < view->GetRecordCount(); ++i)
+    {
+        const auto record = view->GetRecord(i);
+        auto& out         = records.emplace_back();
+        out.key           = std::string{view->GetString(record.key)};
+        view->ForEachItem(record, [&](std::string_view id, std::string_view values) {
+            out.items.emplace_back(id, values);
+        });
+    }
+
+    return records;
+}
+
+/// Reads a text or binary perf-db or find-db, or a SQLite perf-db.
+inline std::vector<miopen::binary_db::SourceRecord> ReadDb(const std::string& filename)
+{
+    if(IsSQLiteDb(filename))
+    {
+        auto records = std::vector<miopen::binary_db::SourceRecord>{};
+        for(const auto& line : ReadSQLitePerfDb(filename))
+        {
+            auto record = miopen::binary_db::SourceRecord{};
+            if(miopen::binary_db::ParseTextRecord(line.first + "=" + line.second, record))
+                records.push_back(std::move(record));
+        }
+        return records;
+    }
+
+    auto file = std::ifstream{filename, std::ios::binary};
+    if(!file)
+        throw std::runtime_error("Unable to open " + filename);
+
+    char magic[sizeof(miopen::binary_db::magic)] = {};
+    file.read(magic, sizeof(magic));
+    if(miopen::binary_db::View::IsBinary({magic, static_cast<std::size_t>(file.gcount())}))
+    {
+        file.seekg(0);
+        const auto data = std::string{std::istreambuf_iterator<char>{file}, {}};
+        return ReadBinaryDb(filename, data);
+    }
+
+    file.clear();
+    file.seekg(0);
+    return ReadTextDb(filename, file);
+}
+
+#endif // GUARD_MIOPEN_TOOLS_READ_DB_HPP_
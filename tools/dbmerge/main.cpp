@@ -0,0 +1,119 @@
+#include "read_db.hpp"
+
+#include <miopen/db_binary_format.hpp>
+#include <miopen/db_merge.hpp>
+#include <miopen/solver_id.hpp>
+
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+void PrintUsage(const char* name)
+{
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << name
+              << " [--perf-db|--find-db] [--binary] [--keep-unknown-ids] -o output_path "
+                 "input_path..."
+              << std::endl;
+    std::cerr << "input_path - text or binary perf-dbs or find-dbs, or sqlite3 perf-dbs, all of "
+                 "the same kind. If several inputs have a perf-db record for the same solver, the "
+                 "first of them wins."
+              << std::endl;
+    std::cerr << "--perf-db, --find-db - kind of the inputs. Defaults to find-db if the name of "
+                 "the first input contains \"fdb.\", e.g. gfx90a68.fdb.txt or a user *.ufdb.txt."
+              << std::endl;
+    std::cerr << "--binary - write the output in the binary format instead of the text one."
+              << std::endl;
+    std::cerr << "--keep-unknown-ids - keep the records of solvers unknown to this MIOpen."
+              << std::endl;
+    std::cerr << "output_path - path to the output file. Existing file would be replaced."
+              << std::endl;
+}
+
+int main(int argn, char** args)
+{
+    auto out_filename = std::string{};
+    auto in_filenames = std::vector<std::string>{};
+    auto find_db      = std::optional<bool>{};
+    auto binary       = false;
+    auto keep_unknown = false;
+
+    for(int i = 1; i < argn; ++i)
+    {
+        const auto arg = std::string{args[i]};
+        if(arg == "--perf-db")
+            find_db = false;
+        else if(arg == "--find-db")
+            find_db = true;
+        else if(arg == "--binary")
+            binary = true;
+        else if(arg == "--keep-unknown-ids")
+            keep_unknown = true;
+        else if(arg == "-o" && i + 1 < argn)
+            out_filename = args[++i];
+        else if(!arg.empty() && arg[0] != '-')
+            in_filenames.push_back(arg);
+        else
+        {
+            PrintUsage(args[0]);
+            return 1;
+        }
+    }
+
+    if(out_filename.empty() || in_filenames.empty())
+    {
+        PrintUsage(args[0]);
+        return 1;
+    }
+
+    if(!find_db)
+        find_db = in_filenames.front().find("fdb.") != std::string::npos;
+
+    const auto conflict =
+        *find_db ? miopen::db_merge::Conflict::KeepFastest : miopen::db_merge::Conflict::KeepFirst;
+    auto is_known_id = std::function<bool(const std::string&)>{};
+    if(!keep_unknown)
+        is_known_id = [](const std::string& id) { return miopen::solver::Id{id}.IsValid(); };
+
+    try
+    {
+        auto merger = miopen::db_merge::Merger{conflict, is_known_id};
+        for(const auto& in_filename : in_filenames)
+        {
+            for(auto& record : ReadDb(in_filename))
+                merger.Add(std::move(record));
+        }
+
+        auto records         = merger.Release();
+        const auto n_records = records.size();
+        auto out             = std::ofstream{out_filename, std::ios::binary | std::ios::trunc};
+        if(binary)
+            miopen::binary_db::Write(std::move(records), out);
+        else
+            miopen::db_merge::WriteText(records, out);
+        out.close();
+        if(!out)
+        {
+            std::cerr << "Unable to write " << out_filename << std::endl;
+            return 1;
+        }
+
+        const auto& stats = merger.GetStats();
+        std::cout << "Merged " << stats.records << " records with " << stats.items
+                  << " items from " << in_filenames.size() << " dbs into " << n_records
+                  << " records. Items replaced by faster ones: " << stats.replaced
+                  << ", ignored: " << stats.ignored << ", with unknown solvers: " << stats.dropped
+                  << "." << std::endl;
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include <miopen/binary_cache.hpp>
+#include <miopen/filesystem.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+void PrintUsage(const char* name)
+{
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << name << " [--max-size MB] [--max-age DAYS] [--compact] cache_path..."
+              << std::endl;
+    std::cerr << "cache_path - a user kernel db (*.ukdb), or a kernel cache directory, e.g. "
+                 "~/.cache/miopen/<version>. The kernel dbs in the directory and the kernels "
+                 "stored there as separate files are handled separately."
+              << std::endl;
+    std::cerr << "Without options the number of kernels and their size are reported." << std::endl;
+    std::cerr << "--max-size - remove the least recently used kernels until the rest take at most "
+                 "MB megabytes."
+              << std::endl;
+    std::cerr << "--max-age - remove the kernels not used in the last DAYS days." << std::endl;
+    std::cerr << "--compact - shrink the kernel db files after removing the kernels." << std::endl;
+}
+
+std::vector<miopen::fs::path> ListCaches(const miopen::fs::path& path)
+{
+    if(!miopen::fs::is_directory(path))
+        return {path};
+
+    auto caches = std::vector<miopen::fs::path>{};
+    for(auto it = miopen::fs::directory_iterator{path}; it != miopen::fs::directory_iterator{};
+        ++it)
+    {
+        if(it->path().extension() == ".ukdb")
+            caches.push_back(it->path());
+    }
+    if(caches.empty() || miopen::GetKernelCacheUsage(path).kernels != 0)
+        caches.push_back(path);
+    return caches;
+}
+
+int main(int argn, char** args)
+{
+    auto paths        = std::vector<miopen::fs::path>{};
+    auto max_bytes    = std::optional<std::size_t>{};
+    auto unused_since = std::chrono::system_clock::time_point{};
+    auto compact      = false;
+
+    try
+    {
+        for(int i = 1; i < argn; ++i)
+        {
+            const auto arg = std::string{args[i]};
+            if(arg == "--max-size" && i + 1 < argn)
+                max_bytes = std::stoull(args[++i]) * 1024 * 1024;
+            else if(arg == "--max-age" && i + 1 < argn)
+                unused_since = std::chrono::system_clock::now() -
+                               std::chrono::hours{24 * std::stoll(args[++i])};
+            else if(arg == "--compact")
+                compact = true;
+            else if(!arg.empty() && arg[0] != '-')
+                paths.push_back(arg);
+            else
+            {
+                PrintUsage(args[0]);
+                return 1;
+            }
+        }
+    }
+    catch(const std::logic_error&)
+    {
+        PrintUsage(args[0]);
+        return 1;
+    }
+
+    if(paths.empty())
+    {
+        PrintUsage(args[0]);
+        return 1;
+    }
+
+    const auto trim = max_bytes || unused_since != std::chrono::system_clock::time_point{};
+
+    try
+    {
+        for(const auto& path : paths)
+        {
+            for(const auto& cache : ListCaches(path))
+            {
+                const auto before = miopen::GetKernelCacheUsage(cache);
+                std::cout << cache.string() << ": " << before.kernels << " kernels, "
+                          << before.bytes << " bytes";
+                if(trim || compact)
+                {
+                    const auto limit = max_bytes.value_or(std::numeric_limits<std::size_t>::max());
+                    const auto after =
+                        miopen::TrimKernelCache(cache, limit, unused_since, compact);
+                    std::cout << ", trimmed to " << after.kernels << " kernels, " << after.bytes
+                              << " bytes";
+                }
+                std::cout << std::endl;
+            }
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
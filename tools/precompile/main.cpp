@@ -0,0 +1,188 @@
+#include <miopen/binary_cache.hpp>
+#include <miopen/compile_scheduler.hpp>
+#include <miopen/config.h>
+#include <miopen/filesystem.hpp>
+#include <miopen/handle.hpp>
+#include <miopen/problem.hpp>
+#include <miopen/tmp_dir.hpp>
+#include <miopen/warmup.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <thread>
+#include <vector>
+
+void PrintUsage(const char* name)
+{
+    std::cerr << "Usage:" << std::endl;
+    std::cerr << name
+              << " --arch ARCH --num-cu CU [--jobs N] [--output PATH] commands_path..."
+              << std::endl;
+    std::cerr << "commands_path - a file of MIOpenDriver command lines, one per line, e.g. the "
+                 "layers of a model logged with MIOPEN_ENABLE_LOGGING_CMD=1. The lines without "
+                 "a convolution command are skipped."
+              << std::endl;
+    std::cerr << "--arch - the target device, e.g. gfx90a:sramecc+:xnack-." << std::endl;
+    std::cerr << "--num-cu - the number of compute units of the target device." << std::endl;
+    std::cerr << "--jobs - the number of kernels built in parallel, one per core by default."
+              << std::endl;
+    std::cerr << "--output - the kernel db to add the kernels to, by default the one of the "
+                 "target in the current directory, e.g. gfx906_60.kdb. It starts as a copy of "
+                 "the installed kernel db of the target, so that it can replace it."
+              << std::endl;
+    std::cerr << "The kernels of all the solvers applicable to the convolutions are built, with "
+                 "the tuning from the installed perf-db or the default one. The target can only "
+                 "be chosen with the HIPNOGPU backend."
+              << std::endl;
+}
+
+int main(int argn, char** args)
+{
+    auto arch   = std::string{};
+    auto num_cu = std::size_t{0};
+    auto jobs   = std::size_t{std::max(std::thread::hardware_concurrency(), 1u)};
+    auto output = miopen::fs::path{};
+    auto inputs = std::vector<miopen::fs::path>{};
+
+    try
+    {
+        for(int i = 1; i < argn; ++i)
+        {
+            const auto arg = std::string{args[i]};
+            if(arg == "--arch" && i + 1 < argn)
+                arch = args[++i];
+            else if(arg == "--num-cu" && i + 1 < argn)
+                num_cu = std::stoull(args[++i]);
+            else if(arg == "--jobs" && i + 1 < argn)
+                jobs = std::stoull(args[++i]);
+            else if(arg == "--output" && i + 1 < argn)
+                output = args[++i];
+            else if(!arg.empty() && arg[0] != '-')
+                inputs.push_back(arg);
+            else
+            {
+                PrintUsage(args[0]);
+                return 1;
+            }
+        }
+    }
+    catch(const std::logic_error&)
+    {
+        PrintUsage(args[0]);
+        return 1;
+    }
+
+    if(arch.empty() || num_cu == 0 || jobs == 0 || inputs.empty())
+    {
+        PrintUsage(args[0]);
+        return 1;
+    }
+
+#if !MIOPEN_ENABLE_SQLITE_KERN_CACHE
+    std::cerr << "Kernel dbs are not supported by this build" << std::endl;
+    return 1;
+#else
+    try
+    {
+        // The kernels are built into a user kernel db of their own, which is merged into the
+        // output. The variables are read once, so they are set before the first use.
+        const auto cache = miopen::TmpDir{"precompile"};
+        setenv("MIOPEN_DEVICE_ARCH", arch.c_str(), 1);
+        setenv("MIOPEN_DEVICE_CU", std::to_string(num_cu).c_str(), 1);
+        setenv("MIOPEN_CUSTOM_CACHE_DIR", cache.path.c_str(), 1);
+        setenv("MIOPEN_USER_KERNEL_CACHE_LIMIT_MB", "0", 1);
+
+        if(miopen::IsCacheDisabled())
+        {
+            std::cerr << "The kernel cache is disabled" << std::endl;
+            return 1;
+        }
+
+        auto problems = std::vector<miopen::Problem>{};
+        for(const auto& input : inputs)
+        {
+            auto file = std::ifstream{input};
+            if(!file)
+            {
+                std::cerr << "Unable to read " << input.string() << std::endl;
+                return 1;
+            }
+            auto read = miopen::ReadDriverCommands(file);
+            problems.insert(problems.end(),
+                            std::make_move_iterator(read.begin()),
+                            std::make_move_iterator(read.end()));
+        }
+
+        auto handle = miopen::Handle{};
+        if(handle.GetMaxComputeUnits() != num_cu)
+        {
+            std::cerr << "The target can only be chosen with the HIPNOGPU backend" << std::endl;
+            return 1;
+        }
+
+        const auto& target = handle.GetTargetProperties();
+        if(output.empty())
+            output = miopen::Handle::GetDbBasename(target, num_cu) + ".kdb";
+
+        const auto installed = miopen::GetSystemKernelDbPath(target, num_cu);
+        if(!miopen::fs::exists(output) && miopen::fs::is_regular_file(installed))
+            miopen::MergeKernelDb(installed, output);
+
+        const auto kernels = miopen::CollectKernels(handle, problems);
+        std::cout << problems.size() << " problems, " << kernels.size() << " kernels" << std::endl;
+
+        auto failed = std::size_t{0};
+        {
+            auto scheduler = miopen::solver::CompileScheduler{handle, jobs};
+            scheduler.Start(kernels);
+            for(const auto& kernel : kernels)
+            {
+                try
+                {
+                    scheduler.Wait({kernel});
+                }
+                catch(const std::exception& ex)
+                {
+                    std::cerr << kernel.kernel_file << " " << kernel.comp_options << ": "
+                              << ex.what() << std::endl;
+                    ++failed;
+                }
+            }
+        }
+
+        for(auto it = miopen::fs::directory_iterator{cache.path};
+            it != miopen::fs::directory_iterator{};
+            ++it)
+        {
+            if(it->path().extension() == ".ukdb")
+                miopen::MergeKernelDb(it->path(), output);
+        }
+
+        if(miopen::fs::exists(output))
+        {
+            const auto usage = miopen::GetKernelCacheUsage(output);
+            std::cout << output.string() << ": " << usage.kernels << " kernels, " << usage.bytes
+                      << " bytes" << std::endl;
+        }
+
+        if(failed != 0)
+        {
+            std::cerr << failed << " of " << kernels.size() << " kernels failed to build"
+                      << std::endl;
+            return 1;
+        }
+    }
+    catch(const std::exception& ex)
+    {
+        std::cerr << ex.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+#endif
+}